@@ -112,6 +112,13 @@ SkeletonAnimation* SkeletonAnimation::createWithBinaryFile (const std::string& s
 	return node;
 }
 
+SkeletonAnimation* SkeletonAnimation::createWithCache (SkeletonDataCache* cache, const std::string& skeletonDataFile, Atlas* atlas, float scale) {
+	SkeletonAnimation* node = new SkeletonAnimation();
+	node->initWithCache(cache, skeletonDataFile, atlas, scale);
+	node->autorelease();
+	return node;
+}
+
 
 void SkeletonAnimation::initialize () {
 	super::initialize();
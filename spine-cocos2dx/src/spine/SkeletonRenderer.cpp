@@ -87,6 +87,13 @@ namespace spine {
 		return node;
 	}
 
+	SkeletonRenderer* SkeletonRenderer::createWithCache (SkeletonDataCache* cache, const std::string& skeletonDataFile, Atlas* atlas, float scale) {
+		SkeletonRenderer* node = new SkeletonRenderer();
+		node->initWithCache(cache, skeletonDataFile, atlas, scale);
+		node->autorelease();
+		return node;
+	}
+
 	void SkeletonRenderer::initialize () {
 		_clipper = new (__FILE__, __LINE__) SkeletonClipping();
 
@@ -129,8 +136,11 @@ namespace spine {
 	}
 
 	SkeletonRenderer::~SkeletonRenderer () {
-		if (_ownsSkeletonData) delete _skeleton->getData();
+		SkeletonData* skeletonData = _skeleton->getData();
 		if (_ownsSkeleton) delete _skeleton;
+		// Released after the skeleton is deleted, the cache may evict the skeleton data right away.
+		if (_skeletonDataCache) _skeletonDataCache->release(skeletonData);
+		if (_ownsSkeletonData) delete skeletonData;
 		if (_ownsAtlas && _atlas) delete _atlas;
 		if (_attachmentLoader) delete _attachmentLoader;
 		delete _clipper;
@@ -214,6 +224,20 @@ namespace spine {
 		initialize();
 	}
 
+	void SkeletonRenderer::initWithCache (SkeletonDataCache* cache, const std::string& skeletonDataFile, Atlas* atlas, float scale) {
+		_atlas = atlas;
+		_attachmentLoader = new (__FILE__, __LINE__) Cocos2dAtlasAttachmentLoader(_atlas);
+
+		SkeletonData* skeletonData = cache->acquire(skeletonDataFile.c_str(), atlas, scale, _attachmentLoader);
+		CCASSERT(skeletonData, !cache->getError().isEmpty() ? cache->getError().buffer() : "Error reading skeleton data.");
+		_skeletonDataCache = cache;
+
+		_ownsSkeleton = true;
+		setSkeletonData(skeletonData, false);
+
+		initialize();
+	}
+
 
 	void SkeletonRenderer::update (float deltaTime) {
 		Node::update(deltaTime);
@@ -38,6 +38,7 @@ namespace spine {
 
 	class Skeleton;
     class SkeletonData;
+    class SkeletonDataCache;
     class Atlas;
     class Bone;
     class Attachment;
@@ -58,6 +59,9 @@ namespace spine {
 		static SkeletonRenderer* createWithData (SkeletonData* skeletonData, bool ownsSkeletonData = false);
 		static SkeletonRenderer* createWithFile (const std::string& skeletonDataFile, Atlas* atlas, float scale = 1);
 		static SkeletonRenderer* createWithFile (const std::string& skeletonDataFile, const std::string& atlasFile, float scale = 1);
+		/* Gets the skeleton data from the cache, so renderers of the same file share one load. The data is released when the
+		 * renderer is destroyed. */
+		static SkeletonRenderer* createWithCache (SkeletonDataCache* cache, const std::string& skeletonDataFile, Atlas* atlas, float scale = 1);
 
 		void update (float deltaTime) override;
 		void draw (cocos2d::Renderer* renderer, const cocos2d::Mat4& transform, uint32_t transformFlags) override;
@@ -142,6 +146,7 @@ namespace spine {
 		void initWithJsonFile (const std::string& skeletonDataFile, const std::string& atlasFile, float scale = 1);
 		void initWithBinaryFile (const std::string& skeletonDataFile, Atlas* atlas, float scale = 1);
 		void initWithBinaryFile (const std::string& skeletonDataFile, const std::string& atlasFile, float scale = 1);
+		void initWithCache (SkeletonDataCache* cache, const std::string& skeletonDataFile, Atlas* atlas, float scale = 1);
 
 		virtual void initialize ();
 
@@ -153,6 +158,7 @@ namespace spine {
 		bool _ownsSkeletonData;
 		bool _ownsSkeleton;
 		bool _ownsAtlas = false;
+		SkeletonDataCache* _skeletonDataCache = nullptr;
 		Atlas* _atlas;
 		AttachmentLoader* _attachmentLoader;
 		cocos2d::CustomCommand _debugCommand;
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/* Converts a JSON skeleton to the binary format, then loads both and checks that they describe the same skeleton. Reports the
+ * load time and memory of each format. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <spine/spine.h>
+#include <spine/Debug.h>
+
+using namespace spine;
+
+namespace spine {
+	SpineExtension *getDefaultExtension() {
+		return new DefaultSpineExtension();
+	}
+}
+
+static int errors = 0;
+
+static void check(bool condition, const char *message, const String &name) {
+	if (condition) return;
+	if (errors++ < 20) printf("Mismatch: %s %s\n", message, name.buffer());
+}
+
+static void checkFloat(float expected, float actual, const char *message, const String &name) {
+	check(expected == actual, message, name);
+}
+
+/* Loads the skeleton data repeatedly, returns the fastest load in milliseconds and the memory of one load. */
+static SkeletonData *load(const char *path, Atlas *atlas, bool binary, float scale, DebugExtension &debug, double &milliseconds,
+	size_t &memory
+) {
+	milliseconds = 1e9;
+	SkeletonData *skeletonData = NULL;
+	for (int i = 0; i < 10; i++) {
+		delete skeletonData;
+		size_t usedMemory = debug.getUsedMemory();
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		String error;
+		if (binary) {
+			SkeletonBinary reader(atlas);
+			reader.setScale(scale);
+			skeletonData = reader.readSkeletonDataFile(path);
+			error = reader.getError();
+		} else {
+			SkeletonJson reader(atlas);
+			reader.setScale(scale);
+			skeletonData = reader.readSkeletonDataFile(path);
+			error = reader.getError();
+		}
+		double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		if (!skeletonData) {
+			printf("Unable to load %s: %s\n", path, error.buffer());
+			return NULL;
+		}
+		if (time < milliseconds) milliseconds = time;
+		memory = debug.getUsedMemory() - usedMemory;
+	}
+	return skeletonData;
+}
+
+static void compareAttachments(SkeletonData *expected, SkeletonData *actual) {
+	check(expected->getSkins().size() == actual->getSkins().size(), "skin count", "");
+	Vector<String> names;
+	for (size_t i = 0; i < expected->getSkins().size(); i++) {
+		Skin *expectedSkin = expected->getSkins()[i];
+		Skin *actualSkin = actual->findSkin(expectedSkin->getName());
+		check(actualSkin != NULL, "missing skin", expectedSkin->getName());
+		if (!actualSkin) continue;
+		check(expectedSkin->getBones().size() == actualSkin->getBones().size() &&
+			  expectedSkin->getConstraints().size() == actualSkin->getConstraints().size(), "skin bones or constraints",
+			  expectedSkin->getName());
+		for (size_t slotIndex = 0; slotIndex < expected->getSlots().size(); slotIndex++) {
+			names.clear();
+			expectedSkin->findNamesForSlot(slotIndex, names);
+			for (size_t ii = 0; ii < names.size(); ii++) {
+				Attachment *expectedAttachment = expectedSkin->getAttachment(slotIndex, names[ii]);
+				Attachment *actualAttachment = actualSkin->getAttachment(slotIndex, names[ii]);
+				check(actualAttachment && actualAttachment->getRTTI().isExactly(expectedAttachment->getRTTI()) &&
+					  actualAttachment->getName() == expectedAttachment->getName(), "attachment", names[ii]);
+				if (!actualAttachment || !actualAttachment->getRTTI().instanceOf(VertexAttachment::rtti)) continue;
+				VertexAttachment *expectedVertices = static_cast<VertexAttachment *>(expectedAttachment);
+				VertexAttachment *actualVertices = static_cast<VertexAttachment *>(actualAttachment);
+				check(expectedVertices->getVertices().size() == actualVertices->getVertices().size() &&
+					  expectedVertices->getBones().size() == actualVertices->getBones().size(), "attachment vertices", names[ii]);
+				for (size_t v = 0; v < expectedVertices->getVertices().size() && v < actualVertices->getVertices().size(); v++)
+					checkFloat(expectedVertices->getVertices()[v], actualVertices->getVertices()[v], "attachment vertices", names[ii]);
+			}
+		}
+	}
+}
+
+static void compareData(SkeletonData *expected, SkeletonData *actual) {
+	check(expected->getBones().size() == actual->getBones().size(), "bone count", "");
+	for (size_t i = 0; i < expected->getBones().size() && i < actual->getBones().size(); i++) {
+		BoneData *expectedBone = expected->getBones()[i], *actualBone = actual->getBones()[i];
+		check(expectedBone->getName() == actualBone->getName(), "bone name", expectedBone->getName());
+		checkFloat(expectedBone->getX(), actualBone->getX(), "bone x", expectedBone->getName());
+		checkFloat(expectedBone->getY(), actualBone->getY(), "bone y", expectedBone->getName());
+		checkFloat(expectedBone->getRotation(), actualBone->getRotation(), "bone rotation", expectedBone->getName());
+		checkFloat(expectedBone->getScaleX(), actualBone->getScaleX(), "bone scaleX", expectedBone->getName());
+		checkFloat(expectedBone->getScaleY(), actualBone->getScaleY(), "bone scaleY", expectedBone->getName());
+		checkFloat(expectedBone->getLength(), actualBone->getLength(), "bone length", expectedBone->getName());
+		check(expectedBone->getTransformMode() == actualBone->getTransformMode(), "bone transform mode", expectedBone->getName());
+	}
+	check(expected->getSlots().size() == actual->getSlots().size(), "slot count", "");
+	for (size_t i = 0; i < expected->getSlots().size() && i < actual->getSlots().size(); i++) {
+		SlotData *expectedSlot = expected->getSlots()[i], *actualSlot = actual->getSlots()[i];
+		check(expectedSlot->getName() == actualSlot->getName() &&
+			  expectedSlot->getAttachmentName() == actualSlot->getAttachmentName() &&
+			  expectedSlot->getBlendMode() == actualSlot->getBlendMode(), "slot", expectedSlot->getName());
+	}
+	check(expected->getIkConstraints().size() == actual->getIkConstraints().size() &&
+		  expected->getTransformConstraints().size() == actual->getTransformConstraints().size() &&
+		  expected->getPathConstraints().size() == actual->getPathConstraints().size(), "constraint count", "");
+	check(expected->getEvents().size() == actual->getEvents().size(), "event count", "");
+	for (size_t i = 0; i < expected->getEvents().size() && i < actual->getEvents().size(); i++) {
+		EventData *expectedEvent = expected->getEvents()[i], *actualEvent = actual->getEvents()[i];
+		check(expectedEvent->getName() == actualEvent->getName() && expectedEvent->getIntValue() == actualEvent->getIntValue() &&
+			  expectedEvent->getFloatValue() == actualEvent->getFloatValue() &&
+			  expectedEvent->getStringValue() == actualEvent->getStringValue(), "event", expectedEvent->getName());
+	}
+	compareAttachments(expected, actual);
+	check(expected->getAnimations().size() == actual->getAnimations().size(), "animation count", "");
+	for (size_t i = 0; i < expected->getAnimations().size() && i < actual->getAnimations().size(); i++) {
+		Animation *expectedAnimation = expected->getAnimations()[i], *actualAnimation = actual->getAnimations()[i];
+		check(expectedAnimation->getName() == actualAnimation->getName() &&
+			  expectedAnimation->getDuration() == actualAnimation->getDuration() &&
+			  expectedAnimation->getTimelines().size() == actualAnimation->getTimelines().size(), "animation",
+			  expectedAnimation->getName());
+	}
+}
+
+/* Samples every animation at 30 fps. Bezier curves are stored with recovered control points, so poses match within float
+ * precision rather than exactly. */
+static void comparePoses(SkeletonData *expectedData, SkeletonData *actualData, float &maxError, float &maxDeformError) {
+	Skeleton expected(expectedData), actual(actualData);
+	for (size_t i = 0; i < expectedData->getAnimations().size() && i < actualData->getAnimations().size(); i++) {
+		Animation *expectedAnimation = expectedData->getAnimations()[i], *actualAnimation = actualData->getAnimations()[i];
+		expected.setToSetupPose();
+		actual.setToSetupPose();
+		for (float time = 0; time < expectedAnimation->getDuration() + 1 / 30.0f; time += 1 / 30.0f) {
+			expectedAnimation->apply(expected, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			actualAnimation->apply(actual, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			expected.updateWorldTransform();
+			actual.updateWorldTransform();
+			for (size_t ii = 0; ii < expected.getBones().size(); ii++) {
+				Bone *expectedBone = expected.getBones()[ii], *actualBone = actual.getBones()[ii];
+				maxError = MathUtil::max(maxError, MathUtil::abs(expectedBone->getWorldX() - actualBone->getWorldX()));
+				maxError = MathUtil::max(maxError, MathUtil::abs(expectedBone->getWorldY() - actualBone->getWorldY()));
+			}
+			for (size_t ii = 0; ii < expected.getSlots().size(); ii++) {
+				Slot *expectedSlot = expected.getSlots()[ii], *actualSlot = actual.getSlots()[ii];
+				Attachment *expectedAttachment = expectedSlot->getAttachment(), *actualAttachment = actualSlot->getAttachment();
+				check(expectedAttachment ? actualAttachment && expectedAttachment->getName() == actualAttachment->getName() :
+					  !actualAttachment, "attachment key in", expectedAnimation->getName());
+				check(expected.getDrawOrder()[ii]->getData().getIndex() == actual.getDrawOrder()[ii]->getData().getIndex(),
+					  "draw order in", expectedAnimation->getName());
+				Vector<float> &expectedDeform = expectedSlot->getDeform(), &actualDeform = actualSlot->getDeform();
+				check(expectedDeform.size() == actualDeform.size(), "deform in", expectedAnimation->getName());
+				for (size_t v = 0; v < expectedDeform.size() && v < actualDeform.size(); v++)
+					maxDeformError = MathUtil::max(maxDeformError, MathUtil::abs(expectedDeform[v] - actualDeform[v]));
+			}
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	if (argc < 4) {
+		printf("Usage: spine_cpp_converter <skeleton.json> <skeleton.atlas> <output.skel> [scale]\n");
+		return 1;
+	}
+	const char *jsonPath = argv[1], *atlasPath = argv[2], *binaryPath = argv[3];
+	float scale = argc > 4 ? (float) atof(argv[4]) : 1;
+
+	DebugExtension *debug = new DebugExtension(SpineExtension::getInstance());
+	SpineExtension::setInstance(debug);
+	int result = 0;
+	{
+		Atlas atlas(atlasPath, NULL, "", false);
+		if (atlas.getPages().size() == 0) {
+			printf("Unable to load atlas: %s\n", atlasPath);
+			return 1;
+		}
+
+		double jsonTime, binaryTime;
+		size_t jsonMemory, binaryMemory;
+		SkeletonData *jsonData = load(jsonPath, &atlas, false, scale, *debug, jsonTime, jsonMemory);
+		if (!jsonData) return 1;
+
+		// Values are written divided by the scale, so the binary file has the same units as the JSON file.
+		SkeletonBinary writer(&atlas);
+		writer.setScale(scale);
+		if (!writer.writeSkeletonDataFile(jsonData, binaryPath)) {
+			printf("Unable to convert %s: %s\n", jsonPath, writer.getError().buffer());
+			delete jsonData;
+			return 1;
+		}
+
+		SkeletonData *binaryData = load(binaryPath, &atlas, true, scale, *debug, binaryTime, binaryMemory);
+		if (!binaryData) {
+			delete jsonData;
+			return 1;
+		}
+
+		int jsonLength, binaryLength;
+		SpineExtension::free(SpineExtension::readFile(jsonPath, &jsonLength), __FILE__, __LINE__);
+		SpineExtension::free(SpineExtension::readFile(binaryPath, &binaryLength), __FILE__, __LINE__);
+
+		float maxError = 0, maxDeformError = 0;
+		compareData(jsonData, binaryData);
+		comparePoses(jsonData, binaryData, maxError, maxDeformError);
+		if (maxError > 0.01f || maxDeformError > 0.01f) errors++;
+
+		printf("%-8s %10s %12s %12s\n", "", "file", "load", "memory");
+		printf("%-8s %8d B %9.3f ms %10zu B\n", "json", jsonLength, jsonTime, jsonMemory);
+		printf("%-8s %8d B %9.3f ms %10zu B\n", "binary", binaryLength, binaryTime, binaryMemory);
+		printf("Load time %.2fx faster, max bone position error %f, max deform error %f\n", jsonTime / binaryTime, maxError,
+			   maxDeformError);
+		if (errors > 0) {
+			printf("%s: %d mismatches\n", binaryPath, errors);
+			result = 1;
+		} else
+			printf("%s: verified\n", binaryPath);
+
+		delete binaryData;
+		delete jsonData;
+	}
+	return result;
+}
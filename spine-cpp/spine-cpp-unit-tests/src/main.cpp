@@ -1,4 +1,10 @@
 #include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <chrono>
+#include <thread>
 #include <spine/spine.h>
 #include <spine/Debug.h>
 
@@ -8,7 +14,7 @@ using namespace spine;
 
 void loadBinary(const String &binaryFile, const String &atlasFile, Atlas *&atlas, SkeletonData *&skeletonData,
 				AnimationStateData *&stateData, Skeleton *&skeleton, AnimationState *&state) {
-	atlas = new(__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	atlas = new(__FILE__, __LINE__) Atlas(atlasFile, NULL, "", false);
 	assert(atlas != NULL);
 
 	SkeletonBinary binary(atlas);
@@ -27,7 +33,7 @@ void loadBinary(const String &binaryFile, const String &atlasFile, Atlas *&atlas
 
 void loadJson(const String &jsonFile, const String &atlasFile, Atlas *&atlas, SkeletonData *&skeletonData,
 			  AnimationStateData *&stateData, Skeleton *&skeleton, AnimationState *&state) {
-	atlas = new(__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	atlas = new(__FILE__, __LINE__) Atlas(atlasFile, NULL, "", false);
 	assert(atlas != NULL);
 
 	SkeletonJson json(atlas);
@@ -93,17 +99,2721 @@ void testLoading() {
 	}
 }
 
+void testPoseStore() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+	testData.add(TestData("testdata/stretchyman/stretchyman-pro.json", "testdata/stretchyman/stretchyman-pro.skel",
+						  "testdata/stretchyman/stretchyman.atlas"));
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		printf("Comparing pose store for %s\n", data._binarySkeleton.buffer());
+
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		Skeleton packed(skeletonData, true);
+		assert(packed.getPoseStore() != NULL);
+		skeleton.setPosition(100, 50);
+		packed.setPosition(100, 50);
+
+		float maxError = 0;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *animation = animations[ii];
+			skeleton.setToSetupPose();
+			packed.setToSetupPose();
+			for (float time = 0; time < animation->getDuration(); time += 1 / 60.0f) {
+				animation->apply(skeleton, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				animation->apply(packed, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.updateWorldTransform();
+				packed.updateWorldTransform();
+				for (size_t iii = 0; iii < skeleton.getBones().size(); iii++) {
+					Bone *bone = skeleton.getBones()[iii];
+					Bone *packedBone = packed.getBones()[iii];
+					/* The pose store computes sine and cosine with its own polynomials. */
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getA() - packedBone->getA()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getB() - packedBone->getB()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getC() - packedBone->getC()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getD() - packedBone->getD()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getWorldX() - packedBone->getWorldX()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getWorldY() - packedBone->getWorldY()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getAppliedRotation() - packedBone->getAppliedRotation()));
+				}
+				/* The store holds a copy of the transforms it computed, which all skeletons have a run of bones long enough for. */
+				BonePoseStore &store = *packed.getPoseStore();
+				size_t stored = 0;
+				for (size_t iii = 0; iii < packed.getBones().size(); iii++) {
+					Bone *packedBone = packed.getBones()[iii];
+					if (store.getComponent(BonePoseComponent_WorldX)[iii] == packedBone->getWorldX() &&
+						store.getComponent(BonePoseComponent_D)[iii] == packedBone->getD())
+						stored++;
+				}
+				assert(stored >= 4);
+			}
+		}
+		printf("Max error: %f\n", maxError);
+		assert(maxError < 0.01f);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Returns the max difference between the curves of two skeleton datas read from the same file. */
+float compareCurves(SkeletonData *expected, SkeletonData *actual) {
+	float maxError = 0;
+	for (size_t i = 0; i < expected->getAnimations().size(); i++) {
+		Vector<Timeline *> &expectedTimelines = expected->getAnimations()[i]->getTimelines();
+		Vector<Timeline *> &actualTimelines = actual->getAnimations()[i]->getTimelines();
+		for (size_t ii = 0; ii < expectedTimelines.size(); ii++) {
+			if (!expectedTimelines[ii]->getRTTI().instanceOf(CurveTimeline::rtti)) continue;
+			CurveTimeline *expectedTimeline = static_cast<CurveTimeline *>(expectedTimelines[ii]);
+			CurveTimeline *actualTimeline = static_cast<CurveTimeline *>(actualTimelines[ii]);
+			for (size_t frame = 0; frame < expectedTimeline->getFrameCount() - 1; frame++) {
+				for (int iii = 0; iii <= 1000; iii++) {
+					float percent = iii / 1000.0f;
+					maxError = MathUtil::max(maxError, MathUtil::abs(expectedTimeline->getCurvePercent(frame, percent) -
+						actualTimeline->getCurvePercent(frame, percent)));
+				}
+			}
+		}
+	}
+	return maxError;
+}
+
+void testCurveLookup() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+
+	const size_t sizes[] = { 8, 32, 128, 1024 };
+	const float maxErrors[] = { 0.2f, 0.1f, 0.025f, 0.005f };
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+
+		SkeletonBinary binary(atlas);
+		SkeletonJson json(atlas);
+		SkeletonData *binaryData = binary.readSkeletonDataFile(data._binarySkeleton);
+		SkeletonData *jsonData = json.readSkeletonDataFile(data._jsonSkeleton);
+		assert(binaryData && jsonData);
+
+		for (size_t ii = 0; ii < sizeof(sizes) / sizeof(sizes[0]); ii++) {
+			binary.setCurveLookupSize(sizes[ii]);
+			json.setCurveLookupSize(sizes[ii]);
+			SkeletonData *binaryLookupData = binary.readSkeletonDataFile(data._binarySkeleton);
+			SkeletonData *jsonLookupData = json.readSkeletonDataFile(data._jsonSkeleton);
+			assert(binaryLookupData && jsonLookupData);
+
+			float binaryError = compareCurves(binaryData, binaryLookupData);
+			float jsonError = compareCurves(jsonData, jsonLookupData);
+			printf("%s: curve lookup size %d, max error binary %f, json %f\n", data._binarySkeleton.buffer(), (int) sizes[ii],
+				binaryError, jsonError);
+			assert(binaryError < maxErrors[ii]);
+			assert(jsonError < maxErrors[ii]);
+
+			delete binaryLookupData;
+			delete jsonLookupData;
+		}
+
+		delete binaryData;
+		delete jsonData;
+		delete atlas;
+	}
+}
+
+/* Compares the world transforms of two skeletons for all animations of their data. */
+bool poseEquals(SkeletonData *expectedData, SkeletonData *actualData) {
+	Skeleton expected(expectedData);
+	Skeleton actual(actualData);
+	for (size_t i = 0; i < expectedData->getAnimations().size(); i++) {
+		Animation *expectedAnimation = expectedData->getAnimations()[i];
+		Animation *actualAnimation = actualData->getAnimations()[i];
+		expected.setToSetupPose();
+		actual.setToSetupPose();
+		for (float time = 0; time < expectedAnimation->getDuration(); time += 0.1f) {
+			expectedAnimation->apply(expected, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+			actualAnimation->apply(actual, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+			expected.updateWorldTransform();
+			actual.updateWorldTransform();
+			for (size_t ii = 0; ii < expected.getBones().size(); ii++) {
+				Bone *expectedBone = expected.getBones()[ii];
+				Bone *actualBone = actual.getBones()[ii];
+				if (expectedBone->getA() != actualBone->getA() || expectedBone->getB() != actualBone->getB() ||
+					expectedBone->getC() != actualBone->getC() || expectedBone->getD() != actualBone->getD() ||
+					expectedBone->getWorldX() != actualBone->getWorldX() || expectedBone->getWorldY() != actualBone->getWorldY())
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+void testArena(DebugExtension &debug) {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/coin/coin-pro.json", "testdata/coin/coin-pro.skel", "testdata/coin/coin.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/stretchyman/stretchyman-pro.json", "testdata/stretchyman/stretchyman-pro.skel",
+						  "testdata/stretchyman/stretchyman.atlas"));
+	testData.add(TestData("testdata/tank/tank-pro.json", "testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"));
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+
+		for (int format = 0; format < 2; format++) {
+			const String &path = format == 0 ? data._binarySkeleton : data._jsonSkeleton;
+			SkeletonData *skeletonData[2];
+			size_t allocations[2];
+			for (int useArena = 0; useArena < 2; useArena++) {
+				size_t before = debug.getAllocationCount() + debug.getReallocationCount();
+				if (format == 0) {
+					SkeletonBinary binary(atlas);
+					binary.setUseArena(useArena == 1);
+					skeletonData[useArena] = binary.readSkeletonDataFile(path);
+				} else {
+					SkeletonJson json(atlas);
+					json.setUseArena(useArena == 1);
+					skeletonData[useArena] = json.readSkeletonDataFile(path);
+				}
+				assert(skeletonData[useArena]);
+				allocations[useArena] = debug.getAllocationCount() + debug.getReallocationCount() - before;
+			}
+
+			ArenaAllocator &arena = skeletonData[1]->getArena();
+			printf("%s: %d heap allocations, with arena %d heap allocations, %d arena allocations in %d blocks (%d KB)\n",
+				path.buffer(), (int) allocations[0], (int) allocations[1], (int) arena.getAllocationCount(),
+				(int) arena.getBlockCount(), (int) (arena.getCapacity() / 1024));
+			assert(skeletonData[0]->getArena().getBlockCount() == 0);
+			assert(arena.getBlockCount() > 0 && allocations[1] < allocations[0]);
+			assert(poseEquals(skeletonData[0], skeletonData[1]));
+
+			/* Memory of the arena which is freed or grown after loading must not reach the heap. */
+			{
+				ArenaScope arenaScope(&arena);
+				Vector<BoneData *> &bones = skeletonData[1]->getBones();
+				for (size_t ii = 0, n = bones.size(); ii < n; ii++)
+					bones.add(bones[ii]);
+				bones.setSize(bones.size() / 2, NULL);
+				skeletonData[1]->setName("renamed");
+			}
+			skeletonData[1]->indexNames();
+			assert(poseEquals(skeletonData[0], skeletonData[1]));
+
+			delete skeletonData[0];
+			delete skeletonData[1];
+		}
+
+		delete atlas;
+	}
+}
+
+/* Loading data whose linked mesh skin or parent is missing must fail without touching the freed arena. */
+void testArenaLinkedMeshError() {
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/goblins/goblins.atlas", NULL, "", false);
+	int length;
+	char *file = SpineExtension::readFile("testdata/goblins/goblins-pro.json", &length);
+	assert(file);
+	const char *names[] = {"\"skin\": \"goblin\"", "\"parent\": \"left-foot\""};
+	const char *errors[] = {"Skin not found: goblix", "Parent mesh not found: left-fooX"};
+	for (int i = 0; i < 2; i++) {
+		char *text = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+		memcpy(text, file, length);
+		text[length] = 0;
+		/* Change the last character of the name, keeping the length. */
+		char *name = strstr(text, names[i]);
+		assert(name);
+		name[strlen(names[i]) - 2] = i == 0 ? 'x' : 'X';
+
+		SkeletonJson json(atlas);
+		json.setUseArena(true);
+		SkeletonData *skeletonData = json.readSkeletonData(text);
+		assert(!skeletonData && json.getError() == errors[i]);
+		SpineExtension::free(text, __FILE__, __LINE__);
+	}
+	SpineExtension::free(file, __FILE__, __LINE__);
+	delete atlas;
+}
+
+void testMapFile() {
+	SpineExtension *extension = SpineExtension::getInstance();
+	MappedFileExtension mappedFileExtension;
+	SpineExtension::setInstance(&mappedFileExtension);
+
+	const char *path = "testdata/raptor/raptor-pro.skel";
+	int readLength, mappedLength;
+	char *read = SpineExtension::readFile(path, &readLength);
+	const char *mapped = SpineExtension::mapFile(path, &mappedLength);
+	assert(read && mapped && readLength == mappedLength && memcmp(read, mapped, readLength) == 0);
+	SpineExtension::unmapFile(mapped, mappedLength);
+	assert(!SpineExtension::mapFile("testdata/missing.skel", &mappedLength));
+
+	/* readSkeletonDataFile() parses the mapped file, which must give the same data as parsing the read file. */
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL, "", false);
+	{
+		/* The loader must be freed by the extension which allocated it. */
+		SkeletonBinary binary(atlas);
+		SkeletonData *expected = binary.readSkeletonData((const unsigned char *) read, readLength);
+		SkeletonData *actual = binary.readSkeletonDataFile(path);
+		assert(expected && actual);
+		assert(poseEquals(expected, actual));
+
+		delete expected;
+		delete actual;
+	}
+	delete atlas;
+	SpineExtension::free(read, __FILE__, __LINE__);
+	SpineExtension::setInstance(extension);
+}
+
+void testBatchUpdater() {
+	printf("Updating skeletons in batch\n");
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.2f);
+
+	const size_t count = 32;
+	Vector<Skeleton *> skeletons, batchSkeletons;
+	Vector<AnimationState *> states, batchStates;
+	SkeletonBatchUpdater updater(4);
+	for (size_t i = 0; i < count; i++) {
+		Animation *animation = skeletonData->getAnimations()[i % skeletonData->getAnimations().size()];
+		skeletons.add(new(__FILE__, __LINE__) Skeleton(skeletonData));
+		batchSkeletons.add(new(__FILE__, __LINE__) Skeleton(skeletonData));
+		states.add(new(__FILE__, __LINE__) AnimationState(&stateData));
+		batchStates.add(new(__FILE__, __LINE__) AnimationState(&stateData));
+		states[i]->setAnimation(0, animation, true)->setTrackTime(i * 0.05f);
+		batchStates[i]->setAnimation(0, animation, true)->setTrackTime(i * 0.05f);
+		updater.add(*batchSkeletons[i], *batchStates[i]);
+	}
+	assert(updater.size() == count);
+
+	for (int frame = 0; frame < 120; frame++) {
+		for (size_t i = 0; i < count; i++) {
+			states[i]->update(1 / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+		updater.update(1 / 60.0f);
+
+		for (size_t i = 0; i < count; i++) {
+			for (size_t ii = 0; ii < skeletons[i]->getBones().size(); ii++) {
+				Bone *bone = skeletons[i]->getBones()[ii];
+				Bone *batchBone = batchSkeletons[i]->getBones()[ii];
+				assert(bone->getWorldX() == batchBone->getWorldX());
+				assert(bone->getWorldY() == batchBone->getWorldY());
+				assert(bone->getA() == batchBone->getA());
+				assert(bone->getD() == batchBone->getD());
+			}
+		}
+	}
+
+	bool removed = updater.remove(*batchSkeletons[0]);
+	bool removedUnknown = updater.remove(*skeletons[0]);
+	assert(removed && !removedUnknown && updater.size() == count - 1);
+	(void) removed;
+	(void) removedUnknown;
+	updater.clear();
+
+	ContainerUtil::cleanUpVectorOfPointers(states);
+	ContainerUtil::cleanUpVectorOfPointers(batchStates);
+	ContainerUtil::cleanUpVectorOfPointers(skeletons);
+	ContainerUtil::cleanUpVectorOfPointers(batchSkeletons);
+	delete skeletonData;
+	delete atlas;
+}
+
+void addExampleExports(Vector<TestData> &testData) {
+	const char *names[] = { "spineboy", "raptor", "goblins", "coin", "tank", "stretchyman" };
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		String dir("testdata/");
+		dir.append(names[i]).append("/").append(names[i]);
+		testData.add(TestData(String(dir).append("-pro.json"), String(dir).append("-pro.skel"), String(dir).append(".atlas")));
+	}
+}
+
+/* The skinning loop computeWorldVertices used before the bone matrices were gathered, to compare against. */
+void referenceWorldVertices(VertexAttachment &attachment, Slot &slot, float *worldVertices) {
+	Vector<Bone *> &skeletonBones = slot.getSkeleton().getBones();
+	Vector<size_t> &bones = attachment.getBones();
+	Vector<float> &vertices = attachment.getVertices();
+	Vector<float> &deform = slot.getDeform();
+	for (size_t v = 0, b = 0, f = 0, w = 0; v < bones.size(); w += 2) {
+		float wx = 0, wy = 0;
+		size_t n = bones[v++];
+		n += v;
+		for (; v < n; v++, b += 3, f += 2) {
+			Bone &bone = *skeletonBones[bones[v]];
+			float vx = vertices[b], vy = vertices[b + 1];
+			if (deform.size() > 0) {
+				vx += deform[f];
+				vy += deform[f + 1];
+			}
+			wx += (vx * bone.getA() + vy * bone.getB() + bone.getWorldX()) * vertices[b + 2];
+			wy += (vx * bone.getC() + vy * bone.getD() + bone.getWorldY()) * vertices[b + 2];
+		}
+		worldVertices[w] = wx;
+		worldVertices[w + 1] = wy;
+	}
+}
+
+float nextRandom(unsigned int &seed) {
+	seed = seed * 1103515245 + 12345;
+	return ((seed >> 8) & 0xffff) / 65535.0f;
+}
+
+/* Gives the mesh vertexCount vertices with 1 to maxWidth influences of random bones and weights. */
+void randomWeights(MeshAttachment &mesh, size_t boneCount, size_t vertexCount, size_t maxWidth, unsigned int &seed) {
+	Vector<size_t> &bones = mesh.getBones();
+	Vector<float> &vertices = mesh.getVertices();
+	bones.clear();
+	vertices.clear();
+	for (size_t i = 0; i < vertexCount; i++) {
+		size_t width = 1 + (size_t) (nextRandom(seed) * (maxWidth - 1) + 0.5f);
+		bones.add(width);
+		for (size_t ii = 0; ii < width; ii++) {
+			bones.add((size_t) (nextRandom(seed) * (boneCount - 1) + 0.5f));
+			vertices.add(nextRandom(seed) * 100 - 50);
+			vertices.add(nextRandom(seed) * 100 - 50);
+			vertices.add(1.0f / width);
+		}
+	}
+	mesh.setWorldVerticesLength(vertexCount * 2);
+}
+
+/* Collects the weighted vertex attachments of the skeleton's current pose. */
+void weightedAttachments(Skeleton &skeleton, Vector<Slot *> &slots) {
+	slots.clear();
+	for (size_t i = 0; i < skeleton.getSlots().size(); i++) {
+		Slot *slot = skeleton.getSlots()[i];
+		Attachment *attachment = slot->getAttachment();
+		if (attachment && attachment->getRTTI().instanceOf(VertexAttachment::rtti) &&
+			static_cast<VertexAttachment *>(attachment)->getBones().size() > 0)
+			slots.add(slot);
+	}
+}
+
+void testInfluenceBuckets() {
+	/* Vertices with 2, 1 and 5 influences. */
+	const size_t stream[] = { 2, 0, 1, 1, 2, 5, 0, 1, 2, 3, 4 };
+	Vector<size_t> bones;
+	Vector<float> vertices;
+	for (size_t i = 0; i < sizeof(stream) / sizeof(stream[0]); i++)
+		bones.add(stream[i]);
+	for (int i = 0; i < 8; i++) {
+		vertices.add((float) i);
+		vertices.add((float) -i);
+		vertices.add(0.125f);
+	}
+	InfluenceBuckets buckets(bones, vertices);
+	assert(buckets.getVertexCount(0) == 1 && buckets.getRemap(0)[0] == 1 && buckets.getBones(0)[0] == 2);
+	/* The values of one influence of a group of 4 vertices are next to each other. */
+	assert(buckets.getVertexCount(1) == 1 && buckets.getRemap(1)[0] == 0 && buckets.getInfluences(1)[4] == 1);
+	assert(buckets.getVertexCount(2) == 0 && buckets.getVertexCount(3) == 0 && buckets.getRemap(2).size() == 0);
+	assert(buckets.getVertexCount(4) == 1 && buckets.getWidth(4) == 5 && buckets.getRemap(4)[0] == 2);
+	assert(buckets.getInfluences(4)[16] == 7 && buckets.getVertices(4)[48] == 7 && buckets.getVertices(4)[52] == -7);
+	assert(buckets.getVertices(4)[56] == 0.125f && buckets.getVertices(4)[57] == 0);
+	/* The group is padded to 4 vertices. */
+	assert(buckets.getRemap(4).size() == 4 && buckets.getRemap(4)[1] == -1 && buckets.getBones(4).size() == 20);
+}
+
+void testSkinning() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	Vector<float> expected, actual, range;
+	Vector<Slot *> slots;
+	size_t deformed = 0, checked = 0;
+	/* Each export is read without and with influence buckets. */
+	for (size_t i = 0; i < testData.size() * 2; i++) {
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(testData[i / 2]._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		binary.setUseInfluenceBuckets(i % 2 == 1);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(testData[i / 2]._binarySkeleton);
+		assert(skeletonData);
+		for (int packed = 0; packed < 2; packed++) {
+			Skeleton skeleton(skeletonData, packed == 1);
+			for (size_t ii = 0; ii < skeletonData->getAnimations().size(); ii++) {
+				Animation *animation = skeletonData->getAnimations()[ii];
+				skeleton.setToSetupPose();
+				animation->apply(skeleton, 0, animation->getDuration() / 2, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.updateWorldTransform();
+				weightedAttachments(skeleton, slots);
+				for (size_t iii = 0; iii < slots.size(); iii++) {
+					VertexAttachment *attachment = static_cast<VertexAttachment *>(slots[iii]->getAttachment());
+					assert((attachment->getInfluenceBuckets() != NULL) == (i % 2 == 1));
+					size_t length = attachment->getWorldVerticesLength();
+					expected.setSize(length, 0);
+					actual.setSize(length, 0);
+					referenceWorldVertices(*attachment, *slots[iii], expected.buffer());
+					attachment->computeWorldVertices(*slots[iii], actual);
+					/* A range of the vertices, written with an offset. */
+					size_t start = (length / 4) & ~(size_t) 1;
+					range.setSize(length - start + 4, 0);
+					attachment->computeWorldVertices(*slots[iii], start, length - start, range, 4);
+					for (size_t v = 0; v < length; v++) {
+						assert(MathUtil::abs(expected[v] - actual[v]) <= 0.001f * (1 + MathUtil::abs(expected[v])));
+						if (v >= start)
+							assert(MathUtil::abs(expected[v] - range[v - start + 4]) <= 0.001f * (1 + MathUtil::abs(expected[v])));
+					}
+					if (slots[iii]->getDeform().size() > 0) deformed++;
+					checked++;
+				}
+				/* Bones moved after updateWorldTransform() are gathered again. */
+				if (slots.size() > 0) {
+					Vector<Bone *> &bones = skeleton.getBones();
+					for (size_t iii = 0; iii < bones.size(); iii++)
+						bones[iii]->setWorldX(bones[iii]->getWorldX() + 10);
+					VertexAttachment *attachment = static_cast<VertexAttachment *>(slots[0]->getAttachment());
+					size_t length = attachment->getWorldVerticesLength();
+					expected.setSize(length, 0);
+					actual.setSize(length, 0);
+					referenceWorldVertices(*attachment, *slots[0], expected.buffer());
+					attachment->computeWorldVertices(*slots[0], actual);
+					for (size_t v = 0; v < length; v++)
+						assert(MathUtil::abs(expected[v] - actual[v]) <= 0.001f * (1 + MathUtil::abs(expected[v])));
+				}
+			}
+		}
+		delete skeletonData;
+		delete atlas;
+	}
+	assert(checked > 0 && deformed > 0);
+
+	/* A synthetic mesh fills all buckets, including the one for more than 4 influences, and is skinned in ranges. */
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	Skeleton skeleton(skeletonData);
+	skeleton.updateWorldTransform();
+	Slot &slot = *skeleton.getSlots()[0];
+	MeshAttachment mesh("synthetic");
+	unsigned int seed = 7;
+	randomWeights(mesh, skeleton.getBones().size(), 203, 7, seed);
+	mesh.buildInfluenceBuckets();
+	for (size_t i = 0; i < InfluenceBuckets::BucketCount; i++)
+		assert(mesh.getInfluenceBuckets()->getVertexCount((int) i) > 0);
+	size_t length = mesh.getWorldVerticesLength(), offset = 1, stride = 3;
+	expected.setSize(length, 0);
+	actual.setSize(offset + length / 2 * stride, 0);
+	for (int hasDeform = 0; hasDeform < 2; hasDeform++) {
+		slot.getDeform().clear();
+		for (size_t i = 0; hasDeform && i < mesh.getVertices().size() / 3 * 2; i++)
+			slot.getDeform().add(nextRandom(seed) * 10 - 5);
+		referenceWorldVertices(mesh, slot, expected.buffer());
+		/* Ranges of growing length from several starts, then the rest of the mesh from each start. */
+		const size_t starts[] = {0, 2, 38, 200, 404};
+		for (size_t i = 0; i < sizeof(starts) / sizeof(starts[0]); i++) {
+			for (size_t count = 2;; count = count * 3 + 2) {
+				if (starts[i] + count > length) count = length - starts[i];
+				mesh.computeWorldVertices(slot, starts[i], count, actual.buffer(), offset, stride);
+				for (size_t v = 0; v < count; v++) {
+					float value = expected[starts[i] + v];
+					assert(MathUtil::abs(value - actual[offset + v / 2 * stride + (v & 1)]) <= 0.001f * (1 + MathUtil::abs(value)));
+				}
+				if (starts[i] + count == length) break;
+			}
+		}
+	}
+	slot.getDeform().clear();
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkSkinning() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	Vector<float> worldVertices;
+	Vector<Slot *> slots;
+	for (size_t i = 0; i < testData.size(); i++) {
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(testData[i]._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(testData[i]._binarySkeleton);
+		Skeleton skeleton(skeletonData);
+		Animation *animation = skeletonData->getAnimations()[0];
+		animation->apply(skeleton, 0, animation->getDuration() / 2, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform();
+		weightedAttachments(skeleton, slots);
+		if (slots.size() == 0) {
+			delete skeletonData;
+			delete atlas;
+			continue;
+		}
+
+		size_t vertexCount = 0;
+		for (size_t ii = 0; ii < slots.size(); ii++)
+			vertexCount += static_cast<VertexAttachment *>(slots[ii]->getAttachment())->getWorldVerticesLength() / 2;
+		worldVertices.setSize(vertexCount * 2, 0);
+
+		/* The bone matrices were gathered by updateWorldTransform(), computing the world vertices only reads them. */
+		const int iterations = 2000;
+		double reference = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			clock_t start = clock();
+			for (int n = 0; n < iterations; n++) {
+				for (size_t ii = 0, w = 0; ii < slots.size(); ii++) {
+					VertexAttachment *attachment = static_cast<VertexAttachment *>(slots[ii]->getAttachment());
+					referenceWorldVertices(*attachment, *slots[ii], worldVertices.buffer() + w);
+					w += attachment->getWorldVerticesLength();
+				}
+			}
+			reference = MathUtil::min(reference, (double) (clock() - start) / CLOCKS_PER_SEC);
+		}
+
+		double gathered = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			clock_t start = clock();
+			for (int n = 0; n < iterations; n++) {
+				for (size_t ii = 0, w = 0; ii < slots.size(); ii++) {
+					VertexAttachment *attachment = static_cast<VertexAttachment *>(slots[ii]->getAttachment());
+					attachment->computeWorldVertices(*slots[ii], worldVertices.buffer() + w);
+					w += attachment->getWorldVerticesLength();
+				}
+			}
+			gathered = MathUtil::min(gathered, (double) (clock() - start) / CLOCKS_PER_SEC);
+		}
+
+		for (size_t ii = 0; ii < slots.size(); ii++)
+			static_cast<VertexAttachment *>(slots[ii]->getAttachment())->buildInfluenceBuckets();
+		double bucketed = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			clock_t start = clock();
+			for (int n = 0; n < iterations; n++) {
+				for (size_t ii = 0, w = 0; ii < slots.size(); ii++) {
+					VertexAttachment *attachment = static_cast<VertexAttachment *>(slots[ii]->getAttachment());
+					attachment->computeWorldVertices(*slots[ii], worldVertices.buffer() + w);
+					w += attachment->getWorldVerticesLength();
+				}
+			}
+			bucketed = MathUtil::min(bucketed, (double) (clock() - start) / CLOCKS_PER_SEC);
+		}
+
+		printf("%s: %zu weighted attachments, %zu vertices, per bone %.3f us, gathered %.3f us (%.2fx), influence buckets %.3f us "
+			   "(%.2fx) per skeleton\n", testData[i]._binarySkeleton.buffer(), slots.size(), vertexCount,
+			   reference * 1000000 / iterations, gathered * 1000000 / iterations, gathered > 0 ? reference / gathered : 0,
+			   bucketed * 1000000 / iterations, bucketed > 0 ? reference / bucketed : 0);
+
+		delete skeletonData;
+		delete atlas;
+	}
+
+	/* Large synthetic meshes, where the buckets skin 4 vertices per register and outweigh the cost of splitting the mesh. */
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	Skeleton skeleton(skeletonData);
+	skeleton.updateWorldTransform();
+	Slot &slot = *skeleton.getSlots()[0];
+	unsigned int seed = 3;
+	const size_t maxWidths[] = {1, 2, 4};
+	for (size_t i = 0; i < sizeof(maxWidths) / sizeof(maxWidths[0]); i++) {
+		MeshAttachment mesh("synthetic");
+		const size_t vertexCount = 4000;
+		randomWeights(mesh, skeleton.getBones().size(), vertexCount, maxWidths[i], seed);
+		worldVertices.setSize(vertexCount * 2, 0);
+		const int iterations = 500;
+		double seconds[2];
+		for (int buckets = 0; buckets < 2; buckets++) {
+			if (buckets == 1) mesh.buildInfluenceBuckets();
+			seconds[buckets] = DBL_MAX;
+			for (int repeat = 0; repeat < 5; repeat++) {
+				clock_t start = clock();
+				for (int n = 0; n < iterations; n++)
+					mesh.computeWorldVertices(slot, worldVertices);
+				seconds[buckets] = MathUtil::min(seconds[buckets], (double) (clock() - start) / CLOCKS_PER_SEC);
+			}
+		}
+		printf("%zu vertices with 1 to %zu influences: gathered %.3f ns, influence buckets %.3f ns (%.2fx) per vertex\n", vertexCount,
+			   maxWidths[i], seconds[0] * 1000000000 / iterations / vertexCount, seconds[1] * 1000000000 / iterations / vertexCount,
+			   seconds[1] > 0 ? seconds[0] / seconds[1] : 0);
+	}
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkWorldTransform() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+
+	const int iterations = 20000;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		Skeleton packed(skeletonData, true);
+		Animation *animation = skeletonData->getAnimations()[0];
+		animation->apply(skeleton, 0, 0.5f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		animation->apply(packed, 0, 0.5f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+
+		double scalar = DBL_MAX, batched = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			clock_t start = clock();
+			for (int ii = 0; ii < iterations; ii++)
+				skeleton.updateWorldTransform();
+			scalar = MathUtil::min(scalar, (double) (clock() - start) / CLOCKS_PER_SEC);
+
+			start = clock();
+			for (int ii = 0; ii < iterations; ii++)
+				packed.updateWorldTransform();
+			batched = MathUtil::min(batched, (double) (clock() - start) / CLOCKS_PER_SEC);
+		}
+
+		printf("%s: %zu bones, scalar %.3f us, pose store %.3f us per updateWorldTransform (%.2fx)\n",
+			   data._binarySkeleton.buffer(), skeleton.getBones().size(), scalar * 1000000 / iterations,
+			   batched * 1000000 / iterations, batched > 0 ? scalar / batched : 0);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void testIncrementalUpdate() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/tank/tank-pro.json", "testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"));
+	testData.add(TestData("testdata/stretchyman/stretchyman-pro.json", "testdata/stretchyman/stretchyman-pro.skel",
+						  "testdata/stretchyman/stretchyman.atlas"));
+
+	for (size_t i = 0; i < testData.size() * 2; i++) {
+		TestData &data = testData[i % testData.size()];
+		bool usePoseStore = i >= testData.size();
+		printf("Comparing incremental updates for %s%s\n", data._binarySkeleton.buffer(), usePoseStore ? " with pose store" : "");
+
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData, usePoseStore);
+		Skeleton incremental(skeletonData, usePoseStore);
+		incremental.setIncrementalUpdate(true);
+		assert(incremental.getIncrementalUpdate());
+		Vector<Bone *> &bones = skeleton.getBones();
+
+		float maxError = 0;
+		int frame = 0;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *animation = animations[ii];
+			skeleton.setToSetupPose();
+			incremental.setToSetupPose();
+			for (float time = 0; time < animation->getDuration(); time += 1 / 30.0f, frame++) {
+				if (frame % 3 == 0) {
+					/* A full animation frame. */
+					animation->apply(skeleton, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+					animation->apply(incremental, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+				} else if (frame % 3 == 1) {
+					/* Only a single bone changes. */
+					size_t index = frame % bones.size();
+					bones[index]->setRotation(bones[index]->getRotation() + 5);
+					incremental.getBones()[index]->setRotation(incremental.getBones()[index]->getRotation() + 5);
+				}
+				skeleton.updateWorldTransform();
+				incremental.updateWorldTransform();
+				for (size_t iii = 0; iii < bones.size(); iii++) {
+					Bone *bone = bones[iii];
+					Bone *incrementalBone = incremental.getBones()[iii];
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getA() - incrementalBone->getA()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getB() - incrementalBone->getB()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getC() - incrementalBone->getC()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getD() - incrementalBone->getD()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getWorldX() - incrementalBone->getWorldX()));
+					maxError = MathUtil::max(maxError, MathUtil::abs(bone->getWorldY() - incrementalBone->getWorldY()));
+				}
+			}
+		}
+		printf("Max error: %f\n", maxError);
+		assert(maxError < 0.0001f);
+
+		/* Unchanged bones are not recomputed, so a world transform modified directly is kept. Path constraints are always
+		 * applied, stretchyman's dirty most bones and fall back to the full update. */
+		Bone *root = incremental.getRootBone();
+		root->setWorldX(root->getWorldX() + 1000);
+		float worldX = root->getWorldX();
+		incremental.updateWorldTransform();
+		assert(root->getWorldX() == worldX || skeletonData->getPathConstraints().size() > 0);
+		incremental.setX(incremental.getX() + 1);
+		incremental.updateWorldTransform();
+		assert(root->getWorldX() != worldX);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void benchmarkIncrementalUpdate() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+
+	const int iterations = 20000;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		Skeleton incremental(skeletonData);
+		incremental.setIncrementalUpdate(true);
+		Animation *animation = skeletonData->getAnimations()[0];
+		animation->apply(skeleton, 0, 0.5f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		animation->apply(incremental, 0, 0.5f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		Bone *leaf = incremental.getBones()[incremental.getBones().size() - 1];
+
+		clock_t start = clock();
+		for (int ii = 0; ii < iterations; ii++)
+			skeleton.updateWorldTransform();
+		double full = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for (int ii = 0; ii < iterations; ii++)
+			incremental.updateWorldTransform();
+		double unchanged = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for (int ii = 0; ii < iterations; ii++) {
+			leaf->setRotation((float) (ii % 360));
+			incremental.updateWorldTransform();
+		}
+		double oneBone = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("%s: full %.3f us, incremental unchanged %.3f us (%.2fx), one bone changed %.3f us (%.2fx) per updateWorldTransform\n",
+			   data._binarySkeleton.buffer(), full * 1000000 / iterations, unchanged * 1000000 / iterations,
+			   unchanged > 0 ? full / unchanged : 0, oneBone * 1000000 / iterations, oneBone > 0 ? full / oneBone : 0);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Returns the fastest of several runs of update() and apply() with the state's current tracks, in seconds. */
+double timeApply(AnimationState &state, Skeleton &skeleton, int iterations) {
+	double fastest = DBL_MAX;
+	for (int repeat = 0; repeat < 5; repeat++) {
+		clock_t start = clock();
+		for (int i = 0; i < iterations; i++) {
+			state.update(1 / 600.0f);
+			state.apply(skeleton);
+		}
+		fastest = MathUtil::min(fastest, (double) (clock() - start) / CLOCKS_PER_SEC);
+	}
+	return fastest;
+}
+
+/* Measures AnimationState::apply() per 1000 applied timelines, for the current entry alone and while mixing from another one. */
+void benchmarkTimelineDispatch() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	const int iterations = 1000;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		double current = 0, mixing = 0;
+		size_t currentTimelines = 0, mixingTimelines = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *from = animations[ii], *to = animations[(ii + 1) % animations.size()];
+			state.setAnimation(0, from, true);
+			current += timeApply(state, skeleton, iterations);
+			currentTimelines += from->getTimelines().size() * iterations;
+
+			state.setAnimation(0, to, true)->setMixDuration(1000);
+			mixing += timeApply(state, skeleton, iterations);
+			mixingTimelines += (from->getTimelines().size() + to->getTimelines().size()) * iterations;
+			state.clearTracks();
+		}
+		printf("%s: %.3f us per 1000 timelines applied, %.3f us while mixing\n", data._binarySkeleton.buffer(),
+			   current * 1000000000 / currentTimelines, mixing * 1000000000 / mixingTimelines);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Returns the max difference between the local transforms of the bones of two skeletons. */
+float compareLocalTransforms(Skeleton &expected, Skeleton &actual) {
+	float maxError = 0;
+	for (size_t i = 0; i < expected.getBones().size(); i++) {
+		Bone *bone = expected.getBones()[i];
+		Bone *actualBone = actual.getBones()[i];
+		float rotation = bone->getRotation() - actualBone->getRotation();
+		rotation -= (16384 - (int) (16384.499999999996 - rotation / 360)) * 360;
+		maxError = MathUtil::max(maxError, MathUtil::abs(rotation));
+		maxError = MathUtil::max(maxError, MathUtil::abs(bone->getX() - actualBone->getX()));
+		maxError = MathUtil::max(maxError, MathUtil::abs(bone->getY() - actualBone->getY()));
+		maxError = MathUtil::max(maxError, MathUtil::abs(bone->getScaleX() - actualBone->getScaleX()));
+		maxError = MathUtil::max(maxError, MathUtil::abs(bone->getScaleY() - actualBone->getScaleY()));
+		maxError = MathUtil::max(maxError, MathUtil::abs(bone->getShearX() - actualBone->getShearX()));
+		maxError = MathUtil::max(maxError, MathUtil::abs(bone->getShearY() - actualBone->getShearY()));
+	}
+	return maxError;
+}
+
+/* AnimationState applies timelines grouped by type, the pose must match applying them in order with Animation::apply(). */
+void testTimelineGroups() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton grouped(skeletonData);
+		Skeleton ordered(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		float maxError = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *animation = animations[ii];
+			state.clearTracks();
+			grouped.setToSetupPose();
+			ordered.setToSetupPose();
+			TrackEntry *entry = state.setAnimation(0, animation, true);
+			for (int frame = 0; frame < 100; frame++) {
+				state.update(1 / 30.0f);
+				state.apply(grouped);
+				float time = entry->getAnimationTime();
+				animation->apply(ordered, time, time, false, NULL, 1, MixBlend_First, MixDirection_In);
+
+				maxError = MathUtil::max(maxError, compareLocalTransforms(ordered, grouped));
+				for (size_t s = 0; s < ordered.getSlots().size(); s++) {
+					Slot *expected = ordered.getSlots()[s], *actual = grouped.getSlots()[s];
+					assert(expected->getAttachment() == actual->getAttachment());
+					assert(expected->getColor().r == actual->getColor().r && expected->getColor().a == actual->getColor().a);
+					assert(expected->getDeform().size() == actual->getDeform().size());
+					for (size_t v = 0; v < expected->getDeform().size(); v++)
+						assert(expected->getDeform()[v] == actual->getDeform()[v]);
+					assert(ordered.getDrawOrder()[s]->getData().getIndex() == grouped.getDrawOrder()[s]->getData().getIndex());
+				}
+			}
+		}
+		printf("%s: max error %f between grouped and ordered timelines\n", data._binarySkeleton.buffer(), maxError);
+		assert(maxError < 0.0001f);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Loads the skeleton data and returns the number of heap blocks it added. */
+SkeletonData *readCountingBlocks(DebugExtension &debug, SkeletonBinary &binary, const String &path, size_t &blocks) {
+	size_t allocations = debug.getAllocationCount(), frees = debug.getFreeCount();
+	SkeletonData *skeletonData = binary.readSkeletonDataFile(path);
+	blocks = (debug.getAllocationCount() - allocations) - (debug.getFreeCount() - frees);
+	return skeletonData;
+}
+
+void testPackedFrames(DebugExtension &debug) {
+	{
+		float data[] = {1, 2, 3};
+		Vector<float> view;
+		view.setView(data, 3);
+		assert(view.isView() && view.size() == 3 && view[2] == 3);
+		Vector<float> copy(view);
+		assert(!copy.isView() && copy.size() == 3 && copy[1] == 2);
+		view.add(4);
+		assert(!view.isView() && view.size() == 4 && view[0] == 1 && view[3] == 4);
+		view[0] = 5;
+		assert(data[0] == 1);
+	}
+
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		size_t blocks, packedBlocks;
+		SkeletonData *skeletonData = readCountingBlocks(debug, binary, data._binarySkeleton, blocks);
+		binary.setPackFrames(true);
+		SkeletonData *packedData = readCountingBlocks(debug, binary, data._binarySkeleton, packedBlocks);
+		assert(skeletonData && packedData);
+		printf("%s: %zu heap blocks, %zu with packed frames\n", data._binarySkeleton.buffer(), blocks, packedBlocks);
+		assert(packedBlocks < blocks);
+
+		Skeleton skeleton(skeletonData);
+		Skeleton packed(packedData);
+		for (size_t ii = 0; ii < skeletonData->getAnimations().size(); ii++) {
+			Animation *animation = skeletonData->getAnimations()[ii];
+			Animation *packedAnimation = packedData->getAnimations()[ii];
+			assert(animation->getPackedFrames().size() == 0);
+			Vector<float> &frames = packedAnimation->getPackedFrames();
+			Vector<Timeline *> &timelines = packedAnimation->getTimelines();
+			for (size_t t = 0; t < timelines.size(); t++) {
+				if (!timelines[t]->getRTTI().isExactly(RotateTimeline::rtti)) continue;
+				Vector<float> &rotateFrames = static_cast<RotateTimeline *>(timelines[t])->getFrames();
+				assert(rotateFrames.isView());
+				assert(rotateFrames.buffer() >= frames.buffer() && rotateFrames.buffer() < frames.buffer() + frames.size());
+			}
+
+			skeleton.setToSetupPose();
+			packed.setToSetupPose();
+			for (float time = 0; time < animation->getDuration(); time += 1 / 30.0f) {
+				animation->apply(skeleton, time, time, false, NULL, 1, MixBlend_First, MixDirection_In);
+				packedAnimation->apply(packed, time, time, false, NULL, 1, MixBlend_First, MixDirection_In);
+				assert(compareLocalTransforms(skeleton, packed) == 0);
+				for (size_t s = 0; s < skeleton.getSlots().size(); s++) {
+					Vector<float> &deform = skeleton.getSlots()[s]->getDeform(), &packedDeform = packed.getSlots()[s]->getDeform();
+					assert(deform.size() == packedDeform.size());
+					for (size_t v = 0; v < deform.size(); v++)
+						assert(deform[v] == packedDeform[v]);
+				}
+			}
+		}
+
+		delete packedData;
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Applies every animation of the skeleton data each iteration, so the frames don't stay in the cache as with one animation. */
+void benchmarkPackedFrames() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	const int iterations = 500;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		double seconds[2];
+		for (int pack = 0; pack < 2; pack++) {
+			SkeletonBinary binary(atlas);
+			binary.setPackFrames(pack == 1);
+			SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+			assert(skeletonData);
+			Skeleton skeleton(skeletonData);
+			Vector<Animation *> &animations = skeletonData->getAnimations();
+			seconds[pack] = DBL_MAX;
+			for (int repeat = 0; repeat < 5; repeat++) {
+				clock_t start = clock();
+				for (int ii = 0; ii < iterations; ii++) {
+					for (size_t a = 0; a < animations.size(); a++) {
+						float time = MathUtil::fmod(ii / 60.0f, animations[a]->getDuration() + 0.001f);
+						animations[a]->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					}
+				}
+				seconds[pack] = MathUtil::min(seconds[pack], (double) (clock() - start) / CLOCKS_PER_SEC);
+			}
+			delete skeletonData;
+		}
+		printf("%s: all animations applied in %.3f us, packed frames %.3f us (%.2fx)\n", data._binarySkeleton.buffer(),
+			   seconds[0] * 1000000 / iterations, seconds[1] * 1000000 / iterations, seconds[1] > 0 ? seconds[0] / seconds[1] : 0);
+		delete atlas;
+	}
+}
+
+void testQuantizedDeform() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		binary.setQuantizeDeform(true);
+		SkeletonData *quantizedData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData && quantizedData);
+
+		// Memory of the keyframe values, to see what the deform vertices weigh against the curves.
+		size_t floatBytes = 0, quantizedBytes = 0, frameBytes = 0, curveBytes = 0;
+		float maxScale = 0;
+		for (size_t ii = 0; ii < skeletonData->getAnimations().size(); ii++) {
+			Vector<Timeline *> &timelines = skeletonData->getAnimations()[ii]->getTimelines();
+			Vector<Timeline *> &quantizedTimelines = quantizedData->getAnimations()[ii]->getTimelines();
+			for (size_t t = 0; t < timelines.size(); t++) {
+				if (timelines[t]->getRTTI().isExactly(DeformTimeline::rtti)) {
+					DeformTimeline *timeline = static_cast<DeformTimeline *>(timelines[t]);
+					DeformTimeline *quantized = static_cast<DeformTimeline *>(quantizedTimelines[t]);
+					assert(!timeline->isQuantized() && quantized->isQuantized() && quantized->getVertices().size() == 0);
+					for (size_t f = 0; f < timeline->getVertices().size(); f++)
+						floatBytes += timeline->getVertices()[f].size() * sizeof(float);
+					quantizedBytes += quantized->getQuantizedVertices().size() * sizeof(unsigned short);
+					maxScale = MathUtil::max(maxScale, quantized->getQuantizedScale());
+				} else if (timelines[t]->getRTTI().isExactly(RotateTimeline::rtti)) {
+					frameBytes += static_cast<RotateTimeline *>(timelines[t])->getFrames().size() * sizeof(float);
+				} else if (timelines[t]->getRTTI().instanceOf(TranslateTimeline::rtti)) {
+					frameBytes += static_cast<TranslateTimeline *>(timelines[t])->getFrameCount() * TranslateTimeline::ENTRIES *
+								  sizeof(float);
+				} else if (timelines[t]->getRTTI().isExactly(ColorTimeline::rtti)) {
+					frameBytes += static_cast<ColorTimeline *>(timelines[t])->getFrames().size() * sizeof(float);
+				}
+				// Each frame but the last has 19 curve floats.
+				if (timelines[t]->getRTTI().instanceOf(CurveTimeline::rtti))
+					curveBytes += (static_cast<CurveTimeline *>(timelines[t])->getFrameCount() - 1) * 19 * sizeof(float);
+			}
+		}
+
+		// Accuracy of the quantized vertices against the float path, fully applied and mixed.
+		Skeleton skeleton(skeletonData);
+		Skeleton quantized(quantizedData);
+		float maxError = 0;
+		for (size_t ii = 0; ii < skeletonData->getAnimations().size(); ii++) {
+			Animation *animation = skeletonData->getAnimations()[ii];
+			Animation *quantizedAnimation = quantizedData->getAnimations()[ii];
+			for (int mix = 0; mix < 2; mix++) {
+				float alpha = mix == 0 ? 1 : 0.5f;
+				MixBlend blend = mix == 0 ? MixBlend_First : MixBlend_Setup;
+				skeleton.setToSetupPose();
+				quantized.setToSetupPose();
+				for (float time = 0; time < animation->getDuration() + 0.1f; time += 1 / 30.0f) {
+					animation->apply(skeleton, time, time, false, NULL, alpha, blend, MixDirection_In);
+					quantizedAnimation->apply(quantized, time, time, false, NULL, alpha, blend, MixDirection_In);
+					assert(compareLocalTransforms(skeleton, quantized) == 0);
+					for (size_t s = 0; s < skeleton.getSlots().size(); s++) {
+						Vector<float> &deform = skeleton.getSlots()[s]->getDeform();
+						Vector<float> &quantizedDeform = quantized.getSlots()[s]->getDeform();
+						assert(deform.size() == quantizedDeform.size());
+						for (size_t v = 0; v < deform.size(); v++)
+							maxError = MathUtil::max(maxError, MathUtil::abs(deform[v] - quantizedDeform[v]));
+					}
+				}
+			}
+		}
+		printf("%s: deform vertices %zu bytes, quantized %zu bytes, max error %f (step %f); bone/color values %zu bytes, "
+			   "curves %zu bytes\n", data._binarySkeleton.buffer(), floatBytes, quantizedBytes, maxError, maxScale, frameBytes,
+			   curveBytes);
+		assert(quantizedBytes * 2 == floatBytes);
+		assert(maxError <= maxScale);
+
+		delete quantizedData;
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Returns the max difference of the world transforms of the bones, scale and rotation part and translation separately. */
+void compareWorldTransforms(Skeleton &expected, Skeleton &actual, float &maxMatrixError, float &maxPositionError) {
+	for (size_t i = 0; i < expected.getBones().size(); i++) {
+		Bone *bone = expected.getBones()[i];
+		Bone *actualBone = actual.getBones()[i];
+		maxMatrixError = MathUtil::max(maxMatrixError, MathUtil::abs(bone->getA() - actualBone->getA()));
+		maxMatrixError = MathUtil::max(maxMatrixError, MathUtil::abs(bone->getB() - actualBone->getB()));
+		maxMatrixError = MathUtil::max(maxMatrixError, MathUtil::abs(bone->getC() - actualBone->getC()));
+		maxMatrixError = MathUtil::max(maxMatrixError, MathUtil::abs(bone->getD() - actualBone->getD()));
+		maxPositionError = MathUtil::max(maxPositionError, MathUtil::abs(bone->getWorldX() - actualBone->getWorldX()));
+		maxPositionError = MathUtil::max(maxPositionError, MathUtil::abs(bone->getWorldY() - actualBone->getWorldY()));
+	}
+}
+
+void testAtan2() {
+	// Largest error against the C library, which MathUtil::atan2() uses unless SPINE_FAST_MATH is defined.
+	float atan2Error = 0;
+	for (int i = -2000000; i <= 2000000; i++) {
+		float radians = i * 0.0000157f;
+		float y = (float) sin(radians), x = (float) cos(radians) * 1.7f;
+		atan2Error = MathUtil::max(atan2Error, MathUtil::abs(MathUtil::atan2(y, x) - (float) atan2(y, x)));
+	}
+	assert(MathUtil::atan2(0, 0) == 0 && MathUtil::atan2(0, -1) == MathUtil::Pi && MathUtil::atan2(-1, 0) == -MathUtil::Pi / 2);
+	printf("atan2 max error %g radians\n", atan2Error);
+#ifdef SPINE_FAST_MATH
+	assert(atan2Error <= 2.5e-6f);
+#else
+	assert(atan2Error == 0);
+#endif
+}
+
+void benchmarkAtan2() {
+	const int count = 2000000;
+	double seconds[2];
+	volatile float sink = 0;
+	for (int library = 0; library < 2; library++) {
+		seconds[library] = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			float sum = 0;
+			clock_t start = clock();
+			for (int i = 0; i < count; i++) {
+				float y = i * 0.37f - 300000, x = 200000 - i * 0.21f;
+				sum += library == 1 ? (float) atan2(y, x) : MathUtil::atan2(y, x);
+			}
+			seconds[library] = MathUtil::min(seconds[library], (double) (clock() - start) / CLOCKS_PER_SEC);
+			sink = sink + sum;
+		}
+	}
+	printf("MathUtil::atan2 %.2f ns, C library %.2f ns (%.2fx)\n", seconds[0] * 1000000000 / count,
+		   seconds[1] * 1000000000 / count, seconds[0] > 0 ? seconds[1] / seconds[0] : 0);
+}
+
+/* Removes the attachment keys so attachments are found by name, as before SkeletonData::indexAttachments(). */
+void clearAttachmentKeys(SkeletonData *skeletonData) {
+	Vector<SlotData *> &slots = skeletonData->getSlots();
+	for (size_t i = 0; i < slots.size(); i++)
+		slots[i]->setAttachmentName(String(slots[i]->getAttachmentName()));
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	for (size_t i = 0; i < animations.size(); i++) {
+		Vector<Timeline *> &timelines = animations[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ii++)
+			if (timelines[ii]->getRTTI().isExactly(AttachmentTimeline::rtti))
+				static_cast<AttachmentTimeline *>(timelines[ii])->getAttachmentKeys().clear();
+	}
+}
+
+void testAttachmentKeys() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *keyedData = binary.readSkeletonDataFile(data._binarySkeleton);
+		SkeletonData *namedData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(keyedData && namedData);
+		assert(keyedData->getAttachmentKeyCount() > 0);
+		clearAttachmentKeys(namedData);
+
+		Skeleton keyed(keyedData), named(namedData);
+		AnimationStateData keyedStateData(keyedData), namedStateData(namedData);
+		AnimationState keyedState(&keyedStateData), namedState(&namedStateData);
+		Vector<Skin *> &skins = keyedData->getSkins();
+		Vector<Animation *> &animations = keyedData->getAnimations();
+		int compared = 0;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			keyedState.setAnimation(0, animations[ii], true);
+			namedState.setAnimation(0, namedData->getAnimations()[ii], true);
+			for (int frame = 0; frame < 100; frame++) {
+				/* Switch skins during the animation, the keyed skeleton must resolve its table again. */
+				if (frame % 50 == 0 && skins.size() > 1) {
+					const String &skinName = skins[(ii + frame / 50) % skins.size()]->getName();
+					keyed.setSkin(skinName);
+					named.setSkin(skinName);
+				}
+				keyedState.update(1 / 30.0f);
+				namedState.update(1 / 30.0f);
+				keyedState.apply(keyed);
+				namedState.apply(named);
+				for (size_t s = 0; s < keyed.getSlots().size(); s++) {
+					Attachment *expected = named.getSlots()[s]->getAttachment(), *actual = keyed.getSlots()[s]->getAttachment();
+					assert((expected == NULL) == (actual == NULL));
+					if (expected) assert(expected->getName() == actual->getName());
+					compared++;
+				}
+			}
+		}
+
+		/* Replacing an attachment in the skin invalidates the resolved table. */
+		Skin *skin = keyed.getSkin() ? keyed.getSkin() : keyedData->getDefaultSkin();
+		Vector<SlotData *> &slots = keyedData->getSlots();
+		for (size_t s = 0; s < slots.size(); s++) {
+			const String &attachmentName = slots[s]->getAttachmentName();
+			Attachment *attachment = skin->getAttachment(s, attachmentName);
+			if (!attachment) continue;
+			assert(keyed.getAttachment((int) s, slots[s]->getAttachmentKey(), attachmentName) == attachment);
+			keyed.getSlots()[s]->setAttachment(NULL);
+			Attachment *copy = attachment->copy();
+			skin->setAttachment(s, attachmentName, copy);
+			assert(keyed.getAttachment((int) s, slots[s]->getAttachmentKey(), attachmentName) == copy);
+			skin->removeAttachment(s, attachmentName);
+			assert(keyed.getAttachment((int) s, slots[s]->getAttachmentKey(), attachmentName) ==
+				   keyed.getAttachment((int) s, attachmentName));
+			break;
+		}
+		printf("%s: %d slot attachments match with %d attachment keys\n", data._binarySkeleton.buffer(), compared,
+			   (int) keyedData->getAttachmentKeyCount());
+
+		delete namedData;
+		delete keyedData;
+		delete atlas;
+	}
+}
+
+void benchmarkAttachmentKeys() {
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/goblins/goblins.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *keyedData = binary.readSkeletonDataFile("testdata/goblins/goblins-pro.skel");
+	SkeletonData *namedData = binary.readSkeletonDataFile("testdata/goblins/goblins-pro.skel");
+	assert(keyedData && namedData);
+	clearAttachmentKeys(namedData);
+
+	const int iterations = 20000;
+	double seconds[2];
+	for (int k = 0; k < 2; k++) {
+		SkeletonData *skeletonData = k == 0 ? namedData : keyedData;
+		Skeleton skeleton(skeletonData);
+		skeleton.setSkin("goblingirl");
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		state.setAnimation(0, "walk", true);
+		seconds[k] = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			clock_t start = clock();
+			for (int i = 0; i < iterations; i++) {
+				skeleton.setSlotsToSetupPose();
+				state.update(1 / 60.0f);
+				state.apply(skeleton);
+			}
+			seconds[k] = MathUtil::min(seconds[k], (double) (clock() - start) / CLOCKS_PER_SEC);
+		}
+	}
+	printf("goblins-pro.skel: setSlotsToSetupPose + AnimationState::apply %.3f us by name, %.3f us by attachment key (%.2fx)\n",
+		   seconds[0] * 1000000 / iterations, seconds[1] * 1000000 / iterations, seconds[1] > 0 ? seconds[0] / seconds[1] : 0);
+
+	delete namedData;
+	delete keyedData;
+	delete atlas;
+}
+
+void testJsonParser() {
+	/* Names are case insensitive and the first match is returned, later items are found past items with other names. */
+	Json *json = new(__FILE__, __LINE__) Json("{\"Name\": 1, \"name\": 2, \"text\": \"a\\\"b\\n\\u00e9\", \"list\": [1, 2, 3],"
+											  "\"yes\": true, \"no\": false, \"none\": null}");
+	assert(Json::getInt(json, "Name", 0) == 1 && Json::getInt(json, "name", 0) == 1 && Json::getInt(json, "NAME", 0) == 1);
+	assert(Json::getItem(json, "TEXT") && Json::getItem(json, "List") && Json::getFloat(json, "missing", 5) == 5);
+	assert(strcmp(Json::getString(json, "text", ""), "a\"b\n\xc3\xa9") == 0);
+	assert(Json::getItem(json, "list") && Json::getItem(json, "none"));
+	assert(Json::getBoolean(json, "yes", false) && !Json::getBoolean(json, "no", true) && !Json::getBoolean(json, "none", true));
+	delete json;
+
+	/* Numbers must parse to the same floats as strtod(). */
+	const char *formats[] = {"%.0f", "%.2f", "%.6f", "%.9g", "%.17g", "%e", "%.3e"};
+	const int count = 3000;
+	unsigned int seed = 1;
+	String text("{");
+	char buffer[64];
+	Vector<float> expected;
+	for (int i = 0; i < count; i++) {
+		seed = seed * 1103515245u + 12345u;
+		double value = ((seed >> 8) / 16777216.0 - 0.5) * pow(10.0, (int) (seed % 13) - 6);
+		snprintf(buffer, sizeof(buffer), "\"n%d\": ", i);
+		text.append(buffer);
+		snprintf(buffer, sizeof(buffer), formats[i % 7], value);
+		expected.add((float) strtod(buffer, NULL));
+		text.append(buffer);
+		text.append(i < count - 1 ? ", " : "}");
+	}
+	json = new(__FILE__, __LINE__) Json(text.buffer());
+	int exact = 0;
+	for (int i = 0; i < count; i++) {
+		snprintf(buffer, sizeof(buffer), "n%d", i);
+		float value = Json::getFloat(json, buffer, NAN);
+		if (value == expected[i]) exact++;
+		assert(MathUtil::abs(value - expected[i]) <= MathUtil::abs(expected[i]) * FLT_EPSILON);
+	}
+	printf("Json: %d of %d numbers parsed exactly as strtod\n", exact, count);
+	delete json;
+}
+
+void testBinaryWriter() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonJson json(atlas);
+		SkeletonData *expected = json.readSkeletonDataFile(data._jsonSkeleton);
+		SkeletonBinary binary(atlas);
+		Vector<unsigned char> bytes;
+		assert(expected);
+		bool written = binary.writeSkeletonData(expected, bytes);
+		assert(written);
+		SkeletonData *actual = binary.readSkeletonData(bytes.buffer(), (int) bytes.size());
+		assert(actual);
+
+		/* Everything but the curves is stored exactly. */
+		assert(actual->getBones().size() == expected->getBones().size());
+		for (size_t ii = 0; ii < expected->getBones().size(); ii++) {
+			BoneData *expectedBone = expected->getBones()[ii], *actualBone = actual->getBones()[ii];
+			assert(actualBone->getName() == expectedBone->getName() && actualBone->getX() == expectedBone->getX() &&
+				   actualBone->getY() == expectedBone->getY() && actualBone->getRotation() == expectedBone->getRotation());
+		}
+		assert(actual->getSlots().size() == expected->getSlots().size());
+		for (size_t ii = 0; ii < expected->getSlots().size(); ii++)
+			assert(actual->getSlots()[ii]->getAttachmentName() == expected->getSlots()[ii]->getAttachmentName());
+		assert(actual->getSkins().size() == expected->getSkins().size() &&
+			   actual->getEvents().size() == expected->getEvents().size() &&
+			   actual->getAnimations().size() == expected->getAnimations().size());
+		for (size_t ii = 0; ii < expected->getSkins().size(); ii++) {
+			Skin *expectedSkin = expected->getSkins()[ii], *actualSkin = actual->findSkin(expectedSkin->getName());
+			assert(actualSkin);
+			Vector<String> names;
+			for (size_t slotIndex = 0; slotIndex < expected->getSlots().size(); slotIndex++) {
+				names.clear();
+				expectedSkin->findNamesForSlot(slotIndex, names);
+				for (size_t iii = 0; iii < names.size(); iii++) {
+					Attachment *attachment = actualSkin->getAttachment(slotIndex, names[iii]);
+					assert(attachment && attachment->getRTTI().isExactly(expectedSkin->getAttachment(slotIndex, names[iii])->getRTTI()));
+				}
+			}
+		}
+
+		/* The poses differ by the rounding of the recovered bezier control points. */
+		Skeleton expectedSkeleton(expected), actualSkeleton(actual);
+		float maxMatrixError = 0, maxPositionError = 0, maxDeformError = 0;
+		for (size_t ii = 0; ii < expected->getAnimations().size(); ii++) {
+			Animation *expectedAnimation = expected->getAnimations()[ii], *actualAnimation = actual->getAnimations()[ii];
+			assert(actualAnimation->getName() == expectedAnimation->getName());
+			assert(actualAnimation->getDuration() == expectedAnimation->getDuration());
+			assert(actualAnimation->getTimelines().size() == expectedAnimation->getTimelines().size());
+			expectedSkeleton.setToSetupPose();
+			actualSkeleton.setToSetupPose();
+			for (float time = 0; time < expectedAnimation->getDuration() + 0.1f; time += 1 / 30.0f) {
+				expectedAnimation->apply(expectedSkeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				actualAnimation->apply(actualSkeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				expectedSkeleton.updateWorldTransform();
+				actualSkeleton.updateWorldTransform();
+				compareWorldTransforms(expectedSkeleton, actualSkeleton, maxMatrixError, maxPositionError);
+				for (size_t s = 0; s < expectedSkeleton.getSlots().size(); s++) {
+					Slot *expectedSlot = expectedSkeleton.getSlots()[s], *actualSlot = actualSkeleton.getSlots()[s];
+					assert(expectedSlot->getAttachment() == NULL ? actualSlot->getAttachment() == NULL :
+						   actualSlot->getAttachment() && actualSlot->getAttachment()->getName() == expectedSlot->getAttachment()->getName());
+					assert(expectedSkeleton.getDrawOrder()[s]->getData().getIndex() == actualSkeleton.getDrawOrder()[s]->getData().getIndex());
+					Vector<float> &expectedDeform = expectedSlot->getDeform(), &actualDeform = actualSlot->getDeform();
+					assert(expectedDeform.size() == actualDeform.size());
+					for (size_t v = 0; v < expectedDeform.size(); v++)
+						maxDeformError = MathUtil::max(maxDeformError, MathUtil::abs(expectedDeform[v] - actualDeform[v]));
+				}
+			}
+		}
+
+		/* Writing the data read back gives the same layout, only the curve floats may differ in their last bits. */
+		Vector<unsigned char> rewritten;
+		written = binary.writeSkeletonData(actual, rewritten);
+		assert(written && rewritten.size() == bytes.size());
+		(void) written;
+		int exportedLength;
+		char *exported = SpineExtension::readFile(data._binarySkeleton, &exportedLength);
+		SpineExtension::free(exported, __FILE__, __LINE__);
+		printf("%s: %zu bytes written, exported %d bytes; max error matrix %f, position %f, deform %f\n",
+			   data._jsonSkeleton.buffer(), bytes.size(), exportedLength, maxMatrixError, maxPositionError, maxDeformError);
+		assert(maxMatrixError < 0.001f && maxPositionError < 0.01f && maxDeformError < 0.01f);
+
+		delete actual;
+		delete expected;
+		delete atlas;
+	}
+}
+
+void testSkeletonDataCache() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	Vector<Atlas *> atlases;
+	for (size_t i = 0; i < testData.size(); i++)
+		atlases.add(new(__FILE__, __LINE__) Atlas(testData[i]._atlas, NULL, "", false));
+
+	{
+		SkeletonDataCache cache;
+		TestData &data = testData[0];
+
+		/* One load for many acquires, the data matches a direct load. */
+		SkeletonData *skeletonData = cache.acquire(data._binarySkeleton, atlases[0]);
+		assert(skeletonData && cache.getLoadCount() == 1 && cache.getMemoryUsage() == skeletonData->getArena().getCapacity());
+		for (int i = 1; i < 200; i++) {
+			SkeletonData *acquired = cache.acquire(data._binarySkeleton, atlases[0]);
+			assert(acquired == skeletonData);
+			(void) acquired;
+		}
+		assert(cache.getLoadCount() == 1 && cache.getReferenceCount(skeletonData) == 200);
+		SkeletonBinary binary(atlases[0]);
+		SkeletonData *expected = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(poseEquals(expected, skeletonData));
+		delete expected;
+
+		/* The path, scale and atlas are the key, released data stays cached. */
+		SkeletonData *jsonData = cache.acquire(data._jsonSkeleton, atlases[0]);
+		SkeletonData *scaledData = cache.acquire(data._binarySkeleton, atlases[0], 0.5f);
+		assert(jsonData && scaledData && jsonData != skeletonData && scaledData != skeletonData && cache.getLoadCount() == 3);
+		assert(scaledData->getBones()[1]->getY() == skeletonData->getBones()[1]->getY() * 0.5f);
+		for (int i = 0; i < 200; i++)
+			cache.release(skeletonData);
+		assert(cache.getReferenceCount(skeletonData) == 0 && cache.size() == 3);
+		SkeletonData *acquired = cache.acquire(data._binarySkeleton, atlases[0]);
+		assert(acquired == skeletonData && cache.getLoadCount() == 3);
+		cache.release(acquired);
+
+		/* Failed loads are not cached. */
+		acquired = cache.acquire("testdata/missing.skel", atlases[0]);
+		assert(!acquired && !cache.getError().isEmpty() && cache.size() == 3);
+		cache.prefetch("testdata/missing.json", atlases[0]);
+		acquired = cache.acquire("testdata/missing.json", atlases[0]);
+		assert(!acquired && cache.size() == 3);
+
+		/* A failed prefetch nobody waits for is removed, the next acquire loads the file again. */
+		cache.prefetch("testdata/prefetched.json", atlases[0]);
+		for (int i = 0; i < 5000 && cache.size() > 3; i++)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		assert(cache.size() == 3);
+		int length;
+		char *json = SpineExtension::readFile(data._jsonSkeleton, &length);
+		FILE *file = fopen("testdata/prefetched.json", "wb");
+		fwrite(json, 1, length, file);
+		fclose(file);
+		SpineExtension::free(json, __FILE__, __LINE__);
+		acquired = cache.acquire("testdata/prefetched.json", atlases[0]);
+		remove("testdata/prefetched.json");
+		assert(acquired && cache.getLoadCount() == 4);
+		cache.release(acquired);
+
+		/* Eviction frees released data only, least recently released first. */
+		size_t memory = cache.getMemoryUsage();
+		cache.release(jsonData);
+		size_t evicted = cache.evict(0);
+		assert(evicted == memory - cache.getMemoryUsage() && cache.size() == 1);
+		assert(cache.getReferenceCount(scaledData) == 1);
+		cache.release(scaledData);
+		evicted = cache.evict(0);
+		assert(evicted > 0 && cache.size() == 0 && cache.getMemoryUsage() == 0);
+		(void) evicted;
+		cache.acquire(data._binarySkeleton, atlases[0]);
+		cache.acquire(data._jsonSkeleton, atlases[0]);
+		cache.setMemoryBudget(cache.getMemoryUsage());
+		skeletonData = cache.acquire(testData[1]._binarySkeleton, atlases[1]);
+		assert(cache.size() == 3);
+		cache.release(skeletonData);
+		assert(cache.size() == 2 && cache.getReferenceCount(skeletonData) == 0);
+	}
+
+	/* Threads acquiring the same files while others are prefetched load each file once. */
+	{
+		SkeletonDataCache cache;
+		for (size_t i = 0; i < testData.size(); i += 2)
+			cache.prefetch(testData[i]._binarySkeleton, atlases[i]);
+		auto acquireAll = [&cache, &testData, &atlases](int t) {
+			for (int repeat = 0; repeat < 20; repeat++) {
+				for (size_t i = 0; i < testData.size(); i++) {
+					size_t index = (i + t) % testData.size();
+					SkeletonData *skeletonData = cache.acquire(testData[index]._binarySkeleton, atlases[index]);
+					assert(skeletonData && skeletonData->getBones().size() > 0);
+					cache.release(skeletonData);
+				}
+			}
+		};
+#ifndef SPINE_NO_THREADS
+		std::thread threads[8];
+		for (int t = 0; t < 8; t++)
+			threads[t] = std::thread(acquireAll, t);
+		for (int t = 0; t < 8; t++)
+			threads[t].join();
+#else
+		/* Without thread support the cache is not synchronized. */
+		for (int t = 0; t < 8; t++)
+			acquireAll(t);
+#endif
+		printf("SkeletonDataCache: %zu loads for %d acquires, %zu KB\n", cache.getLoadCount(), 8 * 20 * (int) testData.size(),
+			   cache.getMemoryUsage() / 1024);
+		assert(cache.getLoadCount() == testData.size() && cache.size() == testData.size());
+
+		/* Destroying the cache waits for prefetches in progress. */
+		cache.prefetch(testData[0]._jsonSkeleton, atlases[0]);
+	}
+
+	for (size_t i = 0; i < atlases.size(); i++)
+		delete atlases[i];
+}
+
+void benchmarkSkeletonDataCache() {
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL, "", false);
+	const int count = 200;
+	Vector<Skeleton *> skeletons;
+	Vector<SkeletonData *> skeletonData;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	SkeletonBinary binary(atlas);
+	for (int i = 0; i < count; i++) {
+		skeletonData.add(binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel"));
+		skeletons.add(new(__FILE__, __LINE__) Skeleton(skeletonData[i]));
+	}
+	double loadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (int i = 0; i < count; i++) {
+		delete skeletons[i];
+		delete skeletonData[i];
+	}
+	skeletons.clear();
+	skeletonData.clear();
+
+	SkeletonDataCache cache;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < count; i++) {
+		skeletonData.add(cache.acquire("testdata/spineboy/spineboy-pro.skel", atlas));
+		skeletons.add(new(__FILE__, __LINE__) Skeleton(skeletonData[i]));
+	}
+	double cacheTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (int i = 0; i < count; i++) {
+		delete skeletons[i];
+		cache.release(skeletonData[i]);
+	}
+	printf("%d spineboy skeletons: loaded each %.2f ms, cached %.2f ms (%zu load, %zu KB)\n", count, loadTime * 1000,
+		   cacheTime * 1000, cache.getLoadCount(), cache.getMemoryUsage() / 1024);
+	cache.evict(0);
+	delete atlas;
+}
+
+void benchmarkJsonLoading() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		int length;
+		char *file = SpineExtension::readFile(data._jsonSkeleton, &length);
+		assert(file);
+		char *text = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+		memcpy(text, file, length);
+		text[length] = 0;
+		SpineExtension::free(file, __FILE__, __LINE__);
+
+		double parseTime = DBL_MAX, jsonTime = DBL_MAX, binaryTime = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			clock_t start = clock();
+			for (int ii = 0; ii < 10; ii++)
+				delete new(__FILE__, __LINE__) Json(text);
+			parseTime = MathUtil::min(parseTime, (double) (clock() - start) / CLOCKS_PER_SEC / 10);
+
+			SkeletonJson json(atlas);
+			start = clock();
+			for (int ii = 0; ii < 10; ii++)
+				delete json.readSkeletonData(text);
+			jsonTime = MathUtil::min(jsonTime, (double) (clock() - start) / CLOCKS_PER_SEC / 10);
+
+			SkeletonBinary binary(atlas);
+			start = clock();
+			for (int ii = 0; ii < 10; ii++)
+				delete binary.readSkeletonDataFile(data._binarySkeleton);
+			binaryTime = MathUtil::min(binaryTime, (double) (clock() - start) / CLOCKS_PER_SEC / 10);
+		}
+		printf("%s: %d KB, parsed in %.2f ms, loaded in %.2f ms, binary loaded in %.2f ms\n", data._jsonSkeleton.buffer(),
+			   length / 1024, parseTime * 1000, jsonTime * 1000, binaryTime * 1000);
+
+		SpineExtension::free(text, __FILE__, __LINE__);
+		delete atlas;
+	}
+}
+
+/* Appends an animation without timelines. If invalid is 1 it has a slot timeline of an unknown type, which skipAnimation() rejects.
+ * If invalid is 2 it has a deform timeline for a missing attachment, which is skipped but fails to decode. */
+void appendTestAnimation(Vector<unsigned char> &bytes, const char *name, int invalid) {
+	bytes.add((unsigned char) (strlen(name) + 1));
+	for (const char *c = name; *c; c++)
+		bytes.add((unsigned char) *c);
+	const unsigned char slotTimelines[] = {1, 0, 1, 9, 0}, deformTimelines[] = {1, 0, 1, 0, 1, 0, 0};
+	if (invalid == 1)
+		for (size_t i = 0; i < sizeof(slotTimelines); i++) bytes.add(slotTimelines[i]);
+	else
+		bytes.add(0);
+	for (int i = 0; i < 4; i++) // Bone, IK, transform and path constraint timelines.
+		bytes.add(0);
+	if (invalid == 2)
+		for (size_t i = 0; i < sizeof(deformTimelines); i++) bytes.add(deformTimelines[i]);
+	else
+		bytes.add(0);
+	bytes.add(0); // Draw order.
+	bytes.add(0); // Events.
+}
+
+void testAnimationThreads() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		for (int packed = 0; packed < 2; packed++) {
+			SkeletonBinary binary(atlas);
+			binary.setPackFrames(packed == 1);
+			binary.setQuantizeDeform(packed == 1);
+			SkeletonData *expected = binary.readSkeletonDataFile(data._binarySkeleton);
+			binary.setAnimationThreads(4);
+			SkeletonData *actual = binary.readSkeletonDataFile(data._binarySkeleton);
+			assert(expected && actual && actual->getAnimations().size() == expected->getAnimations().size());
+
+			/* Each animation is decoded by one thread the same way, so the poses are equal. */
+			Skeleton expectedSkeleton(expected), actualSkeleton(actual);
+			float maxMatrixError = 0, maxPositionError = 0, maxDeformError = 0;
+			for (size_t ii = 0; ii < expected->getAnimations().size(); ii++) {
+				Animation *expectedAnimation = expected->getAnimations()[ii], *actualAnimation = actual->getAnimations()[ii];
+				assert(actualAnimation->getName() == expectedAnimation->getName());
+				assert(actualAnimation->getDuration() == expectedAnimation->getDuration());
+				assert(actualAnimation->getTimelines().size() == expectedAnimation->getTimelines().size());
+				expectedSkeleton.setToSetupPose();
+				actualSkeleton.setToSetupPose();
+				for (float time = 0; time < expectedAnimation->getDuration() + 0.1f; time += 1 / 30.0f) {
+					expectedAnimation->apply(expectedSkeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					actualAnimation->apply(actualSkeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					expectedSkeleton.updateWorldTransform();
+					actualSkeleton.updateWorldTransform();
+					compareWorldTransforms(expectedSkeleton, actualSkeleton, maxMatrixError, maxPositionError);
+					for (size_t s = 0; s < expectedSkeleton.getSlots().size(); s++) {
+						Vector<float> &expectedDeform = expectedSkeleton.getSlots()[s]->getDeform();
+						Vector<float> &actualDeform = actualSkeleton.getSlots()[s]->getDeform();
+						assert(expectedDeform.size() == actualDeform.size());
+						for (size_t v = 0; v < expectedDeform.size(); v++)
+							maxDeformError = MathUtil::max(maxDeformError, MathUtil::abs(expectedDeform[v] - actualDeform[v]));
+					}
+				}
+			}
+			assert(maxMatrixError == 0 && maxPositionError == 0 && maxDeformError == 0);
+			if (packed == 0)
+				printf("%s: %zu animations decoded on 4 threads equal the sequential decoding\n", data._binarySkeleton.buffer(),
+					   actual->getAnimations().size());
+
+			delete expected;
+			delete actual;
+		}
+		delete atlas;
+	}
+
+	/* The skeleton data of spineboy followed by hand written animations, one of them invalid. */
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+	Vector<Animation *> animations;
+	animations.addAll(skeletonData->getAnimations());
+	skeletonData->getAnimations().clear();
+	Vector<unsigned char> prefix;
+	bool written = binary.writeSkeletonData(skeletonData, prefix);
+	skeletonData->getAnimations().addAll(animations);
+	assert(written && prefix[prefix.size() - 1] == 0);
+	(void) written;
+	prefix.setSize(prefix.size() - 1, 0); // The animation count.
+
+	String slotError("Invalid timeline type for a slot: ");
+	slotError.append(skeletonData->getSlots()[0]->getName());
+	const char *errors[] = {"", slotError.buffer(), "Attachment not found: "};
+	(void) errors;
+	const char *names[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+	for (int invalid = 0; invalid < 3; invalid++) {
+		Vector<unsigned char> bytes;
+		bytes.addAll(prefix);
+		bytes.add(8);
+		for (int ii = 0; ii < 8; ii++)
+			appendTestAnimation(bytes, names[ii], ii == 5 ? invalid : 0);
+		for (int threads = 1; threads <= 4; threads += 3) {
+			binary.setAnimationThreads(threads);
+			SkeletonData *actual = binary.readSkeletonData(bytes.buffer(), (int) bytes.size());
+			if (invalid == 0) {
+				assert(actual && actual->getAnimations().size() == 8 && actual->findAnimation("h"));
+				delete actual;
+			} else
+				assert(!actual && binary.getError() == errors[invalid]);
+		}
+	}
+
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkAnimationThreads() {
+	/* A large export: the animations of spineboy repeated 64 times. */
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	size_t count = animations.size();
+	for (int copy = 1; copy < 64; copy++) {
+		for (size_t i = 0; i < count; i++) {
+			Animation *animation = animations[i];
+			animations.add(animation);
+		}
+	}
+	Vector<unsigned char> bytes;
+	bool written = binary.writeSkeletonData(skeletonData, bytes);
+	assert(written);
+	(void) written;
+	printf("%zu animations, %zu KB:", animations.size(), bytes.size() / 1024);
+	animations.setSize(count, NULL);
+
+	/* Wall clock time, clock() adds up the time of all threads. */
+	int maxThreads = (int) std::thread::hardware_concurrency();
+	if (maxThreads < 4) maxThreads = 4;
+	double sequentialTime = 0;
+	for (int threads = 1; threads <= maxThreads; threads <<= 1) {
+		binary.setAnimationThreads(threads);
+		double seconds = DBL_MAX;
+		for (int repeat = 0; repeat < 5; repeat++) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			delete binary.readSkeletonData(bytes.buffer(), (int) bytes.size());
+			seconds = MathUtil::min(seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+		if (threads == 1) sequentialTime = seconds;
+		printf(" %d thread%s %.2f ms (%.2fx)", threads, threads == 1 ? "" : "s", seconds * 1000, sequentialTime / seconds);
+	}
+	printf(", %u hardware threads\n", std::thread::hardware_concurrency());
+
+	delete skeletonData;
+	delete atlas;
+}
+
+void testBakedAnimation() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+
+	const float frameRate = 30;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		printf("Comparing baked animations for %s\n", data._binarySkeleton.buffer());
+
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		Skeleton baked(skeletonData);
+		float maxError = 0, maxQuantizedError = 0, maxBetweenError = 0;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *animation = animations[ii];
+			BakedAnimation bakedAnimation(baked, *animation, frameRate);
+			BakedAnimation quantized(baked, *animation, frameRate, true);
+			assert(quantized.isQuantized() && !bakedAnimation.isQuantized());
+			assert(bakedAnimation.getFrameCount() >= animation->getDuration() * frameRate + 1);
+			assert(quantized.getMemorySize() <= bakedAnimation.getMemorySize());
+
+			skeleton.setToSetupPose();
+			baked.setToSetupPose();
+			size_t frameCount = bakedAnimation.getFrameCount();
+			float duration = animation->getDuration(), step = frameCount > 1 ? duration / (frameCount - 1) : 0;
+			for (size_t frame = 0; frame < frameCount; frame++) {
+				/* At the sampled times the baked pose is the live pose. */
+				float time = frameCount > 1 ? frame * duration / (frameCount - 1) : 0;
+				animation->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				bakedAnimation.apply(baked, time, false);
+				maxError = MathUtil::max(maxError, compareLocalTransforms(skeleton, baked));
+				quantized.apply(baked, time, false);
+				maxQuantizedError = MathUtil::max(maxQuantizedError, compareLocalTransforms(skeleton, baked));
+
+				/* Between them it is interpolated linearly. */
+				if (frame + 1 < frameCount) {
+					animation->apply(skeleton, time + step / 2, time + step / 2, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					bakedAnimation.apply(baked, time + step / 2, false);
+					maxBetweenError = MathUtil::max(maxBetweenError, compareLocalTransforms(skeleton, baked));
+				}
+			}
+		}
+		printf("Max error: %f, quantized %f, between frames %f\n", maxError, maxQuantizedError, maxBetweenError);
+		assert(maxError < 0.01f);
+		assert(maxQuantizedError < 0.1f);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void benchmarkBakedAnimation() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+
+	const int iterations = 20000;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		Animation *animation = skeletonData->findAnimation("walk");
+		assert(animation);
+		BakedAnimation baked(skeleton, *animation, 30);
+		BakedAnimation quantized(skeleton, *animation, 30, true);
+
+		/* The keyframes and curves of the bone timelines, which is what the baked frames replace. */
+		size_t liveMemory = 0;
+		Vector<Timeline *> &timelines = animation->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ii++) {
+			size_t entries = 0;
+			if (timelines[ii]->getRTTI().isExactly(RotateTimeline::rtti))
+				entries = RotateTimeline::ENTRIES;
+			else if (timelines[ii]->getRTTI().instanceOf(TranslateTimeline::rtti))
+				entries = TranslateTimeline::ENTRIES;
+			if (!entries) continue;
+			size_t frameCount = static_cast<CurveTimeline *>(timelines[ii])->getFrameCount();
+			liveMemory += (frameCount * entries + (frameCount - 1) * 19) * sizeof(float);
+		}
+
+		float step = 1 / 60.0f;
+		clock_t start = clock();
+		for (int ii = 0; ii < iterations; ii++)
+			animation->apply(skeleton, ii * step, ii * step, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		double live = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for (int ii = 0; ii < iterations; ii++)
+			baked.apply(skeleton, ii * step, true);
+		double bakedTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for (int ii = 0; ii < iterations; ii++)
+			quantized.apply(skeleton, ii * step, true);
+		double quantizedTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("%s walk: live %.3f us %zu bytes, baked %.3f us (%.2fx) %zu bytes, quantized %.3f us (%.2fx) %zu bytes per apply\n",
+			   data._binarySkeleton.buffer(), live * 1000000 / iterations, liveMemory, bakedTime * 1000000 / iterations,
+			   bakedTime > 0 ? live / bakedTime : 0, baked.getMemorySize(), quantizedTime * 1000000 / iterations,
+			   quantizedTime > 0 ? live / quantizedTime : 0, quantized.getMemorySize());
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Checks the commands of the renderer against the attachments of the skeleton, returns the number of commands. */
+size_t checkRenderCommands(SkeletonBatchRenderer &renderer, Skeleton &skeleton) {
+	Vector<RenderCommand> &commands = renderer.getCommands();
+	Vector<RenderVertex> &vertices = renderer.getVertices();
+	Vector<unsigned short> &indices = renderer.getIndices();
+	size_t vertexCount = 0, indexCount = 0;
+	for (size_t i = 0; i < commands.size(); i++) {
+		RenderCommand &command = commands[i];
+		assert(command.vertexStart == vertexCount && command.indexStart == indexCount);
+		vertexCount += command.vertexCount;
+		indexCount += command.indexCount;
+		for (size_t ii = 0; ii < command.indexCount; ii++)
+			assert(indices[command.indexStart + ii] < command.vertexCount);
+		if (i > 0) {
+			RenderCommand &previous = commands[i - 1];
+			assert(previous.texture != command.texture || previous.blendMode != command.blendMode ||
+				previous.vertexCount + command.vertexCount > 65536);
+		}
+	}
+	assert(vertexCount == vertices.size() && indexCount == indices.size());
+
+	/* Without clipping, the vertices are those of the visible region and mesh attachments in draw order. */
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	for (size_t i = 0; i < drawOrder.size(); i++) {
+		Attachment *attachment = drawOrder[i]->getAttachment();
+		if (attachment && attachment->getRTTI().isExactly(ClippingAttachment::rtti)) return commands.size();
+	}
+	Vector<float> worldVertices;
+	size_t vertex = 0;
+	for (size_t i = 0; i < drawOrder.size(); i++) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) continue;
+		Vector<float> *uvs;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+			if (region->getColor().a == 0) continue;
+			worldVertices.setSize(8, 0);
+			region->computeWorldVertices(slot.getBone(), worldVertices, 0, 2);
+			uvs = &region->getUVs();
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			if (mesh->getColor().a == 0) continue;
+			worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices, 0, 2);
+			uvs = &mesh->getUVs();
+		} else
+			continue;
+		for (size_t ii = 0; ii < worldVertices.size(); ii += 2, vertex++) {
+			RenderVertex &renderVertex = vertices[vertex];
+			assert(renderVertex.x == worldVertices[ii] && renderVertex.y == worldVertices[ii + 1]);
+			assert(renderVertex.u == (*uvs)[ii] && renderVertex.v == (*uvs)[ii + 1]);
+		}
+	}
+	assert(vertex == vertices.size());
+	return commands.size();
+}
+
+void testBatchRenderer(DebugExtension &debug) {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+	testData.add(TestData("testdata/tank/tank-pro.json", "testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"));
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		printf("Rendering %s\n", data._binarySkeleton.buffer());
+
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		if (skeletonData->findSkin("goblin")) skeleton.setSkin("goblin");
+		skeleton.setSlotsToSetupPose();
+		SkeletonBatchRenderer renderer;
+
+		/* Once the buffers have grown, rendering the same frames again does not allocate. The polygons pooled by the clipper
+		 * may take a few passes to grow to the sizes of an animated clipping attachment. */
+		size_t commandCount = 0, allocations = 1;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (int pass = 0; pass < 5 && allocations > 0; pass++) {
+			size_t before = debug.getAllocationCount() + debug.getReallocationCount();
+			for (size_t ii = 0; ii < animations.size(); ii++) {
+				for (float time = 0; time < animations[ii]->getDuration(); time += 0.1f) {
+					animations[ii]->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+					skeleton.updateWorldTransform();
+					renderer.render(skeleton);
+					if (pass == 0) commandCount += checkRenderCommands(renderer, skeleton);
+				}
+			}
+			if (pass > 0) allocations = debug.getAllocationCount() + debug.getReallocationCount() - before;
+		}
+		assert(allocations == 0);
+		assert(commandCount > 0);
+
+		skeleton.getColor().a = 0;
+		renderer.render(skeleton);
+		assert(renderer.getCommands().size() == 0 && renderer.getVertices().size() == 0);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void benchmarkBatchRenderer() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+
+	const int iterations = 10000;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		if (skeletonData->findSkin("goblin")) skeleton.setSkin("goblin");
+		skeleton.setSlotsToSetupPose();
+		skeletonData->getAnimations()[0]->apply(skeleton, 0, 0.5f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform();
+		SkeletonBatchRenderer renderer;
+
+		clock_t start = clock();
+		for (int ii = 0; ii < iterations; ii++)
+			renderer.render(skeleton);
+		double time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("%s: %zu commands, %zu vertices, %zu indices, %.3f us per render\n", data._binarySkeleton.buffer(),
+			   renderer.getCommands().size(), renderer.getVertices().size(), renderer.getIndices().size(),
+			   time * 1000000 / iterations);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+/* Returns the number of region and mesh attachments which would be rendered, and of those the number whose world vertices
+ * intersect the rectangle. */
+void countVisibleAttachments(Skeleton &skeleton, float x, float y, float width, float height, size_t &total,
+	size_t &intersecting) {
+	total = intersecting = 0;
+	Vector<float> worldVertices;
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	for (size_t i = 0; i < drawOrder.size(); i++) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) continue;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+			if (region->getColor().a == 0) continue;
+			worldVertices.setSize(8, 0);
+			region->computeWorldVertices(slot.getBone(), worldVertices, 0, 2);
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			if (mesh->getColor().a == 0) continue;
+			worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices, 0, 2);
+		} else
+			continue;
+		total++;
+		float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+		for (size_t ii = 0; ii < worldVertices.size(); ii += 2) {
+			minX = MathUtil::min(minX, worldVertices[ii]);
+			minY = MathUtil::min(minY, worldVertices[ii + 1]);
+			maxX = MathUtil::max(maxX, worldVertices[ii]);
+			maxY = MathUtil::max(maxY, worldVertices[ii + 1]);
+		}
+		if (minX <= x + width && maxX >= x && minY <= y + height && maxY >= y) intersecting++;
+	}
+}
+
+void testCulling() {
+	Vector<TestData> testData;
+	testData.add(TestData("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy-pro.skel",
+						  "testdata/spineboy/spineboy.atlas"));
+	testData.add(TestData("testdata/raptor/raptor-pro.json", "testdata/raptor/raptor-pro.skel",
+						  "testdata/raptor/raptor.atlas"));
+	testData.add(TestData("testdata/goblins/goblins-pro.json", "testdata/goblins/goblins-pro.skel",
+						  "testdata/goblins/goblins.atlas"));
+	testData.add(TestData("testdata/tank/tank-pro.json", "testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"));
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		if (skeletonData->findSkin("goblin")) skeleton.setSkin("goblin");
+		skeleton.setSlotsToSetupPose();
+		SkeletonBatchRenderer renderer;
+		Vector<float> boundsVertices;
+
+		size_t culledCount = 0, renderedCount = 0;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			for (float time = 0; time < animations[ii]->getDuration(); time += 0.1f) {
+				animations[ii]->apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.updateWorldTransform();
+				float x, y, width, height;
+				skeleton.getBounds(x, y, width, height, boundsVertices);
+
+				/* Culled attachments are those whose vertices are outside the rectangle, the bounds are conservative. */
+				size_t total, intersecting;
+				countVisibleAttachments(skeleton, x, y, width * 0.5f, height, total, intersecting);
+				renderer.setCullRectangle(x, y, width * 0.5f, height);
+				renderer.render(skeleton);
+				assert(renderer.getRenderedCount() + renderer.getCulledCount() == total);
+				assert(renderer.getRenderedCount() >= intersecting);
+				culledCount += renderer.getCulledCount();
+				renderedCount += renderer.getRenderedCount();
+
+				renderer.setCullRectangle(x + width + 100, y, 100, 100);
+				renderer.render(skeleton);
+				assert(total == 0 || renderer.isSkeletonCulled());
+				assert(renderer.getCulledCount() == total && renderer.getVertices().size() == 0);
+
+				renderer.clearCullRectangle();
+				renderer.render(skeleton);
+				assert(renderer.getRenderedCount() == total && renderer.getCulledCount() == 0);
+			}
+		}
+		printf("Culling %s: %zu attachments culled, %zu rendered\n", data._binarySkeleton.buffer(), culledCount,
+			   renderedCount);
+		assert(culledCount > 0);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void benchmarkCulling() {
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL, "", false);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+
+	/* A crowd of skeletons spread in a grid, of which the view shows a few. */
+	const int skeletonCount = 64, frames = 200;
+	Vector<Skeleton *> skeletons;
+	for (int i = 0; i < skeletonCount; i++) {
+		Skeleton *skeleton = new(__FILE__, __LINE__) Skeleton(skeletonData);
+		skeleton->setPosition((float) (i % 8) * 400, (float) (i / 8) * 600);
+		skeletonData->findAnimation("walk")->apply(*skeleton, 0, i * 0.1f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton->updateWorldTransform();
+		skeletons.add(skeleton);
+	}
+
+	SkeletonBatchRenderer renderer;
+	clock_t start = clock();
+	for (int frame = 0; frame < frames; frame++)
+		for (int i = 0; i < skeletonCount; i++)
+			renderer.render(*skeletons[i]);
+	double unculled = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	renderer.setCullRectangle(-200, -100, 1600, 1100);
+	size_t culled = 0, rendered = 0, skeletonsCulled = 0;
+	start = clock();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < skeletonCount; i++) {
+			renderer.render(*skeletons[i]);
+			culled += renderer.getCulledCount();
+			rendered += renderer.getRenderedCount();
+			if (renderer.isSkeletonCulled()) skeletonsCulled++;
+		}
+	}
+	double culledTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	printf("Culling %d spineboys: %.3f ms unculled, %.3f ms culled per frame (%.2fx), %zu skeletons and %zu of %zu attachments culled per frame\n",
+		   skeletonCount, unculled * 1000 / frames, culledTime * 1000 / frames, culledTime > 0 ? unculled / culledTime : 0,
+		   skeletonsCulled / frames, culled / frames, (culled + rendered) / frames);
+
+	for (int i = 0; i < skeletonCount; i++)
+		delete skeletons[i];
+	delete skeletonData;
+	delete atlas;
+}
+
+/* Changes the tracks of the state at random, without queuing more than one entry per track. */
+void randomTrackChange(AnimationState &state, SkeletonData &skeletonData, unsigned int &seed) {
+	seed = seed * 1103515245 + 12345;
+	size_t track = (seed >> 16) % 3;
+	seed = seed * 1103515245 + 12345;
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	Animation *animation = animations[(seed >> 16) % animations.size()];
+	float mix = ((seed >> 8) % 5) * 0.1f;
+	TrackEntry *current = state.getCurrent(track);
+	switch ((seed >> 4) % 5) {
+		case 0:
+		case 1:
+			state.setAnimation(track, animation, (seed & 1) != 0)->setMixDuration(mix);
+			break;
+		case 2:
+			if (current && !current->getNext()) state.addAnimation(track, animation, false, 0)->setMixDuration(mix);
+			break;
+		case 3:
+			if (track > 0) state.setEmptyAnimation(track, mix);
+			break;
+		default:
+			if (track > 0) state.clearTrack(track);
+	}
+}
+
+class CountingListener : public AnimationStateListenerObject {
+public:
+	CountingListener() : eventCount(0) {}
+
+	virtual void callback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
+		SP_UNUSED(state);
+		SP_UNUSED(type);
+		SP_UNUSED(entry);
+		SP_UNUSED(event);
+		eventCount++;
+	}
+
+	size_t eventCount;
+};
+
+/* Returns a pseudo random number from 0 to 1. */
+/* Checks that two skeletons have the same local pose, slot state and constraint mixes, without any tolerance. */
+bool localPoseEquals(Skeleton &expected, Skeleton &actual) {
+	for (size_t i = 0; i < expected.getBones().size(); i++) {
+		Bone &e = *expected.getBones()[i], &a = *actual.getBones()[i];
+		if (e.getX() != a.getX() || e.getY() != a.getY() || e.getRotation() != a.getRotation() || e.getScaleX() != a.getScaleX() ||
+			e.getScaleY() != a.getScaleY() || e.getShearX() != a.getShearX() || e.getShearY() != a.getShearY())
+			return false;
+	}
+	for (size_t i = 0; i < expected.getSlots().size(); i++) {
+		Slot &e = *expected.getSlots()[i], &a = *actual.getSlots()[i];
+		if (e.getAttachment() != a.getAttachment() || expected.getDrawOrder()[i]->getData().getIndex() !=
+			actual.getDrawOrder()[i]->getData().getIndex())
+			return false;
+		Color &ec = e.getColor(), &ac = a.getColor(), &ed = e.getDarkColor(), &ad = a.getDarkColor();
+		if (ec.r != ac.r || ec.g != ac.g || ec.b != ac.b || ec.a != ac.a || ed.r != ad.r || ed.g != ad.g || ed.b != ad.b)
+			return false;
+		if (e.getDeform().size() != a.getDeform().size()) return false;
+		for (size_t ii = 0; ii < e.getDeform().size(); ii++)
+			if (e.getDeform()[ii] != a.getDeform()[ii]) return false;
+	}
+	for (size_t i = 0; i < expected.getIkConstraints().size(); i++)
+		if (expected.getIkConstraints()[i]->getMix() != actual.getIkConstraints()[i]->getMix()) return false;
+	for (size_t i = 0; i < expected.getTransformConstraints().size(); i++)
+		if (expected.getTransformConstraints()[i]->getRotateMix() != actual.getTransformConstraints()[i]->getRotateMix()) return false;
+	for (size_t i = 0; i < expected.getPathConstraints().size(); i++) {
+		PathConstraint &e = *expected.getPathConstraints()[i], &a = *actual.getPathConstraints()[i];
+		if (e.getPosition() != a.getPosition() || e.getRotateMix() != a.getRotateMix()) return false;
+	}
+	return true;
+}
+
+/* Frame cursors are only a hint, lookups with them must give what the binary search gives for any playback and cursor. */
+void testFrameCursors() {
+	unsigned int seed = 11;
+
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+		Skeleton expected(skeletonData), actual(skeletonData);
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		int lookups = 0;
+
+		/* Rotate and translate timelines of the root bone with 2 to 40 random keys, for keys of 2 and 3 values. */
+		for (int keys = 2; keys <= 40; keys++) {
+			RotateTimeline rotate(keys);
+			TranslateTimeline translate(keys);
+			float end = 0;
+			for (int ii = 0; ii < keys; ii++) {
+				rotate.setFrame(ii, end, nextRandom(seed) * 360);
+				translate.setFrame(ii, end, nextRandom(seed) * 100, nextRandom(seed) * 100);
+				end += 0.01f + nextRandom(seed);
+			}
+			end -= 0.01f;
+			int rotateCursor = 0, translateCursor = 0;
+			float time = 0;
+			for (int ii = 0; ii < 200; ii++) {
+				float r = nextRandom(seed);
+				if (r < 0.8f) {
+					time += nextRandom(seed) * 0.3f;
+					if (time >= end) time = (time - end) * 0.5f;
+				} else if (r < 0.9f)
+					time = nextRandom(seed) * end;
+				else {
+					rotateCursor = (int) (nextRandom(seed) * (keys * 2 + 10)) - 5;
+					translateCursor = (int) (nextRandom(seed) * (keys * 3 + 10)) - 5;
+				}
+				expected.setToSetupPose();
+				actual.setToSetupPose();
+				rotate.apply(expected, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+				translate.apply(expected, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+				rotate.apply(actual, time, time, NULL, 1, MixBlend_Setup, MixDirection_In, rotateCursor);
+				translate.apply(actual, time, time, NULL, 1, MixBlend_Setup, MixDirection_In, translateCursor);
+				assert(localPoseEquals(expected, actual));
+				lookups++;
+			}
+		}
+
+		/* Each timeline with a cursor against the timelines without one, which binary search. */
+		Vector<Event *> expectedEvents, actualEvents;
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *animation = animations[ii];
+			Vector<Timeline *> &timelines = animation->getTimelines();
+			Vector<int> cursors;
+			cursors.setSize(timelines.size(), 0);
+			float duration = animation->getDuration(), time = 0;
+			for (int frame = 0; frame < 600; frame++) {
+				float lastTime = time, r = nextRandom(seed);
+				if (r < 0.85f) {
+					time += 1 / 60.0f;
+					if (time >= duration) time = duration > 0 ? MathUtil::fmod(time, duration) : 0;
+				} else if (r < 0.95f)
+					time = nextRandom(seed) * duration;
+				else {
+					for (size_t iii = 0; iii < cursors.size(); iii++)
+						cursors[iii] = (int) (nextRandom(seed) * 200) - 5;
+				}
+				expected.setToSetupPose();
+				actual.setToSetupPose();
+				expectedEvents.clear();
+				actualEvents.clear();
+				for (size_t iii = 0; iii < timelines.size(); iii++) {
+					timelines[iii]->apply(expected, lastTime, time, &expectedEvents, 1, MixBlend_Setup, MixDirection_In);
+					timelines[iii]->apply(actual, lastTime, time, &actualEvents, 1, MixBlend_Setup, MixDirection_In, cursors[iii]);
+				}
+				assert(localPoseEquals(expected, actual));
+				assert(expectedEvents.size() == actualEvents.size());
+				for (size_t iii = 0; iii < expectedEvents.size(); iii++)
+					assert(expectedEvents[iii] == actualEvents[iii]);
+				lookups++;
+			}
+		}
+
+		/* AnimationState keeps the cursors in its track entries, which are pooled and may be seeked with setTrackTime(). */
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		TrackEntry *entry = state.setAnimation(0, animations[0], true);
+		for (int frame = 0; frame < 3000; frame++) {
+			float r = nextRandom(seed);
+			if (r < 0.02f) {
+				state.clearTrack(0);
+				entry = state.setAnimation(0, animations[(size_t) (nextRandom(seed) * animations.size()) % animations.size()], true);
+			} else if (r < 0.1f)
+				entry->setTrackTime(nextRandom(seed) * entry->getAnimation()->getDuration() * 3);
+			state.update(1 / 60.0f);
+			actual.setToSetupPose();
+			state.apply(actual);
+			float time = entry->getAnimationTime();
+			expected.setToSetupPose();
+			/* The first track is applied with MixBlend_First. */
+			entry->getAnimation()->apply(expected, time, time, false, NULL, 1, MixBlend_First, MixDirection_In);
+			assert(localPoseEquals(expected, actual));
+			lookups++;
+		}
+		state.clearTracks();
+		printf("%s: %d poses with frame cursors equal the binary search\n", data._binarySkeleton.buffer(), lookups);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void benchmarkFrameCursors() {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+	const int frames = 600;
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+		Skeleton skeleton(skeletonData);
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+
+		/* Plays all animations forward at 60 fps, applying all timelines with and without cursors. */
+		double seconds[2];
+		int applies = 0;
+		for (int cursors = 0; cursors < 2; cursors++) {
+			seconds[cursors] = DBL_MAX;
+			for (int repeat = 0; repeat < 5; repeat++) {
+				applies = 0;
+				clock_t start = clock();
+				for (size_t ii = 0; ii < animations.size(); ii++) {
+					Vector<Timeline *> &timelines = animations[ii]->getTimelines();
+					Vector<int> frameCursors;
+					frameCursors.setSize(timelines.size(), 0);
+					float duration = animations[ii]->getDuration();
+					for (int frame = 0; frame < frames; frame++) {
+						float time = duration > 0 ? MathUtil::fmod(frame / 60.0f, duration) : 0;
+						for (size_t iii = 0; iii < timelines.size(); iii++) {
+							if (cursors == 1)
+								timelines[iii]->apply(skeleton, time, time, NULL, 1, MixBlend_Replace, MixDirection_In, frameCursors[iii]);
+							else
+								timelines[iii]->apply(skeleton, time, time, NULL, 1, MixBlend_Replace, MixDirection_In);
+						}
+						applies++;
+					}
+				}
+				seconds[cursors] = MathUtil::min(seconds[cursors], (double) (clock() - start) / CLOCKS_PER_SEC);
+			}
+		}
+		printf("%s: apply all timelines %.3f us, with frame cursors %.3f us (%.2fx)\n", data._binarySkeleton.buffer(),
+			   seconds[0] * 1000000 / applies, seconds[1] * 1000000 / applies, seconds[1] > 0 ? seconds[0] / seconds[1] : 0);
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+void testAnimationStateAllocations(DebugExtension &debug) {
+	Vector<TestData> testData;
+	addExampleExports(testData);
+
+	for (size_t i = 0; i < testData.size(); i++) {
+		TestData &data = testData[i];
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(data._atlas, NULL, "", false);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(data._binarySkeleton);
+		assert(skeletonData);
+
+		Skeleton skeleton(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		CountingListener listener;
+		state.setListener(&listener);
+		unsigned int seed = 7;
+
+		/* Warm up until the pools and buffers have grown to what the random changes need, then count the allocations. */
+		const int warmUpFrames = 20000, frames = 5000;
+		size_t allocations = 0;
+		for (int frame = 0; frame < warmUpFrames + frames; frame++) {
+			size_t before = debug.getAllocationCount() + debug.getReallocationCount();
+			if (frame % 20 == 0) randomTrackChange(state, *skeletonData, seed);
+			state.update(1 / 60.0f);
+			state.apply(skeleton);
+			skeleton.updateWorldTransform();
+			if (frame >= warmUpFrames) allocations += debug.getAllocationCount() + debug.getReallocationCount() - before;
+		}
+		printf("%s: %zu allocations in %d steady state frames, %zu events\n", data._binarySkeleton.buffer(), allocations,
+			   frames, listener.eventCount);
+		assert(allocations == 0);
+		state.clearTracks();
+
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
 namespace spine {
 	SpineExtension* getDefaultExtension() {
 		return new DefaultSpineExtension();
 	}
 }
 
+void testHashMap() {
+	HashMap<int, int> map;
+	Vector<int> values;
+	values.setSize(1000, -1);
+	unsigned int seed = 1;
+	for (int i = 0; i < 20000; i++) {
+		seed = seed * 1103515245 + 12345;
+		int key = (int) ((seed >> 8) % 1000);
+		/* Keys differing in their high bits only must not collide. */
+		int mappedKey = key << 20;
+		if ((seed >> 4) % 3 == 0) {
+			bool removed = map.remove(mappedKey);
+			assert(removed == (values[key] != -1));
+			(void) removed;
+			values[key] = -1;
+		} else {
+			map.put(mappedKey, i);
+			values[key] = i;
+		}
+	}
+
+	size_t size = 0;
+	for (int key = 0; key < 1000; key++) {
+		assert(map.containsKey(key << 20) == (values[key] != -1));
+		if (values[key] == -1) continue;
+		assert(map[key << 20] == values[key]);
+		size++;
+	}
+	assert(map.size() == size);
+
+	size_t visited = 0;
+	HashMap<int, int>::Entries entries = map.getEntries();
+	while (entries.hasNext()) {
+		HashMap<int, int>::Pair pair = entries.next();
+		assert(values[pair.key >> 20] == pair.value);
+		visited++;
+	}
+	assert(visited == size);
+
+	map.clear();
+	assert(map.size() == 0 && !map.containsKey(0));
+}
+
+void testNameIndex() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadJson("testdata/spineboy/spineboy-ess.json", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData,
+			 skeleton, state);
+
+	/* The indexed finds must agree with a linear search. */
+	Vector<BoneData *> &bones = skeletonData->getBones();
+	for (size_t i = 0; i < bones.size(); i++) {
+		const String &name = bones[i]->getName();
+		NameHandle handle = skeletonData->findName(name);
+		assert(handle.isValid());
+		assert(skeletonData->findBone(name) == ContainerUtil::findWithName(bones, name));
+		assert(skeletonData->findBone(handle) == bones[i]);
+		assert(skeleton->findBone(handle) == skeleton->getBones()[i]);
+		assert(skeleton->findBoneIndex(name) == (int) i);
+	}
+	Vector<SlotData *> &slots = skeletonData->getSlots();
+	for (size_t i = 0; i < slots.size(); i++) {
+		const String &name = slots[i]->getName();
+		assert(skeletonData->findSlotIndex(name) == ContainerUtil::findIndexWithName(slots, name));
+		assert(skeleton->findSlot(skeletonData->findName(name)) == skeleton->getSlots()[i]);
+	}
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	for (size_t i = 0; i < animations.size(); i++)
+		assert(skeletonData->findAnimation(skeletonData->findName(animations[i]->getName())) == animations[i]);
+
+	assert(!skeletonData->findName("not a name").isValid());
+	assert(skeletonData->findBone("not a name") == NULL);
+	assert(skeletonData->findAnimation(skeletonData->findName(bones[0]->getName())) == NULL);
+
+	/* Added items are found linearly until the names are indexed again. */
+	NameHandle handle = skeletonData->findName("walk");
+	Animation *animation = skeletonData->findAnimation(handle);
+	EventData *eventData = new (__FILE__, __LINE__) EventData("walk");
+	skeletonData->getEvents().add(eventData);
+	assert(skeletonData->findEvent(handle) == eventData);
+	assert(skeletonData->findAnimation(handle) == animation);
+	skeletonData->indexNames();
+	assert(skeletonData->findEvent(handle) == eventData);
+	assert(skeletonData->findEvent("walk") == eventData);
+	assert(skeletonData->findAnimation(handle) == animation);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+/* The linked list HashMap spine-cpp used before, to compare against. */
+template<typename K, typename V>
+class ListMap : public SpineObject {
+public:
+	ListMap() : _head(NULL) {}
+
+	~ListMap() {
+		for (Entry *entry = _head; entry != NULL;) {
+			Entry *next = entry->next;
+			delete entry;
+			entry = next;
+		}
+	}
+
+	void put(const K &key, const V &value) {
+		Entry *entry = find(key);
+		if (!entry) {
+			entry = new(__FILE__, __LINE__) Entry();
+			entry->next = _head;
+			_head = entry;
+		}
+		entry->key = key;
+		entry->value = value;
+	}
+
+	bool containsKey(const K &key) {
+		return find(key) != NULL;
+	}
+
+private:
+	class Entry : public SpineObject {
+	public:
+		K key;
+		V value;
+		Entry *next;
+	};
+
+	Entry *find(const K &key) {
+		for (Entry *entry = _head; entry != NULL; entry = entry->next)
+			if (entry->key == key) return entry;
+		return NULL;
+	}
+
+	Entry *_head;
+};
+
+template<typename M>
+void benchmarkMap(int keyCount, int lookups, double &insertTime, double &lookupTime) {
+	int rounds = keyCount < 20000 ? 20000 / keyCount : 1;
+	clock_t start = clock();
+	for (int round = 0; round < rounds; round++) {
+		M map;
+		for (int i = 0; i < keyCount; i++)
+			map.put(i * 7919, i);
+	}
+	insertTime = (double) (clock() - start) / CLOCKS_PER_SEC / rounds;
+
+	M map;
+	for (int i = 0; i < keyCount; i++)
+		map.put(i * 7919, i);
+
+	int found = 0;
+	start = clock();
+	for (int i = 0; i < lookups; i++)
+		if (map.containsKey((i % (keyCount * 2)) * 7919)) found++;
+	lookupTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+	assert(found == lookups / 2 || keyCount * 2 > lookups);
+}
+
+void benchmarkHashMap() {
+	const int keyCounts[] = { 10, 100, 1000, 10000 };
+	for (size_t i = 0; i < sizeof(keyCounts) / sizeof(keyCounts[0]); i++) {
+		int keyCount = keyCounts[i], lookups = keyCount < 1000 ? 200000 : 20000;
+		double listInsert, listLookup, hashInsert, hashLookup;
+		benchmarkMap<ListMap<int, int> >(keyCount, lookups, listInsert, listLookup);
+		benchmarkMap<HashMap<int, int> >(keyCount, lookups, hashInsert, hashLookup);
+		printf("%d keys: insert %.1f ns (linked list %.1f ns), lookup %.1f ns (linked list %.1f ns)\n", keyCount,
+			   hashInsert * 1000000000 / keyCount, listInsert * 1000000000 / keyCount, hashLookup * 1000000000 / lookups,
+			   listLookup * 1000000000 / lookups);
+	}
+}
+
 int main(int argc, char **argv) {
-	DebugExtension debug(SpineExtension::getInstance());
+	SpineExtension *extension = SpineExtension::getInstance();
+
+	/* Benchmarks are timed with the default extension, DebugExtension tracks every allocation under a lock. */
+	if (argc > 1 && !strcmp(argv[1], "--benchmark")) {
+		benchmarkWorldTransform();
+		benchmarkIncrementalUpdate();
+		benchmarkBakedAnimation();
+		benchmarkBatchRenderer();
+		benchmarkCulling();
+		benchmarkTimelineDispatch();
+		benchmarkPackedFrames();
+		benchmarkAtan2();
+		benchmarkFrameCursors();
+		benchmarkAttachmentKeys();
+		benchmarkJsonLoading();
+		benchmarkAnimationThreads();
+		benchmarkSkeletonDataCache();
+		benchmarkHashMap();
+		benchmarkSkinning();
+		return 0;
+	}
+
+	/* The empty animation used by AnimationState is a static that lives until exit, create it before tracking allocations. */
+	{
+		SkeletonData skeletonData;
+		AnimationStateData stateData(&skeletonData);
+		AnimationState state(&stateData);
+		state.setEmptyAnimation(0, 0);
+	}
+
+	DebugExtension debug(extension);
 	SpineExtension::setInstance(&debug);
 
 	testLoading();
+	testPoseStore();
+	testCurveLookup();
+	testArena(debug);
+	testArenaLinkedMeshError();
+	testMapFile();
+	testHashMap();
+	testNameIndex();
+	testBatchUpdater();
+	testInfluenceBuckets();
+	testSkinning();
+	testIncrementalUpdate();
+	testBakedAnimation();
+	testBatchRenderer(debug);
+	testCulling();
+	testFrameCursors();
+	testAnimationStateAllocations(debug);
+	testTimelineGroups();
+	testPackedFrames(debug);
+	testQuantizedDeform();
+	testAtan2();
+	testAttachmentKeys();
+	testJsonParser();
+	testBinaryWriter();
+	testAnimationThreads();
+	testSkeletonDataCache();
 
 	debug.reportLeaks();
+
+	/* Static RTTI instances are destroyed after main returns. */
+	SpineExtension::setInstance(extension);
 }
@@ -51,6 +51,8 @@ class SP_API Animation : public SpineObject {
 
 	friend class AnimationStateData;
 
+	friend class SkeletonBinary;
+
 	friend class AttachmentTimeline;
 
 	friend class ColorTimeline;
@@ -101,10 +103,13 @@ public:
 
 	void setDuration(float inValue);
 
-
+	/// The frames, curves and deform vertices of all timelines in one buffer, which the timelines' vectors are views of. Empty unless
+	/// the animation was read with SkeletonBinary::setPackFrames() enabled.
+	Vector<float> &getPackedFrames();
 
 private:
 	Vector<Timeline *> _timelines;
+	Vector<float> _packedFrames;
 	HashMap<int, bool> _timelineIds;
 	float _duration;
 	String _name;
@@ -115,6 +120,14 @@ private:
 	/// @param target After the first and before the last entry.
 	static int binarySearch(Vector<float> &values, float target);
 
+	/// Same result as binarySearch, but first checks the key at cursor and the one after it, then stores the key found in cursor.
+	/// The cursor is a key index rather than an entry index, so any value is a valid hint.
+	/// @param target After the first and before the last entry.
+	static int search(Vector<float> &values, float target, int step, int &cursor);
+
+	/// @param target After the first and before the last entry.
+	static int search(Vector<float> &values, float target, int &cursor);
+
 	static int linearSearch(Vector<float> &values, float target, int step);
 };
 }
@@ -33,6 +33,7 @@
 #include <spine/Vector.h>
 #include <spine/Pool.h>
 #include <spine/MixBlend.h>
+#include <spine/MixDirection.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <spine/HasRendererObject.h>
@@ -249,6 +250,9 @@ namespace spine {
 		Vector<int> _timelineMode;
 		Vector<TrackEntry*> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+		Vector<int> _frameCursors;
+		Vector<int> _timelineOrder;
+		Vector<int> _timelineRuns;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject* _listenerObject;
 
@@ -304,6 +308,8 @@ namespace spine {
 		friend class EventQueue;
 
 	public:
+		/// The per track entry buffers and the event buffer are sized for the largest animation of the skeleton data, so once the
+		/// track entry pool holds as many entries as are alive at once, updating and applying allocates no memory.
 		explicit AnimationState(AnimationStateData* data);
 
 		~AnimationState();
@@ -394,6 +400,7 @@ namespace spine {
 		Vector<TrackEntry*> _tracks;
 		Vector<Event*> _events;
 		EventQueue* _queue;
+		size_t _timelineCapacity;
 
 		HashMap<int, bool> _propertyIDs;
 		bool _animationsChanged;
@@ -407,8 +414,31 @@ namespace spine {
 
 		static Animation* getEmptyAnimation();
 
-		static void applyRotateTimeline(RotateTimeline* rotateTimeline, Skeleton& skeleton, float time, float alpha, MixBlend pose, Vector<float>& timelinesRotation, size_t i, bool firstFrame);
-        void applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float animationTime, MixBlend pose, bool firstFrame);
+		/// How applyTimelines() applies the timelines of an entry.
+		struct TimelineMix {
+			int mode;
+			float lastTime, time;
+			Vector<Event*>* events;
+			float alpha, alphaHold;
+			MixBlend blend;
+			MixDirection direction;
+			bool attachmentState, attachments, drawOrder, firstFrame;
+		};
+
+		/// Sorts the indices of the entry's timelines by timeline type into runs, so applyTimelines() can apply each type in a loop
+		/// without RTTI checks or virtual calls. Timelines of other classes are applied last, in their original order.
+		static void groupTimelines(TrackEntry* entry);
+
+		void applyTimelines(TrackEntry& entry, Skeleton& skeleton, TimelineMix& mix);
+
+		template<typename T>
+		void applyTimelineRun(TrackEntry& entry, Skeleton& skeleton, TimelineMix& mix, const int* order, int start, int end);
+
+		/// Computes the alpha and blend of the timeline at the index, adding the alpha to the entry's total when it's mixing out.
+		static void getTimelineMix(TrackEntry& entry, int index, TimelineMix& mix, float& alpha, MixBlend& blend);
+
+		static void applyRotateTimeline(RotateTimeline* rotateTimeline, Skeleton& skeleton, float time, float alpha, MixBlend pose, Vector<float>& timelinesRotation, size_t i, bool firstFrame, int& frameCursor);
+        void applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float animationTime, MixBlend pose, bool firstFrame, int& frameCursor);
 
 		/// Returns true when all mixing from entries are complete.
 		bool updateMixingFrom(TrackEntry* to, float delta);
@@ -433,7 +463,7 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
-        void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
+        void setAttachment(Skeleton &skeleton, spine::Slot &slot, int attachmentKey, const String &attachmentName, bool attachments);
     };
 }
 
@@ -74,6 +74,10 @@ namespace spine {
 			explicit AnimationPair(Animation* a1 = NULL, Animation* a2 = NULL);
 
 			bool operator==(const AnimationPair &other) const;
+
+			size_t hash() const;
+
+			friend size_t hashKey(const AnimationPair &pair) { return pair.hash(); }
 		};
 
 		SkeletonData* _skeletonData;
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_ArenaAllocator_h
+#define Spine_ArenaAllocator_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+/// Bump allocator serving all SpineExtension allocations made on a thread while it is the current arena of that thread, see
+/// ArenaScope. Memory is released all at once when the arena is destroyed: freeing an allocation only reclaims it if it is the
+/// most recent one. Only the current arena of the calling thread is checked for the memory SpineExtension frees or reallocates,
+/// so memory of an arena must only be freed or grown while it is current.
+///
+/// SkeletonData owns an arena which SkeletonBinary and SkeletonJson fill when SkeletonBinary::setUseArena() or
+/// SkeletonJson::setUseArena() is enabled, turning tens of thousands of small allocations into a few large blocks.
+class SP_API ArenaAllocator : public SpineObject {
+public:
+	/// @param blockSize The size of the first block, each further block doubles it up to 1 MB.
+	explicit ArenaAllocator(size_t blockSize = 64 * 1024);
+
+	~ArenaAllocator();
+
+	void *alloc(size_t size, bool clear);
+
+	/// Grows the most recent allocation in place if possible, otherwise copies the allocation.
+	void *realloc(void *ptr, size_t size);
+
+	void free(void *ptr);
+
+	/// Checks the blocks of this arena, which are few as each block doubles the size of the previous one.
+	bool owns(void *ptr);
+
+	/// Makes this arena the current arena of the calling thread until it is destroyed, so the destructor of its owner frees the
+	/// memory of the owner's members into it.
+	void enterUntilDestroyed();
+
+	/// The number of allocations this arena served.
+	size_t getAllocationCount();
+
+	size_t getBlockCount();
+
+	/// The bytes allocated from the blocks, including the size stored with each allocation.
+	size_t getUsedMemory();
+
+	/// The total size of the blocks.
+	size_t getCapacity();
+
+	/// @return May be NULL.
+	static ArenaAllocator *getCurrent();
+
+private:
+	friend class ArenaScope;
+
+	struct Block {
+		Block *next;
+		char *end;
+	};
+
+	Block *_blocks;
+	char *_top;
+	char *_end;
+	char *_last;
+	size_t _blockSize;
+	size_t _blockCount;
+	size_t _allocationCount;
+	size_t _capacity;
+	ArenaAllocator *_previous; // The current arena before enterUntilDestroyed().
+	bool _entered;
+
+	ArenaAllocator(const ArenaAllocator &);
+
+	ArenaAllocator &operator=(const ArenaAllocator &);
+
+	void addBlock(size_t size);
+
+	static void setCurrent(ArenaAllocator *arena);
+};
+
+/// Makes an arena the current arena of the calling thread until the scope ends. A NULL arena sends allocations to the
+/// SpineExtension heap, for memory which must outlive the arena.
+class SP_API ArenaScope : public SpineObject {
+public:
+	explicit ArenaScope(ArenaAllocator *arena);
+
+	~ArenaScope();
+
+private:
+	ArenaAllocator *_previous;
+};
+}
+
+#endif /* Spine_ArenaAllocator_h */
@@ -46,6 +46,7 @@ namespace spine {
 	class SP_API AttachmentTimeline : public Timeline {
 		friend class SkeletonBinary;
 		friend class SkeletonJson;
+		friend class SkeletonData;
 
 		RTTI_DECL
 
@@ -54,6 +55,8 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int &frameCursor);
+
 		virtual int getPropertyId();
 
 		/// Sets the time and value of the specified keyframe.
@@ -63,14 +66,16 @@ namespace spine {
 		void setSlotIndex(size_t inValue);
 		Vector<float>& getFrames();
 		Vector<String>& getAttachmentNames();
+		/// The key of each frame's attachment name, see SkeletonData::indexAttachments(). -1 if the name has no key, empty if the
+		/// timeline was not indexed.
+		Vector<int>& getAttachmentKeys();
 		size_t getFrameCount();
 	private:
 		size_t _slotIndex;
 		Vector<float> _frames;
 		Vector<String> _attachmentNames;
-
-        void setAttachment(Skeleton& skeleton, Slot& slot, String* attachmentName);
-    };
+		Vector<int> _attachmentKeys;
+	};
 }
 
 #endif /* Spine_AttachmentTimeline_h */
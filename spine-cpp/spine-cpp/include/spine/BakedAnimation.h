@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BakedAnimation_h
+#define Spine_BakedAnimation_h
+
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+class Animation;
+
+class Skeleton;
+
+class Bone;
+
+/// The bone timelines of an animation sampled at a fixed rate into local transforms, which apply() writes to the bones without
+/// evaluating timelines or curves. This trades memory for CPU time, for skeletons which don't need AnimationState mixing.
+///
+/// Only the bone components keyed by the animation are stored, and those which keep the same value in all frames are stored
+/// once. Attachment, color, deform, draw order, event and constraint timelines are not baked.
+class SP_API BakedAnimation : public SpineObject {
+public:
+	/// Samples the animation by applying it to the skeleton, whose bones are left in the setup pose.
+	/// @param frameRate The number of frames sampled per second. The frames are spread evenly over the animation's duration.
+	/// @param quantize If true, each sampled component is stored in 16 bits, scaled to the range of its values.
+	BakedAnimation(Skeleton &skeleton, Animation &animation, float frameRate, bool quantize = false);
+
+	/// Sets the keyed bone components to the pose at the specified time, interpolating linearly between the frames around it.
+	/// Corresponds to applying the bone timelines of the animation with MixBlend_Setup and an alpha of 1.
+	void apply(Skeleton &skeleton, float time, bool loop);
+
+	const String &getName();
+
+	float getDuration();
+
+	size_t getFrameCount();
+
+	bool isQuantized();
+
+	/// The number of bytes used by this object and its frames.
+	size_t getMemorySize();
+
+private:
+	String _name;
+	float _duration;
+	float _framesPerSecond;
+	size_t _frameCount;
+	bool _quantized;
+
+	/// Bone index * 7 + component, the components being x, y, rotation, scaleX, scaleY, shearX and shearY.
+	Vector<int> _constantChannels;
+	Vector<float> _constants;
+	Vector<int> _channels;
+
+	/// The value of each channel for each frame, frame major.
+	Vector<float> _frames;
+	Vector<unsigned short> _quantizedFrames;
+	Vector<float> _offsets;
+	Vector<float> _scales;
+
+	static float getComponent(Bone &bone, int component);
+
+	static void setComponent(Bone &bone, int component, float value);
+};
+}
+
+#endif /* Spine_BakedAnimation_h */
@@ -47,6 +47,8 @@ class Skeleton;
 class SP_API Bone : public Updatable {
 	friend class AnimationState;
 
+	friend class BakedAnimation;
+
 	friend class RotateTimeline;
 
 	friend class IkConstraint;
@@ -69,6 +71,8 @@ class SP_API Bone : public Updatable {
 
 	friend class TranslateTimeline;
 
+	friend class BonePoseStore;
+
 RTTI_DECL
 
 public:
@@ -49,6 +49,10 @@ public:
 	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 		MixDirection direction);
 
+	virtual void
+	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+		MixDirection direction, int &frameCursor);
+
 	virtual int getPropertyId();
 
 	/// Sets the time and value of the specified keyframe.
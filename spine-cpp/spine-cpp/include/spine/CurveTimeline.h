@@ -36,6 +36,8 @@
 namespace spine {
 	/// Base class for frames that use an interpolation bezier curve.
 	class SP_API CurveTimeline : public Timeline {
+		friend class SkeletonBinary;
+
 		RTTI_DECL
 
 	public:
@@ -58,8 +60,20 @@ namespace spine {
 		/// the difference between the keyframe's values.
 		void setCurve(size_t frameIndex, float cx1, float cy1, float cx2, float cy2);
 
+		/// Recovers the control handle positions of a bezier curve from its forward differences, within float precision. Setting
+		/// them with setCurve() gives the same curve up to rounding.
+		void getCurve(size_t frameIndex, float &cx1, float &cy1, float &cx2, float &cy2);
+
 		float getCurvePercent(size_t frameIndex, float percent);
 
+		/// Sets the number of segments of the lookup table used for bezier curves. With 0, the default, getCurvePercent() scans the
+		/// 10 forward differenced points of a curve. Otherwise those points are sampled at size + 1 evenly spaced percents and
+		/// getCurvePercent() interpolates the two samples around the percent in constant time. More segments are closer to the
+		/// forward differenced curve, each frame uses size + 1 floats.
+		void setCurveLookupSize(size_t size);
+
+		size_t getCurveLookupSize();
+
 		float getCurveType(size_t frameIndex);
 
 	protected:
@@ -70,6 +84,12 @@ namespace spine {
 
 	private:
 		Vector<float> _curves; // type, x, y, ...
+		Vector<float> _curveLookup;
+		size_t _curveLookupSize;
+
+		float scanCurve(size_t frameIndex, float percent);
+
+		void sampleCurve(size_t frameIndex);
 	};
 }
 
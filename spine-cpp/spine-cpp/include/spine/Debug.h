@@ -33,8 +33,11 @@
 #include <spine/Extension.h>
 
 #include <map>
+#include <stdio.h>
 
 namespace spine {
+class DebugExtensionSync;
+
 class SP_API DebugExtension : public SpineExtension {
 	struct Allocation {
 		void *address;
@@ -50,10 +53,12 @@ class SP_API DebugExtension : public SpineExtension {
 	};
 
 public:
-	DebugExtension(SpineExtension* extension): _extension(extension), _allocations(0), _reallocations(0), _frees(0) {
-	}
+	DebugExtension(SpineExtension* extension);
+
+	virtual ~DebugExtension();
 
 	void reportLeaks() {
+		Lock lock(*this);
 		for (std::map<void*, Allocation>::iterator it = _allocated.begin(); it != _allocated.end(); it++) {
 			printf("\"%s:%i (%zu bytes at %p)\n", it->second.fileName, it->second.line, it->second.size, it->second.address);
 		}
@@ -62,11 +67,13 @@ public:
 	}
 
 	void clearAllocations() {
+		Lock lock(*this);
 		_allocated.clear();
 		_usedMemory = 0;
 	}
 
 	virtual void *_alloc(size_t size, const char *file, int line) {
+		Lock lock(*this);
 		void *result = _extension->_alloc(size, file, line);
 		_allocated[result] = Allocation(result, size, file, line);
 		_allocations++;
@@ -75,6 +82,7 @@ public:
 	}
 
 	virtual void *_calloc(size_t size, const char *file, int line) {
+		Lock lock(*this);
 		void *result = _extension->_calloc(size, file, line);
 		_allocated[result] = Allocation(result, size, file, line);
 		_allocations++;
@@ -83,6 +91,7 @@ public:
 	}
 
 	virtual void *_realloc(void *ptr, size_t size, const char *file, int line) {
+		Lock lock(*this);
 		if (_allocated.count(ptr)) _usedMemory -= _allocated[ptr].size;
 		_allocated.erase(ptr);
 		void *result = _extension->_realloc(ptr, size, file, line);
@@ -93,6 +102,7 @@ public:
 	}
 
 	virtual void _free(void *mem, const char *file, int line) {
+		Lock lock(*this);
 		if (_allocated.count(mem)) {
 			_extension->_free(mem, file, line);
 			_frees++;
@@ -108,18 +118,62 @@ public:
 	virtual char *_readFile(const String &path, int *length) {
 		return _extension->_readFile(path, length);
 	}
+
+	virtual const char *_mapFile(const String &path, int *length) {
+		return _extension->_mapFile(path, length);
+	}
+
+	virtual void _unmapFile(const char *data, int length) {
+		_extension->_unmapFile(data, length);
+	}
 	
 	size_t getUsedMemory() {
+		Lock lock(*this);
 		return _usedMemory;
 	}
 
+	size_t getAllocationCount() {
+		Lock lock(*this);
+		return _allocations;
+	}
+
+	size_t getReallocationCount() {
+		Lock lock(*this);
+		return _reallocations;
+	}
+
+	size_t getFreeCount() {
+		Lock lock(*this);
+		return _frees;
+	}
+
 private:
+	/// Holds the lock of the allocation tracking until the scope ends.
+	class Lock {
+	public:
+		explicit Lock(DebugExtension &extension) : _extension(extension) {
+			_extension.lock();
+		}
+
+		~Lock() {
+			_extension.unlock();
+		}
+
+	private:
+		DebugExtension &_extension;
+	};
+
 	SpineExtension* _extension;
 	std::map<void*, Allocation> _allocated;
 	size_t _allocations;
 	size_t _reallocations;
 	size_t _frees;
 	size_t _usedMemory;
+	DebugExtensionSync *_sync;
+
+	void lock();
+
+	void unlock();
 };
 }
 
@@ -46,6 +46,8 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int &frameCursor);
+
 		virtual int getPropertyId();
 
 		/// Sets the time and value of the specified keyframe.
@@ -54,14 +56,32 @@ namespace spine {
 		int getSlotIndex();
 		void setSlotIndex(int inValue);
 		Vector<float>& getFrames();
+		/// The vertices of each frame. Empty after quantizeVertices().
 		Vector< Vector<float> >& getVertices();
 		VertexAttachment* getAttachment();
 		void setAttachment(VertexAttachment* inValue);
 
+		/// Replaces the vertices of all frames by 16 bit values spanning the range of the timeline's vertices, halving their memory.
+		/// apply() decodes the values while interpolating. The error of each vertex is at most the range divided by 131070. Does
+		/// nothing if the frames have different vertex counts. setFrame() must not be called afterward.
+		void quantizeVertices();
+
+		bool isQuantized();
+
+		/// The quantized vertices of all frames, one after the other, see quantizeVertices().
+		Vector<unsigned short>& getQuantizedVertices();
+
+		/// Decoding a quantized vertex value v is getQuantizedOffset() + v * getQuantizedScale().
+		float getQuantizedOffset();
+
+		float getQuantizedScale();
+
 	private:
 		int _slotIndex;
 		Vector<float> _frames;
 		Vector< Vector<float> > _frameVertices;
+		Vector<unsigned short> _quantizedVertices;
+		float _quantizedOffset, _quantizedScale;
 		VertexAttachment* _attachment;
 	};
 }
@@ -43,22 +43,22 @@ class SP_API SpineExtension {
 public:
 	template<typename T>
 	static T *alloc(size_t num, const char *file, int line) {
-		return (T *) getInstance()->_alloc(sizeof(T) * num, file, line);
+		return (T *) allocate(sizeof(T) * num, false, file, line);
 	}
 
 	template<typename T>
 	static T *calloc(size_t num, const char *file, int line) {
-		return (T *) getInstance()->_calloc(sizeof(T) * num, file, line);
+		return (T *) allocate(sizeof(T) * num, true, file, line);
 	}
 
 	template<typename T>
 	static T *realloc(T *ptr, size_t num, const char *file, int line) {
-		return (T *) getInstance()->_realloc(ptr, sizeof(T) * num, file, line);
+		return (T *) reallocate((void *) ptr, sizeof(T) * num, file, line);
 	}
 
 	template<typename T>
 	static void free(T *ptr, const char *file, int line) {
-		getInstance()->_free((void *) ptr, file, line);
+		deallocate((void *) ptr, file, line);
 	}
 
 	template<typename T>
@@ -70,6 +70,15 @@ public:
 		return getInstance()->_readFile(path, length);
 	}
 
+	/// Returns the contents of a file for reading only, which must be released with unmapFile().
+	static const char *mapFile(const String &path, int *length) {
+		return getInstance()->_mapFile(path, length);
+	}
+
+	static void unmapFile(const char *data, int length) {
+		getInstance()->_unmapFile(data, length);
+	}
+
 	static void setInstance(SpineExtension *inSpineExtension);
 
 	static SpineExtension *getInstance();
@@ -88,6 +97,11 @@ public:
 
 	virtual char *_readFile(const String &path, int *length) = 0;
 
+	/// Implement this function to map files into memory instead of reading them. Reads the file with _readFile() by default.
+	virtual const char *_mapFile(const String &path, int *length);
+
+	virtual void _unmapFile(const char *data, int length);
+
 	virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
 protected:
@@ -95,6 +109,13 @@ protected:
 
 private:
 	static SpineExtension *_instance;
+
+	/// Serves allocations from the current ArenaAllocator of the calling thread, if any.
+	static void *allocate(size_t size, bool clear, const char *file, int line);
+
+	static void *reallocate(void *ptr, size_t size, const char *file, int line);
+
+	static void deallocate(void *ptr, const char *file, int line);
 };
 
 class SP_API DefaultSpineExtension : public SpineExtension {
@@ -115,6 +136,20 @@ protected:
 	virtual char *_readFile(const String &path, int *length);
 };
 
+/// Maps files with mmap instead of reading them with _readFile(), except on Windows or if SPINE_NO_MMAP is defined. Extensions
+/// which read files from somewhere else than the file system, like an asset package, must not derive from it.
+class SP_API MappedFileExtension : public DefaultSpineExtension {
+public:
+	MappedFileExtension();
+
+	virtual ~MappedFileExtension();
+
+protected:
+	virtual const char *_mapFile(const String &path, int *length);
+
+	virtual void _unmapFile(const char *data, int length);
+};
+
 // This function is to be implemented by engine specific runtimes to provide
 // the default extension for that engine. It is called the first time
 // SpineExtension::getInstance() is called, when no instance has been set
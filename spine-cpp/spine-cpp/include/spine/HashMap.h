@@ -40,6 +40,37 @@
 #endif
 
 namespace spine {
+/// Hashes for HashMap keys. Other key types provide an overload found through argument dependent lookup, usually a friend
+/// function of the key class.
+inline size_t hashKey(unsigned int key) {
+	// Finalizer of MurmurHash3, so keys differing only in their high bits land in different buckets.
+	key ^= key >> 16;
+	key *= 0x85ebca6b;
+	key ^= key >> 13;
+	key *= 0xc2b2ae35;
+	key ^= key >> 16;
+	return key;
+}
+
+inline size_t hashKey(int key) {
+	return hashKey((unsigned int) key);
+}
+
+inline size_t hashKey(const void *key) {
+	size_t value = (size_t) key;
+	return hashKey((unsigned int) (value >> 3) ^ (unsigned int) (value >> 16 >> 16));
+}
+
+inline size_t hashKey(const String &key) {
+	// FNV-1a.
+	unsigned int hash = 2166136261u;
+	const char *chars = key.buffer();
+	for (size_t i = 0, n = key.length(); i < n; i++)
+		hash = (hash ^ (unsigned char) chars[i]) * 16777619u;
+	return hash;
+}
+
+/// Hash table with open addressing and linear probing, storing its entries in one contiguous array.
 template<typename K, typename V>
 class SP_API HashMap : public SpineObject {
 private:
@@ -58,47 +89,53 @@ public:
 	public:
 		friend class HashMap;
 
-		explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-			_start.next = entry;
-			_entry = &_start;
+		explicit Entries(Entry *entries, size_t capacity) : _entries(entries), _capacity(capacity), _index(0), _next(0),
+			_hasChecked(false) {
 		}
 
 		Pair next() {
-			assert(_entry);
 			assert(_hasChecked);
-			_entry = _entry->next;
-			Pair pair(_entry->_key, _entry->_value);
+			assert(_next < _capacity);
+			_index = _next++;
 			_hasChecked = false;
-			return pair;
+			return Pair(_entries[_index]._key, _entries[_index]._value);
 		}
 
 		bool hasNext() {
 			_hasChecked = true;
-			return _entry->next;
+			while (_next < _capacity && !_entries[_next]._used)
+				_next++;
+			return _next < _capacity;
 		}
 
 	private:
+		Entry *_entries;
+		size_t _capacity;
+		size_t _index;
+		size_t _next;
 		bool _hasChecked;
-		Entry _start;
-		Entry *_entry;
 	};
 
 	HashMap() :
-			_head(NULL),
+			_entries(NULL),
+			_capacity(0),
 			_size(0) {
 	}
 
 	~HashMap() {
 		clear();
+		if (_entries) {
+			for (size_t i = 0; i < _capacity; i++)
+				_entries[i].~Entry();
+			SpineExtension::free(_entries, __FILE__, __LINE__);
+		}
 	}
 
+	/// Removes all entries, keeping the table allocated.
 	void clear() {
-		for (Entry *entry = _head; entry != NULL;) {
-			Entry* next = entry->next;
-			delete entry;
-			entry = next;
+		for (size_t i = 0; i < _capacity; i++) {
+			if (_entries[i]._used) _entries[i].reset();
 		}
-		_head = NULL;
 		_size = 0;
 	}
 
@@ -107,51 +144,47 @@ public:
 	}
 
 	void put(const K &key, const V &value) {
-		Entry *entry = find(key);
-		if (entry) {
-			entry->_key = key;
-			entry->_value = value;
-		} else {
-			entry = new(__FILE__, __LINE__) Entry();
-			entry->_key = key;
-			entry->_value = value;
-
-			Entry *oldHead = _head;
-
-			if (oldHead) {
-				_head = entry;
-				oldHead->prev = entry;
-				entry->next = oldHead;
-			} else {
-				_head = entry;
-			}
+		size_t hash = hashKey(key);
+		Entry *entry = find(key, hash);
+		if (!entry) {
+			if ((_size + 1) * 4 > _capacity * 3) grow();
+			entry = &_entries[hash & (_capacity - 1)];
+			while (entry->_used)
+				entry = next(entry);
+			entry->_used = true;
+			entry->_hash = hash;
 			_size++;
 		}
+		entry->_key = key;
+		entry->_value = value;
 	}
 
 	bool containsKey(const K &key) {
-		return find(key) != NULL;
+		return find(key, hashKey(key)) != NULL;
 	}
 
 	bool remove(const K &key) {
-		Entry *entry = find(key);
+		Entry *entry = find(key, hashKey(key));
 		if (!entry) return false;
 
-		Entry *prev = entry->prev;
-		Entry *next = entry->next;
-
-		if (prev) prev->next = next;
-		else _head = next;
-		if (next) next->prev = entry->prev;
-
-		delete entry;
+		// Shift the following entries of the probe sequence back, so lookups never need to skip removed entries.
+		size_t mask = _capacity - 1, hole = entry - _entries;
+		for (size_t i = (hole + 1) & mask; _entries[i]._used; i = (i + 1) & mask) {
+			size_t home = _entries[i]._hash & mask;
+			if (((i - home) & mask) < ((i - hole) & mask)) continue;
+			_entries[hole]._key = _entries[i]._key;
+			_entries[hole]._value = _entries[i]._value;
+			_entries[hole]._hash = _entries[i]._hash;
+			hole = i;
+		}
+		_entries[hole].reset();
 		_size--;
 
 		return true;
 	}
 
 	V operator[](const K &key) {
-		Entry *entry = find(key);
+		Entry *entry = find(key, hashKey(key));
 		if (entry) return entry->_value;
 		else {
 			assert(false);
@@ -160,29 +193,67 @@ public:
 	}
 
 	Entries getEntries() const {
-		return Entries(_head);
+		return Entries(_entries, _capacity);
 	}
 
 private:
-	Entry *find(const K &key) {
-		for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-			if (entry->_key == key)
+	Entry *find(const K &key, size_t hash) {
+		if (_size == 0) return NULL;
+		for (Entry *entry = &_entries[hash & (_capacity - 1)]; entry->_used; entry = next(entry)) {
+			if (entry->_hash == hash && entry->_key == key)
 				return entry;
 		}
 		return NULL;
 	}
 
-	class SP_API Entry : public SpineObject {
+	Entry *next(Entry *entry) {
+		return ++entry == _entries + _capacity ? _entries : entry;
+	}
+
+	void grow() {
+		Entry *oldEntries = _entries;
+		size_t oldCapacity = _capacity;
+
+		_capacity = _capacity ? _capacity << 1 : 8;
+		_entries = SpineExtension::alloc<Entry>(_capacity, __FILE__, __LINE__);
+		for (size_t i = 0; i < _capacity; i++)
+			new(_entries + i) Entry();
+
+		size_t mask = _capacity - 1;
+		for (size_t i = 0; i < oldCapacity; i++) {
+			Entry &oldEntry = oldEntries[i];
+			if (oldEntry._used) {
+				Entry *entry = &_entries[oldEntry._hash & mask];
+				while (entry->_used)
+					entry = next(entry);
+				entry->_key = oldEntry._key;
+				entry->_value = oldEntry._value;
+				entry->_hash = oldEntry._hash;
+				entry->_used = true;
+			}
+			oldEntry.~Entry();
+		}
+		if (oldEntries) SpineExtension::free(oldEntries, __FILE__, __LINE__);
+	}
+
+	class SP_API Entry {
 	public:
 		K _key;
 		V _value;
-		Entry *next;
-		Entry *prev;
+		size_t _hash;
+		bool _used;
 
-		Entry() : next(NULL), prev(NULL) {}
+		Entry() : _key(), _value(), _hash(0), _used(false) {}
+
+		void reset() {
+			_key = K();
+			_value = V();
+			_used = false;
+		}
 	};
 
-	Entry *_head;
+	Entry *_entries;
+	size_t _capacity;
 	size_t _size;
 };
 }
@@ -47,6 +47,8 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction, int &frameCursor);
+
 		virtual int getPropertyId();
 
 		/// Sets the time, mix and bend direction of the specified keyframe.
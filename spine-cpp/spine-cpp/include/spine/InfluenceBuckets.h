@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_InfluenceBuckets_h
+#define Spine_InfluenceBuckets_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+/// The weighted vertices of a VertexAttachment regrouped by their number of bone influences, so they can be skinned with fixed
+/// width loops and without walking the variable length stream of VertexAttachment::getBones(). Vertices with 1 to 4 influences
+/// are stored in the bucket of that width. Vertices with more influences are stored in the last bucket, padded with zero weights
+/// to the largest influence count.
+///
+/// The vertices of a bucket are stored in groups of 4. For each influence, a group stores the values of its 4 vertices next to
+/// each other, so one influence of 4 vertices is loaded into one SIMD register. The last group is padded with vertices that have
+/// no weight and a remap of -1.
+///
+/// The buckets are built from the attachment's bones and vertices and are not updated when those change.
+class SP_API InfluenceBuckets : public SpineObject {
+public:
+	static const int BucketCount = 5;
+
+	/// @param bones The bone stream of a weighted attachment, see VertexAttachment::getBones().
+	/// @param vertices The x, y and weight of each influence, see VertexAttachment::getVertices().
+	InfluenceBuckets(Vector<size_t> &bones, Vector<float> &vertices);
+
+	/// The number of influences of each vertex in the bucket.
+	size_t getWidth(int bucket);
+
+	/// The number of vertices in the bucket, without the padding.
+	size_t getVertexCount(int bucket);
+
+	/// The bone index of each influence, 4 * width entries per group.
+	Vector<int> &getBones(int bucket);
+
+	/// The x of the 4 vertices, then their y, then their weight, for each influence. 12 * width entries per group.
+	Vector<float> &getVertices(int bucket);
+
+	/// The index of each influence in the stream of the attachment, 4 * width entries per group. Deform values have 2 entries per
+	/// influence in stream order, see Slot::getDeform().
+	Vector<int> &getInfluences(int bucket);
+
+	/// The index of each vertex in the attachment, 4 entries per group.
+	Vector<int> &getRemap(int bucket);
+
+private:
+	struct Bucket {
+		size_t width;
+		size_t vertexCount;
+		Vector<int> bones;
+		Vector<float> vertices;
+		Vector<int> influences;
+		Vector<int> remap;
+	};
+
+	Bucket _buckets[BucketCount];
+};
+}
+
+#endif /* Spine_InfluenceBuckets_h */
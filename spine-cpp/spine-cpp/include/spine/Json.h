@@ -51,7 +51,7 @@ public:
 	static const int JSON_ARRAY;
 	static const int JSON_OBJECT;
 
-	/* Get item "string" from object. Case insensitive. */
+	/* Get item "string" from object. Case insensitive, the names are compared by their hash first. */
 	static Json *getItem(Json *object, const char *string);
 
 	static const char *getString(Json *object, const char *name, const char *defaultValue);
@@ -65,14 +65,15 @@ public:
 	/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
 	static const char *getError();
 
-	/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
+	/* Supply a block of JSON, and this returns a Json object you can interrogate. Delete it when finished. The items and strings
+	 * are allocated in blocks owned by the returned object, which frees them all at once. */
 	explicit Json(const char *value);
 
 	~Json();
 
-
-
 private:
+	struct Block;
+
 	static const char *_error;
 
 	Json *_next;
@@ -89,26 +90,38 @@ private:
 	float _valueFloat; /* The item's number, if type==JSON_NUMBER */
 
 	const char *_name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+	unsigned int _nameHash; /* The hash of the item's name, see hash(). */
+
+	Block *_blocks; /* The memory of the items and strings, owned by the root item. */
+	size_t _blockSize; /* The size of the next block. */
+
+	/* Allocates from the blocks of the root item. */
+	void *allocate(size_t size);
+
+	/* Allocates an item from the blocks of the root item. */
+	Json *newItem();
+
+	static unsigned int hash(const char *string);
+
+	static int json_strcasecmp(const char *s1, const char *s2);
 
 	/* Utility to jump whitespace and cr/lf */
 	static const char *skip(const char *inValue);
 
 	/* Parser core - when encountering text, process appropriately. */
-	static const char *parseValue(Json *item, const char *value);
+	const char *parseValue(Json *item, const char *value);
 
 	/* Parse the input text into an unescaped cstring, and populate item. */
-	static const char *parseString(Json *item, const char *str);
+	const char *parseString(Json *item, const char *str);
 
 	/* Parse the input text to generate a number, and populate the result into item. */
 	static const char *parseNumber(Json *item, const char *num);
 
 	/* Build an array from input text. */
-	static const char *parseArray(Json *item, const char *value);
+	const char *parseArray(Json *item, const char *value);
 
 	/* Build an object from the text. */
-	static const char *parseObject(Json *item, const char *value);
-
-	static int json_strcasecmp(const char *s1, const char *s2);
+	const char *parseObject(Json *item, const char *value);
 };
 }
 
@@ -35,6 +35,8 @@
 #include <spine/ContainerUtil.h>
 #include <spine/SpineObject.h>
 
+#include <assert.h>
+
 namespace spine {
 template<typename T>
 class SP_API Pool : public SpineObject {
@@ -60,10 +62,10 @@ public:
 		}
 	}
 
+	/// The object must not already be in the pool. Freeing an object twice is only detected in debug builds.
 	void free(T *object) {
-		if (!_objects.contains(object)) {
-			_objects.add(object);
-		}
+		assert(!_objects.contains(object));
+		_objects.add(object);
 	}
 
 private:
@@ -39,10 +39,14 @@
 namespace spine {
 class SkeletonData;
 
+class NameHandle;
+
 class Bone;
 
 class Updatable;
 
+class BonePoseStore;
+
 class Slot;
 
 class IkConstraint;
@@ -90,8 +94,18 @@ class SP_API Skeleton : public SpineObject {
 
 	friend class TwoColorTimeline;
 
+	friend class Bone;
+
+	friend class VertexAttachment;
+
+	friend class TransformConstraint;
+
+	friend class PathConstraint;
+
 public:
-	explicit Skeleton(SkeletonData *skeletonData);
+	/// @param usePoseStore If true, the world transforms of bones using TransformMode_Normal are computed by a BonePoseStore owned by
+	/// the skeleton, see getPoseStore().
+	explicit Skeleton(SkeletonData *skeletonData, bool usePoseStore = false);
 
 	~Skeleton();
 
@@ -104,6 +118,14 @@ public:
 	/// Updates the world transform for each bone and applies constraints.
 	void updateWorldTransform();
 
+	/// If true, updateWorldTransform() only recomputes the bones whose local transform changed since the previous update, their
+	/// descendants and the constraints affected by them. Path constraints are always applied. Everything is recomputed when more
+	/// than half of the bones changed or the skeleton's position or scale changed. World transforms must then only be modified
+	/// by updateWorldTransform(). Default is false.
+	void setIncrementalUpdate(bool incrementalUpdate);
+
+	bool getIncrementalUpdate();
+
 	/// Sets the bones, constraints, and slots to their setup pose values.
 	void setToSetupPose();
 
@@ -124,6 +146,18 @@ public:
 	/// @return -1 if the bone was not found.
 	int findSlotIndex(const String &slotName);
 
+	/// @return May be NULL.
+	Bone *findBone(const NameHandle &boneName);
+
+	/// @return -1 if the bone was not found.
+	int findBoneIndex(const NameHandle &boneName);
+
+	/// @return May be NULL.
+	Slot *findSlot(const NameHandle &slotName);
+
+	/// @return -1 if the slot was not found.
+	int findSlotIndex(const NameHandle &slotName);
+
 	/// Sets a skin by name (see setSkin).
 	void setSkin(const String &skinName);
 
@@ -142,6 +176,12 @@ public:
 	/// @return May be NULL.
 	Attachment *getAttachment(int slotIndex, const String &attachmentName);
 
+	/// Returns the attachment for an attachment key, see SkeletonData::indexAttachments(). Keyed attachments are found in a
+	/// table resolved from the skin and default skin when they change, instead of comparing names. If attachmentKey is -1 this
+	/// is getAttachment(slotIndex, attachmentName).
+	/// @return May be NULL.
+	Attachment *getAttachment(int slotIndex, int attachmentKey, const String &attachmentName);
+
 	/// @param attachmentName May be empty.
 	void setAttachment(const String &slotName, const String &attachmentName);
 
@@ -170,6 +210,10 @@ public:
 
 	Vector<Bone *> &getBones();
 
+	/// The pose store holding the world transforms of the bones it computes, or NULL if the skeleton was created without one. Bones
+	/// whose BoneData transform mode is changed require updateCache() to be called before the next updateWorldTransform().
+	BonePoseStore *getPoseStore();
+
 	Vector<Updatable *> &getUpdateCacheList();
 
 	Vector<Slot *> &getSlots();
@@ -210,6 +254,7 @@ public:
 
 private:
 	SkeletonData *_data;
+	BonePoseStore *_poseStore;
 	Vector<Bone *> _bones;
 	Vector<Slot *> _slots;
 	Vector<Slot *> _drawOrder;
@@ -218,11 +263,28 @@ private:
 	Vector<PathConstraint *> _pathConstraints;
 	Vector<Updatable *> _updateCache;
 	Vector<Bone *> _updateCacheReset;
+	Vector<int> _updateCacheBones;
+	Vector<int> _updateCacheBoneRuns;
+	Vector<int> _updateCacheKinds;
+	Vector<float> _updateState;
+	Vector<bool> _updateCacheDirty;
+	Vector<bool> _boneDirty;
+	Vector<float> _boneMatrices;
 	Skin *_skin;
+	Vector<Attachment *> _keyedAttachments;
+	unsigned int _keyedSkinVersion, _keyedDefaultSkinVersion;
 	Color _color;
 	float _time;
 	float _scaleX, _scaleY;
 	float _x, _y;
+	bool _incrementalUpdate;
+	bool _updateStateValid;
+	bool _boneMatricesValid; // False if a world transform changed since updateWorldTransform().
+	float _updatedX, _updatedY, _updatedScaleX, _updatedScaleY;
+
+	/// Marks the update cache entries affected by changes since the previous update and, unless too much changed, updates only
+	/// those. Returns false if the full update is needed.
+	bool updateDirtyWorldTransform();
 
 	void sortIkConstraint(IkConstraint *constraint);
 
@@ -237,6 +299,16 @@ private:
 	void sortBone(Bone *bone);
 
 	static void sortReset(Vector<Bone *> &bones);
+
+	/// Finds the attachment of each attachment key in the skin and default skin.
+	void resolveAttachments();
+
+	/// Updates the world transforms of all entries of the update cache.
+	void updateAllWorldTransforms();
+
+	/// Copies the world transforms of all bones to _boneMatrices, 8 floats per bone: a, c, b, d, worldX, worldY and 2 unused.
+	/// Called by updateWorldTransform(), so that computing world vertices only reads the skeleton.
+	void gatherBoneMatrices();
 };
 }
 
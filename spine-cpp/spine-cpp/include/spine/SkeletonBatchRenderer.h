@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonBatchRenderer_h
+#define Spine_SkeletonBatchRenderer_h
+
+#include <spine/BlendMode.h>
+#include <spine/Color.h>
+#include <spine/HashMap.h>
+#include <spine/SkeletonClipping.h>
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+class Skeleton;
+
+class Slot;
+
+class Attachment;
+
+class MeshAttachment;
+
+class VertexEffect;
+
+/// A vertex of SkeletonBatchRenderer::getVertices(). Colors are packed with red in the lowest and alpha in the highest byte, so
+/// they are R, G, B, A bytes in memory on little endian machines.
+struct SP_API RenderVertex {
+	float x, y;
+	float u, v;
+	unsigned int color;
+	/// The dark color for two color tinting. Its alpha is 1 if premultiplied alpha is used, 0 otherwise.
+	unsigned int darkColor;
+};
+
+/// A batch of triangles drawn with the same texture and blend mode.
+struct SP_API RenderCommand {
+	/// The renderer object of the atlas page, see AtlasPage::getRendererObject().
+	void *texture;
+	BlendMode blendMode;
+	/// The range of the batch in SkeletonBatchRenderer::getVertices().
+	size_t vertexStart, vertexCount;
+	/// The range of the batch in SkeletonBatchRenderer::getIndices(). The indices are relative to vertexStart.
+	size_t indexStart, indexCount;
+};
+
+/// Turns the attachments of a skeleton into batched draw commands, independent of the graphics API. Each render() walks the draw
+/// order, computes the world vertices of region and mesh attachments, applies clipping, the vertex effect and the skeleton, slot
+/// and attachment colors, and appends the vertices and indices to buffers shared by all commands. Consecutive attachments with
+/// the same texture and blend mode are merged into one command, as long as its vertices can be indexed with 16 bits.
+///
+/// The buffers are reused by the next render(), so once they have grown to the size of the skeleton no memory is allocated.
+/// Attachment renderer objects must be AtlasRegion instances, as set by AtlasAttachmentLoader.
+class SP_API SkeletonBatchRenderer : public SpineObject {
+public:
+	SkeletonBatchRenderer();
+
+	/// Replaces the commands, vertices and indices with those for the skeleton's current world transforms.
+	void render(Skeleton &skeleton);
+
+	Vector<RenderCommand> &getCommands();
+
+	Vector<RenderVertex> &getVertices();
+
+	Vector<unsigned short> &getIndices();
+
+	/// If true, the red, green and blue of the vertex colors are multiplied by alpha. Default is false.
+	void setPremultipliedAlpha(bool premultipliedAlpha);
+
+	bool getPremultipliedAlpha();
+
+	/// @param vertexEffect May be NULL.
+	void setVertexEffect(VertexEffect *vertexEffect);
+
+	VertexEffect *getVertexEffect();
+
+	/// Enables culling against the rectangle, in world coordinates. Before the world vertices of an attachment are computed, its
+	/// conservative bounds are found from its bone space bounds and bone world transforms, and it is skipped if they don't
+	/// intersect the rectangle. If no attachment does, the whole skeleton is skipped. Nothing is culled while a vertex effect is
+	/// set, since it may move vertices.
+	///
+	/// The bone space bounds of meshes are cached by VertexAttachment::getId(), see clearBoundsCache().
+	void setCullRectangle(float x, float y, float width, float height);
+
+	/// Disables culling, the default.
+	void clearCullRectangle();
+
+	bool isCulling();
+
+	/// Must be called if the vertices of a mesh rendered before are modified.
+	void clearBoundsCache();
+
+	/// The number of region and mesh attachments skipped by culling in the last render(), including those of a culled skeleton.
+	size_t getCulledCount();
+
+	/// The number of region and mesh attachments whose vertices were computed by the last render().
+	size_t getRenderedCount();
+
+	/// True if all attachments were culled in the last render(), which then returned before computing any world vertices.
+	bool isSkeletonCulled();
+
+private:
+	Vector<RenderCommand> _commands;
+	Vector<RenderVertex> _vertices;
+	Vector<unsigned short> _indices;
+	SkeletonClipping _clipper;
+	Vector<float> _worldVertices;
+	Vector<unsigned short> _quadIndices;
+	bool _premultipliedAlpha;
+	VertexEffect *_vertexEffect;
+	bool _culling;
+	float _cullMinX, _cullMinY, _cullMaxX, _cullMaxY;
+	size_t _culledCount, _renderedCount;
+	bool _skeletonCulled;
+	Vector<bool> _slotCulled;
+	HashMap<int, size_t> _boundsIndex;
+	Vector<float> _boundsCache;
+
+	/// Culls the attachments of the slots in draw order, returns false if all were culled.
+	bool cull(Skeleton &skeleton);
+
+	/// Returns true if the conservative world bounds of the attachment intersect the cull rectangle.
+	bool isVisible(Skeleton &skeleton, Slot &slot, Attachment *attachment);
+
+	/// Returns the offset in _boundsCache of the mesh's bone space bounds: the number of boxes, then the bone index (-1 for the
+	/// slot's bone), min x, min y, max x and max y of each box.
+	size_t getMeshBounds(MeshAttachment &mesh);
+
+	/// Appends the vertices and indices of an attachment to the current command, or to a new one if it can't be merged.
+	/// @return The first of the appended vertices, whose positions are left to the caller.
+	RenderVertex *addVertices(void *texture, BlendMode blendMode, size_t vertexCount, unsigned short *indices, size_t indexCount);
+
+	/// Sets the texture coordinates and colors of the vertices.
+	void setVertexAttributes(RenderVertex *vertices, size_t vertexCount, float *uvs, Color &light, Color &dark);
+
+	static unsigned int packColor(Color &color);
+};
+}
+
+#endif /* Spine_SkeletonBatchRenderer_h */
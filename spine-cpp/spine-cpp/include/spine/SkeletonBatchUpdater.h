@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonBatchUpdater_h
+#define Spine_SkeletonBatchUpdater_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+class Skeleton;
+
+class AnimationState;
+
+class SkeletonBatchWorkers;
+
+/// Updates many independent skeleton and animation state pairs, distributing them over a pool of worker threads. For each pair,
+/// update() calls AnimationState::update(), AnimationState::apply() and Skeleton::updateWorldTransform().
+///
+/// Threading guarantees during update():
+/// - SkeletonData, AnimationStateData and everything they own (bone, slot and constraint data, skins, attachments, animations and
+///   timelines) are only read, so any number of pairs may share them.
+/// - Each Skeleton and AnimationState is only touched by the thread updating its pair. A skeleton or state must not be part of
+///   more than one pair, and must not be accessed by other threads until update() returns.
+/// - AnimationState and TrackEntry listeners are called on the worker thread updating the pair.
+/// - Allocations go through the SpineExtension instance, which must be thread-safe. DefaultSpineExtension and DebugExtension are.
+///
+/// Not safe to run concurrently with update(): modifying the shared data listed above. Loading other skeleton data, for example
+/// with SkeletonDataCache::prefetch(), is safe unless SPINE_NO_THREADS is defined, in which case VertexAttachment IDs come from
+/// a counter which is not atomic.
+///
+/// Define SPINE_NO_THREADS to build without thread support, in which case all pairs are updated on the calling thread.
+class SP_API SkeletonBatchUpdater : public SpineObject {
+	friend class SkeletonBatchWorkers;
+
+public:
+	/// @param threadCount The number of threads updating pairs, including the thread calling update(). If 0, the number of hardware
+	/// threads is used.
+	explicit SkeletonBatchUpdater(int threadCount = 0);
+
+	~SkeletonBatchUpdater();
+
+	void add(Skeleton &skeleton, AnimationState &state);
+
+	/// @return false if the skeleton was not added.
+	bool remove(Skeleton &skeleton);
+
+	void clear();
+
+	size_t size();
+
+	/// Advances, applies and updates the world transforms of all pairs, returning when all pairs are done.
+	void update(float delta);
+
+	int getThreadCount();
+
+private:
+	struct Entry {
+		Skeleton *skeleton;
+		AnimationState *state;
+
+		Entry() : skeleton(NULL), state(NULL) {
+		}
+
+		Entry(Skeleton *skeleton, AnimationState *state) : skeleton(skeleton), state(state) {
+		}
+	};
+
+	Vector<Entry> _entries;
+	SkeletonBatchWorkers *_workers;
+	float _delta;
+
+	void updateEntry(size_t index);
+};
+}
+
+#endif /* Spine_SkeletonBatchUpdater_h */
@@ -46,6 +46,8 @@ namespace spine {
 	class VertexAttachment;
 	class Animation;
 	class CurveTimeline;
+	class Timeline;
+	class DeformTimeline;
 
 	class SP_API SkeletonBinary : public SpineObject {
 	public:
@@ -76,8 +78,55 @@ namespace spine {
 
 		SkeletonData* readSkeletonDataFile(const String& path);
 
+		/// Writes the skeleton data in the format read by readSkeletonData(), with the nonessential data. Values which are
+		/// multiplied by the scale when read are divided by it. Bezier curves are stored with the control points recovered by
+		/// CurveTimeline::getCurve(), so they are read back within float precision. Nonessential colors which are not kept in the
+		/// skeleton data are written as defaults.
+		/// @return False if the skeleton data has attachments or timelines of custom types, see getError().
+		bool writeSkeletonData(SkeletonData* skeletonData, Vector<unsigned char>& output);
+
+		bool writeSkeletonDataFile(SkeletonData* skeletonData, const String& path);
+
 		void setScale(float scale) { _scale = scale; }
 
+		/// Sets the number of lookup table segments used for bezier curves of the animations read afterward, see
+		/// CurveTimeline::setCurveLookupSize(). 0, the default, keeps the forward differenced curves.
+		void setCurveLookupSize(size_t size) { _curveLookupSize = size; }
+
+		size_t getCurveLookupSize() { return _curveLookupSize; }
+
+		/// If true, the memory of the skeleton data read afterward comes from the arena of the skeleton data, see
+		/// SkeletonData::getArena(). Default is false.
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		bool getUseArena() { return _useArena; }
+
+		/// If true, the weighted vertex attachments read afterward regroup their vertices by influence count, see
+		/// VertexAttachment::buildInfluenceBuckets(). Default is false.
+		void setUseInfluenceBuckets(bool useInfluenceBuckets) { _useInfluenceBuckets = useInfluenceBuckets; }
+
+		bool getUseInfluenceBuckets() { return _useInfluenceBuckets; }
+
+		/// If true, the frames, curves and deform vertices of each animation read afterward are moved into one buffer owned by the
+		/// animation, see Animation::getPackedFrames(). Default is false.
+		void setPackFrames(bool packFrames) { _packFrames = packFrames; }
+
+		bool getPackFrames() { return _packFrames; }
+
+		/// If true, the deform timelines of the animations read afterward store their vertices as 16 bit values, see
+		/// DeformTimeline::quantizeVertices(). Default is false.
+		void setQuantizeDeform(bool quantizeDeform) { _quantizeDeform = quantizeDeform; }
+
+		bool getQuantizeDeform() { return _quantizeDeform; }
+
+		/// Sets the number of threads decoding the animations of the skeleton data read afterward, including the calling thread. If
+		/// 0, the number of hardware threads is used. Default is 1. A first pass skips over the animations to find where each
+		/// starts, so more threads only pay off for exports with many large animations. Animations decoded by several threads are
+		/// allocated on the heap, even if setUseArena() is true. Ignored if SPINE_NO_THREADS is defined.
+		void setAnimationThreads(int threadCount) { _animationThreads = threadCount; }
+
+		int getAnimationThreads() { return _animationThreads; }
+
 		String& getError() { return _error; }
 
 	private:
@@ -86,10 +135,18 @@ namespace spine {
 			const unsigned char* end;
 		};
 
+		struct DataOutput;
+
 		AttachmentLoader* _attachmentLoader;
 		Vector<LinkedMesh*> _linkedMeshes;
 		String _error;
 		float _scale;
+		size_t _curveLookupSize;
+		bool _useArena;
+		bool _useInfluenceBuckets;
+		bool _packFrames;
+		bool _quantizeDeform;
+		int _animationThreads;
 		const bool _ownsLoader;
 
 		void setError(const char* value1, const char* value2);
@@ -122,9 +179,52 @@ namespace spine {
 
 		void readShortArray(DataInput *input, Vector<unsigned short>& array);
 
+		bool readAnimations(DataInput* input, SkeletonData* skeletonData);
+
 		Animation* readAnimation(const String& name, DataInput* input, SkeletonData *skeletonData);
 
+		bool skipAnimation(DataInput* input, SkeletonData* skeletonData);
+
+		void skipCurve(DataInput* input);
+
 		void readCurve(DataInput* input, int frameIndex, CurveTimeline* timeline);
+
+		/// Adds the vectors holding the frames, curves and deform vertices of the timeline.
+		static void getFrameVectors(Timeline* timeline, Vector<Vector<float>*>& vectors);
+
+		static void packFrames(Animation* animation);
+
+		void writeString(DataOutput* output, const String& value);
+
+		void writeStringRef(DataOutput* output, const String& value);
+
+		void writeFloat(DataOutput* output, float value);
+
+		void writeByte(DataOutput* output, unsigned char value);
+
+		void writeBoolean(DataOutput* output, bool value);
+
+		void writeInt(DataOutput* output, int value);
+
+		void writeColor(DataOutput* output, Color& color);
+
+		void writeVarint(DataOutput* output, int value, bool optimizePositive);
+
+		bool writeSkin(DataOutput* output, Skin* skin, SkeletonData* skeletonData, Vector<Skin*>& skins);
+
+		bool writeAttachment(DataOutput* output, Attachment* attachment, const String& attachmentName, SkeletonData* skeletonData, Vector<Skin*>& skins);
+
+		void writeVertices(DataOutput* output, VertexAttachment* attachment);
+
+		void writeFloatArray(DataOutput* output, Vector<float>& array, float scale);
+
+		void writeShortArray(DataOutput* output, Vector<unsigned short>& array);
+
+		bool writeAnimation(DataOutput* output, Animation* animation, SkeletonData* skeletonData, Vector<Skin*>& skins);
+
+		void writeDeformTimeline(DataOutput* output, DeformTimeline* timeline, const String& attachmentName);
+
+		void writeCurve(DataOutput* output, size_t frameIndex, CurveTimeline* timeline);
 	};
 }
 
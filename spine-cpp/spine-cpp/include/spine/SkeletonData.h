@@ -32,6 +32,8 @@
 
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
+#include <spine/ArenaAllocator.h>
+#include <spine/HashMap.h>
 
 namespace spine {
 class BoneData;
@@ -50,7 +52,33 @@ class TransformConstraintData;
 
 class PathConstraintData;
 
+/// Handle of a name interned by a SkeletonData, see SkeletonData::findName(). Finding items by handle indexes an array instead of
+/// hashing and comparing the name. A handle stays valid for the lifetime of the skeleton data which returned it.
+class SP_API NameHandle {
+	friend class SkeletonData;
+
+public:
+	NameHandle() : _id(-1) {
+	}
+
+	/// False if the name was not found.
+	bool isValid() const { return _id != -1; }
+
+	bool operator==(const NameHandle &other) const { return _id == other._id; }
+
+	friend size_t hashKey(const NameHandle &handle) { return hashKey(handle._id); }
+
+private:
+	explicit NameHandle(int id) : _id(id) {
+	}
+
+	int _id;
+};
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
+///
+/// The find methods use hash indexes of the names, built by indexNames(). The find methods may be called by several threads
+/// concurrently.
 class SP_API SkeletonData : public SpineObject {
 	friend class SkeletonBinary;
 
@@ -63,7 +91,16 @@ public:
 
 	~SkeletonData();
 
-	/// Finds a bone by comparing each bone's name.
+	/// Returns the handle of a name of a bone, slot, skin, event, animation or constraint, or an invalid handle if no item had the
+	/// name when indexNames() was last called. The find methods taking a handle are faster than those taking a name.
+	NameHandle findName(const String &name);
+
+	/// Builds the hash indexes of the names for the find methods. Called by SkeletonBinary and SkeletonJson after reading the
+	/// data. Must be called again after items are added, removed, replaced or renamed, not while the find methods are called.
+	/// Until then the find methods search linearly if the number of items changed. Handles remain valid.
+	void indexNames();
+
+	/// Finds a bone by name.
 	/// It is more efficient to cache the results of this method than to call it multiple times.
 	/// @return May be NULL.
 	BoneData *findBone(const String &boneName);
@@ -98,6 +135,39 @@ public:
 	/// @return -1 if the path constraint was not found.
 	int findPathConstraintIndex(const String &pathConstraintName);
 
+	/// @return May be NULL.
+	BoneData *findBone(const NameHandle &boneName);
+
+	/// @return -1 if the bone was not found.
+	int findBoneIndex(const NameHandle &boneName);
+
+	/// @return May be NULL.
+	SlotData *findSlot(const NameHandle &slotName);
+
+	/// @return -1 if the slot was not found.
+	int findSlotIndex(const NameHandle &slotName);
+
+	/// @return May be NULL.
+	Skin *findSkin(const NameHandle &skinName);
+
+	/// @return May be NULL.
+	spine::EventData *findEvent(const NameHandle &eventDataName);
+
+	/// @return May be NULL.
+	Animation *findAnimation(const NameHandle &animationName);
+
+	/// @return May be NULL.
+	IkConstraintData *findIkConstraint(const NameHandle &constraintName);
+
+	/// @return May be NULL.
+	TransformConstraintData *findTransformConstraint(const NameHandle &constraintName);
+
+	/// @return May be NULL.
+	PathConstraintData *findPathConstraint(const NameHandle &constraintName);
+
+	/// @return -1 if the path constraint was not found.
+	int findPathConstraintIndex(const NameHandle &pathConstraintName);
+
 	const String &getName();
 
 	void setName(const String &inValue);
@@ -165,7 +235,22 @@ public:
 
 	void setFps(float inValue);
 
+	/// The arena holding the memory of this data if it was read with SkeletonBinary::setUseArena() or
+	/// SkeletonJson::setUseArena(), otherwise it is empty. Changes which free or grow memory of the data, like adding items or
+	/// renaming, must be made in an ArenaScope of this arena. indexNames() and indexAttachments() do so themselves.
+	ArenaAllocator &getArena();
+
+	/// Gives each attachment name of the slots' setup poses and of the attachment timelines a key, unique per slot and name. A
+	/// skeleton finds keyed attachments by indexing a table it resolves when its skin changes, see
+	/// Skeleton::getAttachment(int, int, const String&). Called by SkeletonBinary and SkeletonJson. Must be called again after
+	/// slots or attachment timelines are added, not while skeletons of this data are updated.
+	void indexAttachments();
+
+	/// The number of attachment keys, see indexAttachments().
+	size_t getAttachmentKeyCount();
+
 private:
+	ArenaAllocator _arena; // Declared first so it is destroyed after the other members.
 	String _name;
 	Vector<BoneData *> _bones; // Ordered parents first
 	Vector<SlotData *> _slots; // Setup pose draw order.
@@ -185,6 +270,41 @@ private:
 	float _fps;
 	String _imagesPath;
 	String _audioPath;
+
+	/// Indexes of the items with one name, -1 if there is none.
+	struct NamedItems {
+		int bone, slot, skin, event, animation, ikConstraint, transformConstraint, pathConstraint;
+
+		NamedItems() : bone(-1), slot(-1), skin(-1), event(-1), animation(-1), ikConstraint(-1), transformConstraint(-1),
+			pathConstraint(-1) {
+		}
+	};
+
+	static const int NAMED_VECTORS = 8;
+
+	Vector<int> _attachmentKeySlots; // Slot index by attachment key.
+	Vector<String> _attachmentKeyNames; // Attachment name by attachment key.
+
+	/// Returns the key of the attachment name of a slot, adding it if needed. -1 if the name is empty.
+	int addAttachmentKey(Vector< Vector<int> > &slotKeys, size_t slotIndex, const String &attachmentName);
+
+	HashMap<String, int> _nameIds;
+	Vector<String> _names; // By name id.
+	Vector<NamedItems> _namedItems; // By name id.
+	size_t _namedCounts[NAMED_VECTORS]; // The item counts included in _namedItems.
+
+	/// False if items were added or removed since indexNames() was called.
+	bool namesIndexed();
+
+	template<typename T>
+	void indexNames(Vector<T *> &items, size_t &count, int NamedItems::*index);
+
+	/// @return -1 if the name was not found.
+	template<typename T>
+	int findIndex(Vector<T *> &items, const String &name, int NamedItems::*index);
+
+	template<typename T>
+	int findIndex(Vector<T *> &items, const NameHandle &name, int NamedItems::*index);
 };
 }
 
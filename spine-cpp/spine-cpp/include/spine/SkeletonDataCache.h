@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonDataCache_h
+#define Spine_SkeletonDataCache_h
+
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+class SkeletonData;
+
+class Atlas;
+
+class AttachmentLoader;
+
+class SkeletonDataCacheSync;
+
+/// Shares the skeleton data loaded from a file between all its users, so creating many skeletons from one file loads it once.
+/// Skeleton data is keyed by its file path, scale and atlas. Each acquire() must be matched by a release(). Skeleton data no
+/// longer acquired stays cached until it is evicted, least recently released first, by evict() or when the cache exceeds its
+/// memory budget.
+///
+/// Skeleton data is read into its own arena, see SkeletonData::getArena(), whose capacity is the memory counted for it. All
+/// methods may be called from any thread. Loads of different files run in parallel, a second acquire() of a file being loaded
+/// waits for that load. Loading needs the SpineExtension instance to be thread-safe, as for SkeletonBatchUpdater. Define
+/// SPINE_NO_THREADS to build without thread support, in which case prefetch() loads on the calling thread.
+class SP_API SkeletonDataCache : public SpineObject {
+	friend class SkeletonDataCacheSync;
+
+public:
+	/// @param memoryBudget See setMemoryBudget().
+	explicit SkeletonDataCache(size_t memoryBudget = 0);
+
+	/// Waits for the prefetches in progress, then deletes all skeleton data, including data that was not released.
+	~SkeletonDataCache();
+
+	/// Returns the skeleton data of the file, loading it if it is not cached. Files ending in ".json" are read with SkeletonJson,
+	/// others with SkeletonBinary.
+	/// @param attachmentLoader Used if the file is loaded, it must create attachments for the atlas. If NULL, an
+	/// AtlasAttachmentLoader is used.
+	/// @return NULL if the file could not be loaded, see getError().
+	SkeletonData *acquire(const String &path, Atlas *atlas, float scale = 1, AttachmentLoader *attachmentLoader = NULL);
+
+	/// Starts loading the file on a background thread if it is not cached. The skeleton data is not acquired, the next acquire()
+	/// of the file waits for the load to finish instead of starting another. If the load fails, the next acquire() tries again.
+	void prefetch(const String &path, Atlas *atlas, float scale = 1, AttachmentLoader *attachmentLoader = NULL);
+
+	/// Releases skeleton data returned by acquire(). It is not deleted until it is evicted.
+	void release(SkeletonData *skeletonData);
+
+	/// Deletes skeleton data which is not acquired, least recently released first, until the memory of the cache is at most
+	/// targetMemory. Call it with 0 when the platform reports memory pressure.
+	/// @return The memory freed.
+	size_t evict(size_t targetMemory);
+
+	/// Released skeleton data is evicted as soon as the memory of the cache exceeds the budget. If 0, the default, released data
+	/// stays cached until evict() is called.
+	void setMemoryBudget(size_t memoryBudget);
+
+	size_t getMemoryBudget();
+
+	/// The memory of all cached skeleton data.
+	size_t getMemoryUsage();
+
+	/// The number of cached skeleton data, including data being loaded.
+	size_t size();
+
+	/// The number of acquire() calls not yet matched by release() for the skeleton data, 0 if it is not cached.
+	int getReferenceCount(SkeletonData *skeletonData);
+
+	/// The number of files loaded by this cache, to check how often acquire() found the skeleton data cached.
+	size_t getLoadCount();
+
+	/// The error of the last load that failed.
+	String getError();
+
+private:
+	struct Entry : public SpineObject {
+		String path;
+		Atlas *atlas;
+		float scale;
+		AttachmentLoader *attachmentLoader;
+		SkeletonData *skeletonData;
+		String error;
+		size_t memory;
+		size_t lastUse;
+		int references;
+		bool loading;
+	};
+
+	Vector<Entry *> _entries;
+	SkeletonDataCacheSync *_sync;
+	size_t _memoryBudget;
+	size_t _memoryUsage;
+	size_t _loadCount;
+	size_t _useCounter;
+	String _error;
+
+	Entry *findEntry(const String &path, Atlas *atlas, float scale);
+
+	/// Adds an entry being loaded. The caller must load it with load(), then call finishLoad().
+	Entry *addEntry(const String &path, Atlas *atlas, float scale, AttachmentLoader *attachmentLoader, bool prefetching);
+
+	/// Loads the file of the entry without the lock held, only reading the key and the attachment loader of the entry.
+	SkeletonData *load(Entry *entry, String &error);
+
+	/// Stores the loaded skeleton data in the entry, evicts if the budget is exceeded and wakes the threads waiting for the load.
+	/// A failed load is removed unless it is referenced. Must be called with the lock held.
+	void finishLoad(Entry *entry, SkeletonData *skeletonData, const String &error);
+
+	size_t evictLocked(size_t targetMemory);
+
+	void removeEntry(size_t index);
+};
+}
+
+#endif /* Spine_SkeletonDataCache_h */
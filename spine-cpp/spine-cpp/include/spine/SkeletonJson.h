@@ -67,18 +67,46 @@ public:
 
 	void setScale(float scale) { _scale = scale; }
 
+	/// Sets the number of lookup table segments used for bezier curves of the animations read afterward, see
+	/// CurveTimeline::setCurveLookupSize(). 0, the default, keeps the forward differenced curves.
+	void setCurveLookupSize(size_t size) { _curveLookupSize = size; }
+
+	size_t getCurveLookupSize() { return _curveLookupSize; }
+
+	/// If true, the memory of the skeleton data read afterward comes from the arena of the skeleton data, see
+	/// SkeletonData::getArena(). Default is false.
+	void setUseArena(bool useArena) { _useArena = useArena; }
+
+	bool getUseArena() { return _useArena; }
+
+	/// If true, the weighted vertex attachments read afterward regroup their vertices by influence count, see
+	/// VertexAttachment::buildInfluenceBuckets(). Default is false.
+	void setUseInfluenceBuckets(bool useInfluenceBuckets) { _useInfluenceBuckets = useInfluenceBuckets; }
+
+	bool getUseInfluenceBuckets() { return _useInfluenceBuckets; }
+
+	/// If true, the deform timelines of the animations read afterward store their vertices as 16 bit values, see
+	/// DeformTimeline::quantizeVertices(). Default is false.
+	void setQuantizeDeform(bool quantizeDeform) { _quantizeDeform = quantizeDeform; }
+
+	bool getQuantizeDeform() { return _quantizeDeform; }
+
 	String &getError() { return _error; }
 
 private:
 	AttachmentLoader *_attachmentLoader;
 	Vector<LinkedMesh *> _linkedMeshes;
 	float _scale;
+	size_t _curveLookupSize;
+	bool _useArena;
+	bool _useInfluenceBuckets;
+	bool _quantizeDeform;
 	const bool _ownsLoader;
 	String _error;
 
 	static float toColor(const char *value, size_t index);
 
-	static void readCurve(Json *frame, CurveTimeline *timeline, size_t frameIndex);
+	void readCurve(Json *frame, CurveTimeline *timeline, size_t frameIndex);
 
 	Animation *readAnimation(Json *root, SkeletonData *skeletonData);
 
@@ -150,9 +150,14 @@ public:
 	Vector<BoneData*>& getBones();
 
 	Vector<ConstraintData*>& getConstraints();
+
+	/// Changes whenever attachments are set or removed, unique across all skins. Skeletons use it to know when the attachments
+	/// they resolved for attachment keys are outdated, see Skeleton::getAttachment(int, int, const String&).
+	unsigned int getVersion();
 private:
 	const String _name;
 	AttachmentMap _attachments;
+	unsigned int _version;
 	Vector<BoneData*> _bones;
 	Vector<ConstraintData*> _constraints;
 
@@ -71,6 +71,8 @@ class SP_API SlotData : public SpineObject {
 
 	friend class TwoColorTimeline;
 
+	friend class SkeletonData;
+
 public:
 	SlotData(int index, const String &name, BoneData &boneData);
 
@@ -93,6 +95,9 @@ public:
 
 	void setAttachmentName(const String &inValue);
 
+	/// The key of the setup pose attachment name, see SkeletonData::indexAttachments(). -1 if the name has no key.
+	int getAttachmentKey();
+
 	BlendMode getBlendMode();
 
 	void setBlendMode(BlendMode inValue);
@@ -106,6 +111,7 @@ private:
 
 	bool _hasDarkColor;
 	String _attachmentName;
+	int _attachmentKey;
 	BlendMode _blendMode;
 };
 }
@@ -63,6 +63,14 @@ public:
 	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 		MixDirection direction) = 0;
 
+	/// Same as apply(Skeleton&, float, float, Vector<Event*>*, float, MixBlend, MixDirection), but starts the key search at
+	/// frameCursor and stores the key found there, so consecutive applies at increasing times rarely need a binary search. The
+	/// cursor is only a hint: any value gives the same result. AnimationState keeps one cursor per timeline in each TrackEntry.
+	/// The default implementation ignores the cursor.
+	virtual void
+	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+		MixDirection direction, int &frameCursor);
+
 	virtual int getPropertyId() = 0;
 };
 }
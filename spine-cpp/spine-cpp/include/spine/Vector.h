@@ -42,7 +42,7 @@ public:
 	Vector() : _size(0), _capacity(0), _buffer(NULL) {
 	}
 
-	Vector(const Vector &inVector) : _size(inVector._size), _capacity(inVector._capacity), _buffer(NULL) {
+	Vector(const Vector &inVector) : _size(inVector._size), _capacity(inVector._capacity > 0 ? inVector._capacity : inVector._size), _buffer(NULL) {
 		if (_capacity > 0) {
 			_buffer = allocate(_capacity);
 			for (size_t i = 0; i < _size; ++i) {
@@ -77,9 +77,9 @@ public:
 		size_t oldSize = _size;
 		_size = newSize;
 		if (_capacity < newSize) {
-			_capacity = (int) (_size * 1.75f);
-			if (_capacity < 8) _capacity = 8;
-			_buffer = spine::SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+			size_t capacity = (int) (_size * 1.75f);
+			if (capacity < 8) capacity = 8;
+			reallocate(capacity, oldSize);
 		}
 		if (oldSize < _size) {
 			for (size_t i = oldSize; i < _size; i++) {
@@ -90,20 +90,33 @@ public:
 
 	inline void ensureCapacity(size_t newCapacity = 0) {
 		if (_capacity >= newCapacity) return;
-		_capacity = newCapacity;
-		_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
+		reallocate(newCapacity, _size);
+	}
+
+	/// Makes this vector a view of size elements owned elsewhere, for example the packed frames of an Animation. The vector does
+	/// not free the memory and copies the elements to memory of its own before it grows.
+	inline void setView(T *buffer, size_t size) {
+		clear();
+		deallocate(_buffer);
+		_buffer = buffer;
+		_size = size;
+		_capacity = 0;
+	}
+
+	inline bool isView() const {
+		return _capacity == 0 && _buffer != NULL;
 	}
 
 	inline void add(const T &inValue) {
-		if (_size == _capacity) {
+		if (_size >= _capacity) {
 			// inValue might reference an element in this buffer
 			// When we reallocate, the reference becomes invalid.
 			// We thus need to create a defensive copy before
 			// reallocating.
 			T valueCopy = inValue;
-			_capacity = (int) (_size * 1.75f);
-			if (_capacity < 8) _capacity = 8;
-			_buffer = spine::SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+			size_t capacity = (int) (_size * 1.75f);
+			if (capacity < 8) capacity = 8;
+			reallocate(capacity, _size);
 			construct(_buffer + _size++, valueCopy);
 		} else {
 			construct(_buffer + _size++, inValue);
@@ -202,11 +215,22 @@ private:
 	}
 
 	inline void deallocate(T *buffer) {
-		if (_buffer) {
+		if (_buffer && _capacity > 0) {
 			SpineExtension::free(buffer, __FILE__, __LINE__);
 		}
 	}
 
+	/// Views are copied to new memory, which like realloc moves the first count elements bitwise.
+	inline void reallocate(size_t capacity, size_t count) {
+		if (isView()) {
+			T *buffer = SpineExtension::alloc<T>(capacity, __FILE__, __LINE__);
+			memcpy((void *) buffer, (void *) _buffer, count * sizeof(T));
+			_buffer = buffer;
+		} else
+			_buffer = SpineExtension::realloc<T>(_buffer, capacity, __FILE__, __LINE__);
+		_capacity = capacity;
+	}
+
 	inline void construct(T *buffer, const T &val) {
 		new(buffer) T(val);
 	}
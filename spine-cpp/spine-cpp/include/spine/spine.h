@@ -33,15 +33,18 @@
 #include <spine/Animation.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
+#include <spine/ArenaAllocator.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
 #include <spine/AttachmentLoader.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/AttachmentType.h>
+#include <spine/BakedAnimation.h>
 #include <spine/BlendMode.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/BonePoseStore.h>
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/Color.h>
@@ -60,6 +63,7 @@
 #include <spine/IkConstraint.h>
 #include <spine/IkConstraintData.h>
 #include <spine/IkConstraintTimeline.h>
+#include <spine/InfluenceBuckets.h>
 #include <spine/Json.h>
 #include <spine/LinkedMesh.h>
 #include <spine/MathUtil.h>
@@ -82,10 +86,13 @@
 #include <spine/ScaleTimeline.h>
 #include <spine/ShearTimeline.h>
 #include <spine/Skeleton.h>
+#include <spine/SkeletonBatchRenderer.h>
+#include <spine/SkeletonBatchUpdater.h>
 #include <spine/SkeletonBinary.h>
 #include <spine/SkeletonBounds.h>
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
+#include <spine/SkeletonDataCache.h>
 #include <spine/SkeletonJson.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
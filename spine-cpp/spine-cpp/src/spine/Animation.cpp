@@ -83,6 +83,10 @@ Vector<Timeline *> &Animation::getTimelines() {
 	return _timelines;
 }
 
+Vector<float> &Animation::getPackedFrames() {
+	return _packedFrames;
+}
+
 float Animation::getDuration() {
 	return _duration;
 }
@@ -131,6 +135,29 @@ int Animation::binarySearch(Vector<float> &values, float target) {
 	}
 }
 
+int Animation::search(Vector<float> &values, float target, int step, int &cursor) {
+	int last = (int)values.size() - step;
+	if (cursor > 0 && cursor <= last / step) {
+		int frame = cursor * step;
+		if (frame == step || values[frame - step] <= target) {
+			// Time usually advances by less than a key per apply, so the key is either the cached one or the next.
+			if (frame == last || target < values[frame]) return frame;
+			frame += step;
+			if (frame == last || target < values[frame]) {
+				cursor++;
+				return frame;
+			}
+		}
+	}
+	int frame = binarySearch(values, target, step);
+	cursor = frame / step;
+	return frame;
+}
+
+int Animation::search(Vector<float> &values, float target, int &cursor) {
+	return search(values, target, 1, cursor);
+}
+
 int Animation::linearSearch(Vector<float> &values, float target, int step) {
 	for (int i = 0, last = (int)values.size() - step; i <= last; i += step) {
 		if (values[i] > target) {
@@ -41,8 +41,18 @@
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
 #include <spine/AttachmentTimeline.h>
+#include <spine/ColorTimeline.h>
+#include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/EventTimeline.h>
+#include <spine/IkConstraintTimeline.h>
+#include <spine/PathConstraintMixTimeline.h>
+#include <spine/PathConstraintSpacingTimeline.h>
+#include <spine/ScaleTimeline.h>
+#include <spine/ShearTimeline.h>
+#include <spine/TimelineType.h>
+#include <spine/TransformConstraintTimeline.h>
+#include <spine/TwoColorTimeline.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SkeletonAnimation.h>
@@ -186,6 +196,9 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_frameCursors.clear();
+	_timelineOrder.clear();
+	_timelineRuns.clear();
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
@@ -299,14 +312,36 @@ const int HoldMix = 3;
 const int Setup = 1;
 const int Current = 2;
 
+// TimelineMix modes: the same alpha and blend for all timelines, the current entry, or an entry being mixed out.
+const int MixUniform = 0;
+const int MixCurrent = 1;
+const int MixFrom = 2;
+
+// Timelines whose class is not one of the TimelineType classes.
+const int OtherTimelines = TimelineType_TwoColor + 1;
+
 AnimationState::AnimationState(AnimationStateData *data) :
 		_data(data),
 		_queue(EventQueue::newEventQueue(*this, _trackEntryPool)),
+		_timelineCapacity(0),
 		_animationsChanged(false),
 		_listener(dummyOnAnimationEventFunc),
 		_listenerObject(NULL),
 		_unkeyedState(0),
 		_timeScale(1) {
+	// Reserve for the largest animation up front, so entries reused from the pool never grow their buffers.
+	size_t eventCapacity = 0;
+	Vector<Animation *> &animations = data->getSkeletonData()->getAnimations();
+	for (size_t i = 0, n = animations.size(); i < n; ++i) {
+		Vector<Timeline *> &timelines = animations[i]->getTimelines();
+		if (timelines.size() > _timelineCapacity) _timelineCapacity = timelines.size();
+		for (size_t ii = 0, nn = timelines.size(); ii < nn; ++ii) {
+			if (!timelines[ii]->getRTTI().isExactly(EventTimeline::rtti)) continue;
+			size_t frameCount = static_cast<EventTimeline *>(timelines[ii])->getFrameCount();
+			if (frameCount > eventCapacity) eventCapacity = frameCount;
+		}
+	}
+	_events.ensureCapacity(eventCapacity);
 }
 
 AnimationState::~AnimationState() {
@@ -422,38 +457,27 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		}
 
 		// apply current entry.
-		float animationLast = current._animationLast, animationTime = current.getAnimationTime();
-		size_t timelineCount = current._animation->_timelines.size();
-		Vector<Timeline *> &timelines = current._animation->_timelines;
+		TimelineMix timelineMix;
+		timelineMix.lastTime = current._animationLast;
+		timelineMix.time = current.getAnimationTime();
+		timelineMix.events = &_events;
+		timelineMix.alpha = mix;
+		timelineMix.alphaHold = mix;
+		timelineMix.blend = blend;
+		timelineMix.direction = MixDirection_In;
+		timelineMix.attachmentState = true;
+		timelineMix.attachments = true;
+		timelineMix.drawOrder = true;
+		timelineMix.firstFrame = false;
 		if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
-			for (size_t ii = 0; ii < timelineCount; ++ii) {
-                Timeline *timeline = timelines[ii];
-                if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, blend, true);
-                else
-                    timeline->apply(skeleton, animationLast, animationTime, &_events, mix, blend, MixDirection_In);
-            }
+			timelineMix.mode = MixUniform;
 		} else {
-			Vector<int> &timelineMode = current._timelineMode;
-
-			bool firstFrame = current._timelinesRotation.size() == 0;
-			if (firstFrame) current._timelinesRotation.setSize(timelines.size() << 1, 0);
-			Vector<float> &timelinesRotation = current._timelinesRotation;
-
-			for (size_t ii = 0; ii < timelineCount; ++ii) {
-				Timeline *timeline = timelines[ii];
-				assert(timeline);
-
-				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
-
-				if (timeline->getRTTI().isExactly(RotateTimeline::rtti))
-					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, animationTime, mix, timelineBlend, timelinesRotation, ii << 1, firstFrame);
-				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, timelineBlend, true);
-				else
-					timeline->apply(skeleton, animationLast, animationTime, &_events, mix, timelineBlend, MixDirection_In);
-			}
+			timelineMix.mode = MixCurrent;
+			timelineMix.firstFrame = current._timelinesRotation.size() == 0;
+			if (timelineMix.firstFrame) current._timelinesRotation.setSize(current._animation->_timelines.size() << 1, 0);
 		}
+		applyTimelines(current, skeleton, timelineMix);
+		float animationTime = timelineMix.time;
 
 		queueEvents(currentP, animationTime);
 		_events.clear();
@@ -466,8 +490,8 @@ bool AnimationState::apply(Skeleton &skeleton) {
     for (int i = 0, n = slots.size(); i < n; i++) {
         Slot* slot = slots[i];
         if (slot->getAttachmentState() == setupState) {
-            const String& attachmentName = slot->getData().getAttachmentName();
-            slot->setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot->getData().getIndex(), attachmentName));
+            SlotData& slotData = slot->getData();
+            slot->setAttachment(skeleton.getAttachment(slotData.getIndex(), slotData.getAttachmentKey(), slotData.getAttachmentName()));
         }
     }
     _unkeyedState += 2;
@@ -659,21 +683,212 @@ Animation *AnimationState::getEmptyAnimation() {
 	return &ret;
 }
 
-void AnimationState::applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float time, MixBlend blend, bool attachments) {
+static int getTimelineGroup(Timeline *timeline) {
+	const RTTI &rtti = timeline->getRTTI();
+	if (rtti.isExactly(RotateTimeline::rtti)) return TimelineType_Rotate;
+	if (rtti.isExactly(TranslateTimeline::rtti)) return TimelineType_Translate;
+	if (rtti.isExactly(ScaleTimeline::rtti)) return TimelineType_Scale;
+	if (rtti.isExactly(ShearTimeline::rtti)) return TimelineType_Shear;
+	if (rtti.isExactly(AttachmentTimeline::rtti)) return TimelineType_Attachment;
+	if (rtti.isExactly(ColorTimeline::rtti)) return TimelineType_Color;
+	if (rtti.isExactly(DeformTimeline::rtti)) return TimelineType_Deform;
+	if (rtti.isExactly(EventTimeline::rtti)) return TimelineType_Event;
+	if (rtti.isExactly(DrawOrderTimeline::rtti)) return TimelineType_DrawOrder;
+	if (rtti.isExactly(IkConstraintTimeline::rtti)) return TimelineType_IkConstraint;
+	if (rtti.isExactly(TransformConstraintTimeline::rtti)) return TimelineType_TransformConstraint;
+	if (rtti.isExactly(PathConstraintPositionTimeline::rtti)) return TimelineType_PathConstraintPosition;
+	if (rtti.isExactly(PathConstraintSpacingTimeline::rtti)) return TimelineType_PathConstraintSpacing;
+	if (rtti.isExactly(PathConstraintMixTimeline::rtti)) return TimelineType_PathConstraintMix;
+	if (rtti.isExactly(TwoColorTimeline::rtti)) return TimelineType_TwoColor;
+	return OtherTimelines;
+}
+
+void AnimationState::groupTimelines(TrackEntry *entry) {
+	Vector<Timeline *> &timelines = entry->_animation->_timelines;
+	int timelinesCount = (int)timelines.size();
+	Vector<int> &order = entry->_timelineOrder;
+	if ((int)order.size() == timelinesCount) return;
+
+	// Counting sort, stable so timelines of the same type keep their order. Attachment timelines come before deform timelines,
+	// which check the slot's attachment.
+	int starts[OtherTimelines + 3] = {0};
+	for (int i = 0; i < timelinesCount; i++)
+		starts[getTimelineGroup(timelines[i]) + 2]++;
+	Vector<int> &runs = entry->_timelineRuns;
+	runs.clear();
+	for (int group = 0; group <= OtherTimelines; group++) {
+		int count = starts[group + 2];
+		starts[group + 2] = starts[group + 1] + count;
+		if (count == 0) continue;
+		runs.add(group);
+		runs.add(starts[group + 2]);
+	}
+	order.setSize(timelinesCount, 0);
+	for (int i = 0; i < timelinesCount; i++)
+		order[starts[getTimelineGroup(timelines[i]) + 1]++] = i;
+}
+
+void AnimationState::getTimelineMix(TrackEntry &entry, int index, TimelineMix &mix, float &alpha, MixBlend &blend) {
+	switch (mix.mode) {
+		case MixUniform:
+			alpha = mix.alpha;
+			blend = mix.blend;
+			return;
+		case MixCurrent:
+			alpha = mix.alpha;
+			blend = entry._timelineMode[index] == Subsequent ? mix.blend : MixBlend_Setup;
+			return;
+	}
+	switch (entry._timelineMode[index]) {
+		case Subsequent:
+			blend = mix.blend;
+			alpha = mix.alpha;
+			break;
+		case First:
+			blend = MixBlend_Setup;
+			alpha = mix.alpha;
+			break;
+		case Hold:
+			blend = MixBlend_Setup;
+			alpha = mix.alphaHold;
+			break;
+		default:
+			blend = MixBlend_Setup;
+			TrackEntry *holdMix = entry._timelineHoldMix[index];
+			alpha = mix.alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
+			break;
+	}
+	entry._totalAlpha += alpha;
+}
+
+template<typename T>
+void AnimationState::applyTimelineRun(TrackEntry &entry, Skeleton &skeleton, TimelineMix &mix, const int *order, int start, int end) {
+	Vector<Timeline *> &timelines = entry._animation->_timelines;
+	int *frameCursors = entry._frameCursors.buffer();
+	float alpha;
+	MixBlend blend;
+	for (int i = start; i < end; i++) {
+		int index = order[i];
+		getTimelineMix(entry, index, mix, alpha, blend);
+		// Qualified call, the group guarantees the exact type.
+		static_cast<T *>(timelines[index])->T::apply(skeleton, mix.lastTime, mix.time, mix.events, alpha, blend, mix.direction, frameCursors[index]);
+	}
+}
+
+void AnimationState::applyTimelines(TrackEntry &entry, Skeleton &skeleton, TimelineMix &mix) {
+	Vector<Timeline *> &timelines = entry._animation->_timelines;
+	assert(entry._timelineOrder.size() == timelines.size());
+	const int *order = entry._timelineOrder.buffer();
+	int *frameCursors = entry._frameCursors.buffer();
+	Vector<int> &runs = entry._timelineRuns;
+	float alpha;
+	MixBlend blend;
+	int start = 0;
+	for (size_t r = 0, n = runs.size(); r < n; r += 2) {
+		int end = runs[r + 1];
+		switch (runs[r]) {
+			case TimelineType_Rotate:
+				if (mix.mode == MixUniform) {
+					applyTimelineRun<RotateTimeline>(entry, skeleton, mix, order, start, end);
+					break;
+				}
+				for (int i = start; i < end; i++) {
+					int index = order[i];
+					getTimelineMix(entry, index, mix, alpha, blend);
+					applyRotateTimeline(static_cast<RotateTimeline *>(timelines[index]), skeleton, mix.time, alpha, blend,
+						entry._timelinesRotation, index << 1, mix.firstFrame, frameCursors[index]);
+				}
+				break;
+			case TimelineType_Translate:
+				applyTimelineRun<TranslateTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_Scale:
+				applyTimelineRun<ScaleTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_Shear:
+				applyTimelineRun<ShearTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_Attachment:
+				if (!mix.attachmentState) {
+					applyTimelineRun<AttachmentTimeline>(entry, skeleton, mix, order, start, end);
+					break;
+				}
+				for (int i = start; i < end; i++) {
+					int index = order[i];
+					getTimelineMix(entry, index, mix, alpha, blend);
+					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timelines[index]), skeleton, mix.time, blend,
+						mix.attachments, frameCursors[index]);
+				}
+				break;
+			case TimelineType_Color:
+				applyTimelineRun<ColorTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_Deform:
+				applyTimelineRun<DeformTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_Event:
+				applyTimelineRun<EventTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_DrawOrder:
+				for (int i = start; i < end; i++) {
+					int index = order[i];
+					MixDirection direction = mix.direction;
+					if (mix.mode == MixFrom) {
+						if (!mix.drawOrder && entry._timelineMode[index] == Subsequent) continue;
+						getTimelineMix(entry, index, mix, alpha, blend);
+						if (mix.drawOrder && blend == MixBlend_Setup) direction = MixDirection_In;
+					} else
+						getTimelineMix(entry, index, mix, alpha, blend);
+					static_cast<DrawOrderTimeline *>(timelines[index])->DrawOrderTimeline::apply(skeleton, mix.lastTime, mix.time,
+						mix.events, alpha, blend, direction, frameCursors[index]);
+				}
+				break;
+			case TimelineType_IkConstraint:
+				applyTimelineRun<IkConstraintTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_TransformConstraint:
+				applyTimelineRun<TransformConstraintTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_PathConstraintPosition:
+				applyTimelineRun<PathConstraintPositionTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_PathConstraintSpacing:
+				applyTimelineRun<PathConstraintSpacingTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_PathConstraintMix:
+				applyTimelineRun<PathConstraintMixTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			case TimelineType_TwoColor:
+				applyTimelineRun<TwoColorTimeline>(entry, skeleton, mix, order, start, end);
+				break;
+			default:
+				for (int i = start; i < end; i++) {
+					int index = order[i];
+					getTimelineMix(entry, index, mix, alpha, blend);
+					timelines[index]->apply(skeleton, mix.lastTime, mix.time, mix.events, alpha, blend, mix.direction, frameCursors[index]);
+				}
+		}
+		start = end;
+	}
+}
+
+void AnimationState::applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float time, MixBlend blend, bool attachments, int &frameCursor) {
     Slot* slot = skeleton.getSlots()[attachmentTimeline->getSlotIndex()];
     if (!slot->getBone().isActive()) return;
 
     Vector<float>& frames = attachmentTimeline->getFrames();
     if (time < frames[0]) {
         if (blend == MixBlend_Setup || blend == MixBlend_First)
-            setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), attachments);
+            setAttachment(skeleton, *slot, slot->getData().getAttachmentKey(), slot->getData().getAttachmentName(), attachments);
     } else {
         int frameIndex = 0;
         if (time >= frames[attachmentTimeline->getFrames().size() - 1])
             frameIndex = attachmentTimeline->getFrames().size() - 1;
         else
-            frameIndex = Animation::binarySearch(frames, time) - 1;
-        setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[frameIndex], attachments);
+            frameIndex = Animation::search(frames, time, frameCursor) - 1;
+        Vector<int>& attachmentKeys = attachmentTimeline->getAttachmentKeys();
+        setAttachment(skeleton, *slot, attachmentKeys.size() > 0 ? attachmentKeys[frameIndex] : -1,
+            attachmentTimeline->getAttachmentNames()[frameIndex], attachments);
     }
 
     /* If an attachment wasn't set (ie before the first frame or attachments is false), set the setup attachment later.*/
@@ -682,12 +897,12 @@ void AnimationState::applyAttachmentTimeline(AttachmentTimeline* attachmentTimel
 
 
 void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleton &skeleton, float time, float alpha,
-	MixBlend blend, Vector<float> &timelinesRotation, size_t i, bool firstFrame
+	MixBlend blend, Vector<float> &timelinesRotation, size_t i, bool firstFrame, int &frameCursor
 ) {
 	if (firstFrame) timelinesRotation[i] = 0;
 
 	if (alpha == 1) {
-		rotateTimeline->apply(skeleton, 0, time, NULL, 1, blend, MixDirection_In);
+		rotateTimeline->apply(skeleton, 0, time, NULL, 1, blend, MixDirection_In, frameCursor);
 		return;
 	}
 
@@ -712,7 +927,7 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 			r2 = bone->_data._rotation + frames[frames.size() + RotateTimeline::PREV_ROTATION];
 		} else {
 			// Interpolate between the previous frame and the current frame.
-			int frame = Animation::binarySearch(frames, time, RotateTimeline::ENTRIES);
+			int frame = Animation::search(frames, time, RotateTimeline::ENTRIES, frameCursor);
 			float prevRotation = frames[frame + RotateTimeline::PREV_ROTATION];
 			float frameTime = frames[frame];
 			float percent = rotateTimeline->getCurvePercent((frame >> 1) - 1, 1 - (time - frameTime) / (frames[frame +
@@ -804,63 +1019,29 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 		if (blend != MixBlend_First) blend = from->_mixBlend;
 	}
 
-	Vector<Event *> *eventBuffer = mix < from->_eventThreshold ? &_events : NULL;
-	bool attachments = mix < from->_attachmentThreshold, drawOrder = mix < from->_drawOrderThreshold;
-	float animationLast = from->_animationLast, animationTime = from->getAnimationTime();
-	Vector<Timeline *> &timelines = from->_animation->_timelines;
-	size_t timelineCount = timelines.size();
-	float alphaHold = from->_alpha * to->_interruptAlpha, alphaMix = alphaHold * (1 - mix);
-
+	TimelineMix timelineMix;
+	timelineMix.lastTime = from->_animationLast;
+	timelineMix.time = from->getAnimationTime();
+	timelineMix.events = mix < from->_eventThreshold ? &_events : NULL;
+	timelineMix.alphaHold = from->_alpha * to->_interruptAlpha;
+	timelineMix.alpha = timelineMix.alphaHold * (1 - mix);
+	timelineMix.blend = blend;
+	timelineMix.direction = MixDirection_Out;
+	timelineMix.attachments = mix < from->_attachmentThreshold;
+	timelineMix.drawOrder = mix < from->_drawOrderThreshold;
+	timelineMix.firstFrame = false;
 	if (blend == MixBlend_Add) {
-		for (size_t i = 0; i < timelineCount; i++)
-			timelines[i]->apply(skeleton, animationLast, animationTime, eventBuffer, alphaMix, blend, MixDirection_Out);
+		timelineMix.mode = MixUniform;
+		timelineMix.attachmentState = false;
 	} else {
-		Vector<int> &timelineMode = from->_timelineMode;
-		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
-
-		bool firstFrame = from->_timelinesRotation.size() == 0;
-		if (firstFrame) from->_timelinesRotation.setSize(timelines.size() << 1, 0);
-
-		Vector<float> &timelinesRotation = from->_timelinesRotation;
-
+		timelineMix.mode = MixFrom;
+		timelineMix.attachmentState = true;
+		timelineMix.firstFrame = from->_timelinesRotation.size() == 0;
+		if (timelineMix.firstFrame) from->_timelinesRotation.setSize(from->_animation->_timelines.size() << 1, 0);
 		from->_totalAlpha = 0;
-		for (size_t i = 0; i < timelineCount; i++) {
-			Timeline *timeline = timelines[i];
-			MixDirection direction = MixDirection_Out;
-			MixBlend timelineBlend;
-			float alpha;
-			switch (timelineMode[i]) {
-				case Subsequent:
-					if (!drawOrder && (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))) continue;
-                    timelineBlend = blend;
-					alpha = alphaMix;
-					break;
-				case First:
-					timelineBlend = MixBlend_Setup;
-					alpha = alphaMix;
-					break;
-				case Hold:
-					timelineBlend = MixBlend_Setup;
-					alpha = alphaHold;
-					break;
-				default:
-					timelineBlend = MixBlend_Setup;
-					TrackEntry *holdMix = timelineHoldMix[i];
-					alpha = alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
-					break;
-			}
-			from->_totalAlpha += alpha;
-			if ((timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
-				applyRotateTimeline((RotateTimeline*)timeline, skeleton, animationTime, alpha, timelineBlend, timelinesRotation, i << 1, firstFrame);
-			} else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
-                applyAttachmentTimeline(static_cast<AttachmentTimeline*>(timeline), skeleton, animationTime, timelineBlend, attachments);
-            } else {
-			    if (drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) && timelineBlend == MixBlend_Setup)
-			        direction = MixDirection_In;
-			    timeline->apply(skeleton, animationLast, animationTime, eventBuffer, alpha, timelineBlend, direction);
-			}
-		}
 	}
+	applyTimelines(*from, skeleton, timelineMix);
+	float animationTime = timelineMix.time;
 
 	if (to->_mixDuration > 0) {
 		queueEvents(from, animationTime);
@@ -873,8 +1054,8 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	return mix;
 }
 
-void AnimationState::setAttachment(Skeleton& skeleton, Slot& slot, const String& attachmentName, bool attachments) {
-    slot.setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentName));
+void AnimationState::setAttachment(Skeleton& skeleton, Slot& slot, int attachmentKey, const String& attachmentName, bool attachments) {
+    slot.setAttachment(skeleton.getAttachment(slot.getData().getIndex(), attachmentKey, attachmentName));
     if (attachments) slot.setAttachmentState(_unkeyedState + Current);
 }
 
@@ -967,6 +1148,15 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	entry._mixTime = 0;
 	entry._mixDuration = (last == NULL) ? 0 : _data->getMix(last->_animation, animation);
 
+	entry._timelineMode.ensureCapacity(_timelineCapacity);
+	entry._timelineHoldMix.ensureCapacity(_timelineCapacity);
+	entry._timelinesRotation.ensureCapacity(_timelineCapacity << 1);
+	entry._frameCursors.ensureCapacity(_timelineCapacity);
+	entry._timelineOrder.ensureCapacity(_timelineCapacity);
+	entry._timelineRuns.ensureCapacity((OtherTimelines + 1) << 1);
+	entry._frameCursors.clear();
+	entry._frameCursors.setSize(animation->getTimelines().size(), 0);
+
 	return entryP;
 }
 
@@ -992,6 +1182,7 @@ void AnimationState::animationsChanged() {
 			entry = entry->_mixingFrom;
 
 		do {
+			groupTimelines(entry);
 			if (entry->_mixingTo == NULL || entry->_mixBlend != MixBlend_Add) computeHold(entry);
 			entry = entry->_mixingTo;
 		} while (entry != NULL);
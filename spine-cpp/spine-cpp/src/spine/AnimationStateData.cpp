@@ -83,3 +83,8 @@ AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) :
 bool AnimationStateData::AnimationPair::operator==(const AnimationPair &other) const {
 	return _a1->_name == other._a1->_name && _a2->_name == other._a2->_name;
 }
+
+size_t AnimationStateData::AnimationPair::hash() const {
+	// Pairs are equal by animation names, see operator==.
+	return hashKey(_a1->_name) * 31 + hashKey(_a2->_name);
+}
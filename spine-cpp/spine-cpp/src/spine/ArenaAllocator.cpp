@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/ArenaAllocator.h>
+
+#include <spine/Extension.h>
+
+#include <string.h>
+
+using namespace spine;
+
+// Each allocation is prefixed by its size and aligned to 8 bytes.
+static const size_t HEADER_SIZE = 8;
+static const size_t MAX_BLOCK_SIZE = 1024 * 1024;
+
+static size_t alignSize(size_t size) {
+	return (size + 7) & ~(size_t) 7;
+}
+
+#ifndef SPINE_NO_THREADS
+static thread_local ArenaAllocator *currentArena = NULL;
+#else
+static ArenaAllocator *currentArena = NULL;
+#endif
+
+ArenaAllocator::ArenaAllocator(size_t blockSize) :
+		_blocks(NULL),
+		_top(NULL),
+		_end(NULL),
+		_last(NULL),
+		_blockSize(alignSize(blockSize)),
+		_blockCount(0),
+		_allocationCount(0),
+		_capacity(0),
+		_previous(NULL),
+		_entered(false) {
+}
+
+ArenaAllocator::~ArenaAllocator() {
+	if (_entered) currentArena = _previous;
+	else if (currentArena == this) currentArena = NULL;
+
+	Block *block = _blocks;
+	while (block) {
+		Block *next = block->next;
+		SpineExtension::getInstance()->_free(block, __FILE__, __LINE__);
+		block = next;
+	}
+}
+
+void *ArenaAllocator::alloc(size_t size, bool clear) {
+	if (size == 0) return NULL;
+
+	size_t needed = HEADER_SIZE + alignSize(size);
+	if ((size_t) (_end - _top) < needed) addBlock(needed);
+
+	*(size_t *) _top = size;
+	char *result = _top + HEADER_SIZE;
+	_top += needed;
+	_last = result;
+	_allocationCount++;
+	if (clear) memset(result, 0, size);
+	return result;
+}
+
+void *ArenaAllocator::realloc(void *ptr, size_t size) {
+	if (!ptr) return alloc(size, false);
+	if (size == 0) {
+		free(ptr);
+		return NULL;
+	}
+
+	size_t *header = (size_t *) ((char *) ptr - HEADER_SIZE);
+	if (ptr == _last) {
+		char *end = (char *) ptr + alignSize(size);
+		if (end <= _end) {
+			*header = size;
+			_top = end;
+			return ptr;
+		}
+	}
+
+	void *result = alloc(size, false);
+	memcpy(result, ptr, *header < size ? *header : size);
+	free(ptr);
+	return result;
+}
+
+void ArenaAllocator::free(void *ptr) {
+	if (ptr == NULL || ptr != _last) return;
+	_top = (char *) ptr - HEADER_SIZE;
+	_last = NULL;
+}
+
+bool ArenaAllocator::owns(void *ptr) {
+	for (Block *block = _blocks; block; block = block->next)
+		if ((char *) ptr >= (char *) (block + 1) && (char *) ptr < block->end) return true;
+	return false;
+}
+
+void ArenaAllocator::enterUntilDestroyed() {
+	if (_entered) return;
+	_previous = currentArena == this ? NULL : currentArena;
+	_entered = true;
+	currentArena = this;
+}
+
+size_t ArenaAllocator::getAllocationCount() {
+	return _allocationCount;
+}
+
+size_t ArenaAllocator::getBlockCount() {
+	return _blockCount;
+}
+
+size_t ArenaAllocator::getUsedMemory() {
+	size_t used = 0;
+	for (Block *block = _blocks; block; block = block->next)
+		used += (block == _blocks ? _top : block->end) - (char *) (block + 1);
+	return used;
+}
+
+size_t ArenaAllocator::getCapacity() {
+	return _capacity;
+}
+
+ArenaAllocator *ArenaAllocator::getCurrent() {
+	return currentArena;
+}
+
+void ArenaAllocator::addBlock(size_t size) {
+	size_t blockSize = _blockSize < size ? size : _blockSize;
+	Block *block = (Block *) SpineExtension::getInstance()->_alloc(sizeof(Block) + blockSize, __FILE__, __LINE__);
+	block->end = (char *) (block + 1) + blockSize;
+	_top = (char *) (block + 1);
+	_end = block->end;
+	_last = NULL;
+	_blockCount++;
+	_capacity += blockSize;
+	if (_blockSize < MAX_BLOCK_SIZE) _blockSize <<= 1;
+	block->next = _blocks;
+	_blocks = block;
+}
+
+void ArenaAllocator::setCurrent(ArenaAllocator *arena) {
+	currentArena = arena;
+}
+
+ArenaScope::ArenaScope(ArenaAllocator *arena) : _previous(ArenaAllocator::getCurrent()) {
+	ArenaAllocator::setCurrent(arena);
+}
+
+ArenaScope::~ArenaScope() {
+	ArenaAllocator::setCurrent(_previous);
+}
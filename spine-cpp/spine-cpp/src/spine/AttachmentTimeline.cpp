@@ -57,12 +57,15 @@ AttachmentTimeline::AttachmentTimeline(int frameCount) : Timeline(), _slotIndex(
 	}
 }
 
-void AttachmentTimeline::setAttachment(Skeleton& skeleton, Slot& slot, String* attachmentName) {
-    slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+	MixBlend blend, MixDirection direction
+) {
+	int frameCursor = 0;
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction, frameCursor);
 }
 
 void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
-	MixBlend blend, MixDirection direction
+	MixBlend blend, MixDirection direction, int &frameCursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -70,21 +73,20 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 
 	assert(_slotIndex < skeleton._slots.size());
 
-	String *attachmentName;
 	Slot *slotP = skeleton._slots[_slotIndex];
 	Slot &slot = *slotP;
 	if (!slot._bone.isActive()) return;
 
 	if (direction == MixDirection_Out) {
-	    if (blend == MixBlend_Setup) setAttachment(skeleton, slot, &slot._data._attachmentName);
+		if (blend == MixBlend_Setup)
+			slot.setAttachment(skeleton.getAttachment(_slotIndex, slot._data._attachmentKey, slot._data._attachmentName));
 		return;
 	}
 
 	if (time < _frames[0]) {
 		// Time is before first frame.
-		if (blend == MixBlend_Setup || blend == MixBlend_First) {
-            setAttachment(skeleton, slot, &slot._data._attachmentName);
-		}
+		if (blend == MixBlend_Setup || blend == MixBlend_First)
+			slot.setAttachment(skeleton.getAttachment(_slotIndex, slot._data._attachmentKey, slot._data._attachmentName));
 		return;
 	}
 
@@ -93,11 +95,11 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 		// Time is after last frame.
 		frameIndex = _frames.size() - 1;
 	} else {
-		frameIndex = Animation::binarySearch(_frames, time, 1) - 1;
+		frameIndex = Animation::search(_frames, time, 1, frameCursor) - 1;
 	}
 
-	attachmentName = &_attachmentNames[frameIndex];
-	slot.setAttachment(attachmentName->length() == 0 ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+	int attachmentKey = _attachmentKeys.size() > 0 ? _attachmentKeys[frameIndex] : -1;
+	slot.setAttachment(skeleton.getAttachment(_slotIndex, attachmentKey, _attachmentNames[frameIndex]));
 }
 
 int AttachmentTimeline::getPropertyId() {
@@ -107,6 +109,7 @@ int AttachmentTimeline::getPropertyId() {
 void AttachmentTimeline::setFrame(int frameIndex, float time, const String &attachmentName) {
 	_frames[frameIndex] = time;
 	_attachmentNames[frameIndex] = attachmentName;
+	if (_attachmentKeys.size() > 0) _attachmentKeys[frameIndex] = -1;
 }
 
 size_t AttachmentTimeline::getSlotIndex() {
@@ -125,6 +128,10 @@ Vector<String> &AttachmentTimeline::getAttachmentNames() {
 	return _attachmentNames;
 }
 
+Vector<int> &AttachmentTimeline::getAttachmentKeys() {
+	return _attachmentKeys;
+}
+
 size_t AttachmentTimeline::getFrameCount() {
 	return _frames.size();
 }
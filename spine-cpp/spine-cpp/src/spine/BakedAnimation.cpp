@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/BakedAnimation.h>
+
+#include <spine/Animation.h>
+#include <spine/Bone.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+#include <spine/Timeline.h>
+#include <spine/TimelineType.h>
+
+using namespace spine;
+
+BakedAnimation::BakedAnimation(Skeleton &skeleton, Animation &animation, float frameRate, bool quantize) :
+		_name(animation.getName()),
+		_duration(animation.getDuration()),
+		_framesPerSecond(0),
+		_frameCount(1),
+		_quantized(quantize) {
+	if (_duration > 0 && frameRate > 0) {
+		float segments = _duration * frameRate;
+		_frameCount = (size_t) segments + 1;
+		if (_frameCount - 1 < segments) _frameCount++;
+		_framesPerSecond = (_frameCount - 1) / _duration;
+	}
+
+	/* The components written by the bone timelines. */
+	Vector<int> channels;
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	for (size_t i = 0, n = timelines.size(); i < n; ++i) {
+		int id = timelines[i]->getPropertyId();
+		int boneIndex = id & 0xffffff;
+		switch (id >> 24) {
+			case TimelineType_Rotate:
+				channels.add(boneIndex * 7 + 2);
+				break;
+			case TimelineType_Translate:
+				channels.add(boneIndex * 7);
+				channels.add(boneIndex * 7 + 1);
+				break;
+			case TimelineType_Scale:
+				channels.add(boneIndex * 7 + 3);
+				channels.add(boneIndex * 7 + 4);
+				break;
+			case TimelineType_Shear:
+				channels.add(boneIndex * 7 + 5);
+				channels.add(boneIndex * 7 + 6);
+				break;
+			default:
+				break;
+		}
+	}
+
+	size_t channelCount = channels.size();
+	Vector<float> samples;
+	samples.setSize(_frameCount * channelCount, 0);
+	skeleton.setBonesToSetupPose();
+	for (size_t frame = 0; frame < _frameCount; ++frame) {
+		float time = _frameCount > 1 ? frame * _duration / (_frameCount - 1) : 0;
+		animation.apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		float *values = samples.buffer() + frame * channelCount;
+		for (size_t i = 0; i < channelCount; ++i) {
+			int channel = channels[i];
+			values[i] = getComponent(*skeleton.getBones()[channel / 7], channel % 7);
+		}
+	}
+	skeleton.setBonesToSetupPose();
+
+	/* Channels with the same value in every frame are stored once. */
+	Vector<size_t> sampled;
+	for (size_t i = 0; i < channelCount; ++i) {
+		bool constant = true;
+		for (size_t frame = 1; frame < _frameCount && constant; ++frame)
+			constant = samples[frame * channelCount + i] == samples[i];
+		if (constant) {
+			_constantChannels.add(channels[i]);
+			_constants.add(samples[i]);
+		} else {
+			_channels.add(channels[i]);
+			sampled.add(i);
+		}
+	}
+
+	size_t sampledCount = sampled.size();
+	if (!_quantized) {
+		_frames.setSize(_frameCount * sampledCount, 0);
+		for (size_t frame = 0; frame < _frameCount; ++frame) {
+			for (size_t i = 0; i < sampledCount; ++i)
+				_frames[frame * sampledCount + i] = samples[frame * channelCount + sampled[i]];
+		}
+		return;
+	}
+
+	_offsets.setSize(sampledCount, 0);
+	_scales.setSize(sampledCount, 0);
+	for (size_t i = 0; i < sampledCount; ++i) {
+		float min = samples[sampled[i]], max = min;
+		for (size_t frame = 1; frame < _frameCount; ++frame) {
+			float value = samples[frame * channelCount + sampled[i]];
+			min = MathUtil::min(min, value);
+			max = MathUtil::max(max, value);
+		}
+		_offsets[i] = min;
+		_scales[i] = (max - min) / 65535;
+	}
+	_quantizedFrames.setSize(_frameCount * sampledCount, 0);
+	for (size_t frame = 0; frame < _frameCount; ++frame) {
+		for (size_t i = 0; i < sampledCount; ++i) {
+			float value = samples[frame * channelCount + sampled[i]];
+			_quantizedFrames[frame * sampledCount + i] = (unsigned short) ((value - _offsets[i]) / _scales[i] + 0.5f);
+		}
+	}
+}
+
+void BakedAnimation::apply(Skeleton &skeleton, float time, bool loop) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	for (size_t i = 0, n = _constantChannels.size(); i < n; ++i) {
+		int channel = _constantChannels[i];
+		setComponent(*bones[channel / 7], channel % 7, _constants[i]);
+	}
+
+	size_t channelCount = _channels.size();
+	if (channelCount == 0) return;
+
+	if (loop && _duration != 0) time = MathUtil::fmod(time, _duration);
+	float position = MathUtil::clamp(time, 0, _duration) * _framesPerSecond;
+	size_t frame = (size_t) position;
+	float alpha = position - frame;
+	if (frame >= _frameCount - 1) {
+		frame = _frameCount - 1;
+		alpha = 0;
+	}
+	size_t next = alpha > 0 ? frame + 1 : frame;
+
+	for (size_t i = 0; i < channelCount; ++i) {
+		float value, nextValue;
+		if (_quantized) {
+			value = _offsets[i] + _quantizedFrames[frame * channelCount + i] * _scales[i];
+			nextValue = _offsets[i] + _quantizedFrames[next * channelCount + i] * _scales[i];
+		} else {
+			value = _frames[frame * channelCount + i];
+			nextValue = _frames[next * channelCount + i];
+		}
+		int channel = _channels[i], component = channel % 7;
+		float diff = nextValue - value;
+		/* Rotations are wrapped by the timelines, so take the shortest way between the frames. */
+		if (component == 2) diff -= (16384 - (int) (16384.499999999996 - diff / 360)) * 360;
+		setComponent(*bones[channel / 7], component, value + diff * alpha);
+	}
+}
+
+const String &BakedAnimation::getName() {
+	return _name;
+}
+
+float BakedAnimation::getDuration() {
+	return _duration;
+}
+
+size_t BakedAnimation::getFrameCount() {
+	return _frameCount;
+}
+
+bool BakedAnimation::isQuantized() {
+	return _quantized;
+}
+
+size_t BakedAnimation::getMemorySize() {
+	return sizeof(BakedAnimation) + _name.length() + (_constantChannels.getCapacity() + _channels.getCapacity()) * sizeof(int) +
+		   (_constants.getCapacity() + _frames.getCapacity() + _offsets.getCapacity() + _scales.getCapacity()) * sizeof(float) +
+		   _quantizedFrames.getCapacity() * sizeof(unsigned short);
+}
+
+float BakedAnimation::getComponent(Bone &bone, int component) {
+	switch (component) {
+		case 0:
+			return bone._x;
+		case 1:
+			return bone._y;
+		case 2:
+			return bone._rotation;
+		case 3:
+			return bone._scaleX;
+		case 4:
+			return bone._scaleY;
+		case 5:
+			return bone._shearX;
+		default:
+			return bone._shearY;
+	}
+}
+
+void BakedAnimation::setComponent(Bone &bone, int component, float value) {
+	switch (component) {
+		case 0:
+			bone._x = value;
+			break;
+		case 1:
+			bone._y = value;
+			break;
+		case 2:
+			bone._rotation = value;
+			break;
+		case 3:
+			bone._scaleX = value;
+			break;
+		case 4:
+			bone._scaleY = value;
+			break;
+		case 5:
+			bone._shearX = value;
+			break;
+		default:
+			bone._shearY = value;
+	}
+}
@@ -94,6 +94,8 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 	float pa, pb, pc, pd;
 	Bone *parent = _parent;
 
+	_skeleton._boneMatricesValid = false;
+
 	_ax = x;
 	_ay = y;
 	_arotation = rotation;
@@ -107,10 +109,13 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 		float rotationY = rotation + 90 + shearY;
 		float sx = _skeleton.getScaleX();
 		float sy = _skeleton.getScaleY();
-		_a = MathUtil::cosDeg(rotation + shearX) * scaleX * sx;
-		_b = MathUtil::cosDeg(rotationY) * scaleY * sx;
-		_c = MathUtil::sinDeg(rotation + shearX) * scaleX * sy;
-		_d = MathUtil::sinDeg(rotationY) * scaleY * sy;
+		float sinX, cosX, sinY, cosY;
+		MathUtil::sinCosDeg(rotation + shearX, sinX, cosX);
+		MathUtil::sinCosDeg(rotationY, sinY, cosY);
+		_a = cosX * scaleX * sx;
+		_b = cosY * scaleY * sx;
+		_c = sinX * scaleX * sy;
+		_d = sinY * scaleY * sy;
 		_worldX = x * sx + _skeleton.getX();
 		_worldY = y * sy + _skeleton.getY();
 		return;
@@ -127,10 +132,13 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 	switch (_data.getTransformMode()) {
 	case TransformMode_Normal: {
 		float rotationY = rotation + 90 + shearY;
-		float la = MathUtil::cosDeg(rotation + shearX) * scaleX;
-		float lb = MathUtil::cosDeg(rotationY) * scaleY;
-		float lc = MathUtil::sinDeg(rotation + shearX) * scaleX;
-		float ld = MathUtil::sinDeg(rotationY) * scaleY;
+		float sinX, cosX, sinY, cosY;
+		MathUtil::sinCosDeg(rotation + shearX, sinX, cosX);
+		MathUtil::sinCosDeg(rotationY, sinY, cosY);
+		float la = cosX * scaleX;
+		float lb = cosY * scaleY;
+		float lc = sinX * scaleX;
+		float ld = sinY * scaleY;
 		_a = pa * la + pb * lc;
 		_b = pa * lb + pb * ld;
 		_c = pc * la + pd * lc;
@@ -139,15 +147,18 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 	}
 	case TransformMode_OnlyTranslation: {
 		float rotationY = rotation + 90 + shearY;
-		_a = MathUtil::cosDeg(rotation + shearX) * scaleX;
-		_b = MathUtil::cosDeg(rotationY) * scaleY;
-		_c = MathUtil::sinDeg(rotation + shearX) * scaleX;
-		_d = MathUtil::sinDeg(rotationY) * scaleY;
+		float sinX, cosX, sinY, cosY;
+		MathUtil::sinCosDeg(rotation + shearX, sinX, cosX);
+		MathUtil::sinCosDeg(rotationY, sinY, cosY);
+		_a = cosX * scaleX;
+		_b = cosY * scaleY;
+		_c = sinX * scaleX;
+		_d = sinY * scaleY;
 		break;
 	}
 	case TransformMode_NoRotationOrReflection: {
 		float s = pa * pa + pc * pc;
-		float prx, rx, ry, la, lb, lc, ld;
+		float prx, rx, ry, la, lb, lc, ld, sinX, cosX, sinY, cosY;
 		if (s > 0.0001f) {
 			s = MathUtil::abs(pa * pd - pb * pc) / s;
             pa /= _skeleton.getScaleX();
@@ -162,10 +173,12 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 		}
 		rx = rotation + shearX - prx;
 		ry = rotation + shearY - prx + 90;
-		la = MathUtil::cosDeg(rx) * scaleX;
-		lb = MathUtil::cosDeg(ry) * scaleY;
-		lc = MathUtil::sinDeg(rx) * scaleX;
-		ld = MathUtil::sinDeg(ry) * scaleY;
+		MathUtil::sinCosDeg(rx, sinX, cosX);
+		MathUtil::sinCosDeg(ry, sinY, cosY);
+		la = cosX * scaleX;
+		lb = cosY * scaleY;
+		lc = sinX * scaleX;
+		ld = sinY * scaleY;
 		_a = pa * la - pb * lc;
 		_b = pa * lb - pb * ld;
 		_c = pc * la + pd * lc;
@@ -175,9 +188,8 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 	case TransformMode_NoScale:
 	case TransformMode_NoScaleOrReflection: {
 		float za, zc, s;
-		float r, zb, zd, la, lb, lc, ld;
-		cosine = MathUtil::cosDeg(rotation);
-		sine = MathUtil::sinDeg(rotation);
+		float r, zb, zd, la, lb, lc, ld, sinX, cosX, sinY, cosY;
+		MathUtil::sinCosDeg(rotation, sine, cosine);
 		za = (pa * cosine + pb * sine) / _skeleton.getScaleX();
 		zc = (pc * cosine + pd * sine) / _skeleton.getScaleY();
 		s = MathUtil::sqrt(za * za + zc * zc);
@@ -189,12 +201,15 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 			&& (pa * pd - pb * pc < 0) != (_skeleton.getScaleX() < 0 != _skeleton.getScaleY() < 0))
 			s = -s;
 		r = MathUtil::Pi / 2 + MathUtil::atan2(zc, za);
-		zb = MathUtil::cos(r) * s;
-		zd = MathUtil::sin(r) * s;
-		la = MathUtil::cosDeg(shearX) * scaleX;
-		lb = MathUtil::cosDeg(90 + shearY) * scaleY;
-		lc = MathUtil::sinDeg(shearX) * scaleX;
-		ld = MathUtil::sinDeg(90 + shearY) * scaleY;
+		MathUtil::sinCos(r, zd, zb);
+		zb *= s;
+		zd *= s;
+		MathUtil::sinCosDeg(shearX, sinX, cosX);
+		MathUtil::sinCosDeg(90 + shearY, sinY, cosY);
+		la = cosX * scaleX;
+		lb = cosY * scaleY;
+		lc = sinX * scaleX;
+		ld = sinY * scaleY;
 		_a = za * la + zb * lc;
 		_b = za * lb + zb * ld;
 		_c = zc * la + zd * lc;
@@ -268,6 +283,7 @@ void Bone::rotateWorld(float degrees) {
 	_d = sin * b + cos * d;
 
 	_appliedValid = false;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getWorldToLocalRotationX() {
@@ -436,6 +452,7 @@ float Bone::getA() {
 
 void Bone::setA(float inValue) {
 	_a = inValue;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getB() {
@@ -444,6 +461,7 @@ float Bone::getB() {
 
 void Bone::setB(float inValue) {
 	_b = inValue;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getC() {
@@ -452,6 +470,7 @@ float Bone::getC() {
 
 void Bone::setC(float inValue) {
 	_c = inValue;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getD() {
@@ -460,6 +479,7 @@ float Bone::getD() {
 
 void Bone::setD(float inValue) {
 	_d = inValue;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getWorldX() {
@@ -468,6 +488,7 @@ float Bone::getWorldX() {
 
 void Bone::setWorldX(float inValue) {
 	_worldX = inValue;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getWorldY() {
@@ -476,6 +497,7 @@ float Bone::getWorldY() {
 
 void Bone::setWorldY(float inValue) {
 	_worldY = inValue;
+	_skeleton._boneMatricesValid = false;
 }
 
 float Bone::getWorldRotationX() {
@@ -0,0 +1,231 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/BonePoseStore.h>
+
+#include <spine/SkeletonData.h>
+#include <spine/Bone.h>
+#include <spine/MathUtil.h>
+
+#if !defined(SPINE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPINE_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SPINE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+using namespace spine;
+
+/* Minimax polynomials for sin and cos on [-pi/4, pi/4], max error of about 1e-7 (Cephes sinf/cosf). */
+#define SIN_P0 -1.9515295891e-4f
+#define SIN_P1 8.3321608736e-3f
+#define SIN_P2 -1.6666654611e-1f
+#define COS_P0 2.443315711809948e-5f
+#define COS_P1 -1.388731625493765e-3f
+#define COS_P2 4.166664568298827e-2f
+
+/* Computes the sine and cosine of 4 angles in degrees. The angle is reduced to [-45, 45] degrees in degrees, which is exact for
+ * the multiples of 90 used, then evaluated with the polynomials and the results are swapped and negated by quadrant. */
+#if defined(SPINE_SIMD_SSE2)
+static inline void sinCosDeg4(const float *degrees, float *outSin, float *outCos) {
+	__m128 x = _mm_loadu_ps(degrees);
+	__m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1 / 90.0f)));
+	__m128 r = _mm_sub_ps(x, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90)));
+	r = _mm_mul_ps(r, _mm_set1_ps(MathUtil::Deg_Rad));
+	__m128 r2 = _mm_mul_ps(r, r);
+
+	__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_P0), r2), _mm_set1_ps(SIN_P1));
+	s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(SIN_P2));
+	s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+	__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_P0), r2), _mm_set1_ps(COS_P1));
+	c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(COS_P2));
+	c = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(c, r2), r2), _mm_sub_ps(_mm_set1_ps(1), _mm_mul_ps(r2, _mm_set1_ps(0.5f))));
+
+	__m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+	__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+	__m128 sine = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+	__m128 cosine = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+	sine = _mm_xor_ps(sine, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30)));
+	cosine = _mm_xor_ps(cosine, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30)));
+	_mm_storeu_ps(outSin, sine);
+	_mm_storeu_ps(outCos, cosine);
+}
+#elif defined(SPINE_SIMD_NEON)
+static inline void sinCosDeg4(const float *degrees, float *outSin, float *outCos) {
+	float32x4_t x = vld1q_f32(degrees);
+	float32x4_t q = vmulq_n_f32(x, 1 / 90.0f);
+	/* Round to nearest, vcvtq_s32_f32 truncates. */
+	uint32x4_t negative = vcltq_f32(q, vdupq_n_f32(0));
+	q = vaddq_f32(q, vbslq_f32(negative, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f)));
+	int32x4_t quadrant = vcvtq_s32_f32(q);
+	float32x4_t r = vsubq_f32(x, vmulq_n_f32(vcvtq_f32_s32(quadrant), 90));
+	r = vmulq_n_f32(r, MathUtil::Deg_Rad);
+	float32x4_t r2 = vmulq_f32(r, r);
+
+	float32x4_t s = vaddq_f32(vmulq_n_f32(r2, SIN_P0), vdupq_n_f32(SIN_P1));
+	s = vaddq_f32(vmulq_f32(s, r2), vdupq_n_f32(SIN_P2));
+	s = vaddq_f32(vmulq_f32(vmulq_f32(s, r2), r), r);
+
+	float32x4_t c = vaddq_f32(vmulq_n_f32(r2, COS_P0), vdupq_n_f32(COS_P1));
+	c = vaddq_f32(vmulq_f32(c, r2), vdupq_n_f32(COS_P2));
+	c = vaddq_f32(vmulq_f32(vmulq_f32(c, r2), r2), vsubq_f32(vdupq_n_f32(1), vmulq_n_f32(r2, 0.5f)));
+
+	int32x4_t one = vdupq_n_s32(1), two = vdupq_n_s32(2);
+	uint32x4_t swap = vceqq_s32(vandq_s32(quadrant, one), one);
+	float32x4_t sine = vbslq_f32(swap, c, s);
+	float32x4_t cosine = vbslq_f32(swap, s, c);
+	uint32x4_t sineSign = vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(quadrant, two), 30));
+	uint32x4_t cosineSign = vreinterpretq_u32_s32(vshlq_n_s32(vandq_s32(vaddq_s32(quadrant, one), two), 30));
+	sine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(sine), sineSign));
+	cosine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(cosine), cosineSign));
+	vst1q_f32(outSin, sine);
+	vst1q_f32(outCos, cosine);
+}
+#else
+static inline void sinCosDeg4(const float *degrees, float *outSin, float *outCos) {
+	for (int i = 0; i < 4; ++i) {
+		float x = degrees[i];
+		float q = x * (1 / 90.0f);
+		int quadrant = (int) (q < 0 ? q - 0.5f : q + 0.5f);
+		float r = (x - quadrant * 90.0f) * MathUtil::Deg_Rad;
+		float r2 = r * r;
+		float s = ((SIN_P0 * r2 + SIN_P1) * r2 + SIN_P2) * r2 * r + r;
+		float c = ((COS_P0 * r2 + COS_P1) * r2 + COS_P2) * r2 * r2 + (1 - r2 * 0.5f);
+		if (quadrant & 1) {
+			float t = s;
+			s = c;
+			c = t;
+		}
+		outSin[i] = (quadrant & 2) ? -s : s;
+		outCos[i] = ((quadrant + 1) & 2) ? -c : c;
+	}
+}
+#endif
+
+BonePoseStore::BonePoseStore(SkeletonData &data) : _boneCount(data.getBones().size()) {
+	_components.setSize(_boneCount * BonePoseComponent_Count, 0);
+
+	float *components = _components.buffer();
+	_a = components + BonePoseComponent_A * _boneCount;
+	_b = components + BonePoseComponent_B * _boneCount;
+	_worldX = components + BonePoseComponent_WorldX * _boneCount;
+	_c = components + BonePoseComponent_C * _boneCount;
+	_d = components + BonePoseComponent_D * _boneCount;
+	_worldY = components + BonePoseComponent_WorldY * _boneCount;
+}
+
+size_t BonePoseStore::getBoneCount() {
+	return _boneCount;
+}
+
+float *BonePoseStore::getComponent(BonePoseComponent component) {
+	return _components.buffer() + component * _boneCount;
+}
+
+void BonePoseStore::updateWorldTransforms(Vector<Bone *> &bones, const int *boneIndices, size_t count, float skeletonX,
+	float skeletonY, float skeletonScaleX, float skeletonScaleY) {
+	/* The first BatchSize angles are rotation + shearX, the second rotation + 90 + shearY. */
+	float angles[BatchSize * 2], sines[BatchSize * 2], cosines[BatchSize * 2];
+
+	while (count > 0) {
+		size_t n = count;
+		if (n > BatchSize) n = BatchSize;
+		size_t padded = (n + 3) & ~(size_t) 3;
+
+		for (size_t k = 0; k < n; ++k) {
+			Bone &bone = *bones[boneIndices[k]];
+			float rotation = bone._rotation;
+			bone._ax = bone._x;
+			bone._ay = bone._y;
+			bone._arotation = rotation;
+			bone._ascaleX = bone._scaleX;
+			bone._ascaleY = bone._scaleY;
+			bone._ashearX = bone._shearX;
+			bone._ashearY = bone._shearY;
+			bone._appliedValid = true;
+			angles[k] = rotation + bone._shearX;
+			angles[BatchSize + k] = rotation + 90 + bone._shearY;
+		}
+		for (size_t k = n; k < padded; ++k) {
+			angles[k] = 0;
+			angles[BatchSize + k] = 0;
+		}
+
+		for (size_t k = 0; k < padded; k += 4) {
+			sinCosDeg4(angles + k, sines + k, cosines + k);
+			sinCosDeg4(angles + BatchSize + k, sines + BatchSize + k, cosines + BatchSize + k);
+		}
+
+		for (size_t k = 0; k < n; ++k) {
+			int i = boneIndices[k];
+			Bone &bone = *bones[i];
+			float x = bone._x, y = bone._y, scaleX = bone._scaleX, scaleY = bone._scaleY;
+			float la = cosines[k] * scaleX;
+			float lb = cosines[BatchSize + k] * scaleY;
+			float lc = sines[k] * scaleX;
+			float ld = sines[BatchSize + k] * scaleY;
+
+			Bone *parent = bone._parent;
+			if (!parent) { /* Root bone. */
+				bone._a = la * skeletonScaleX;
+				bone._b = lb * skeletonScaleX;
+				bone._c = lc * skeletonScaleY;
+				bone._d = ld * skeletonScaleY;
+				bone._worldX = x * skeletonScaleX + skeletonX;
+				bone._worldY = y * skeletonScaleY + skeletonY;
+			} else {
+				float pa = parent->_a, pb = parent->_b, pc = parent->_c, pd = parent->_d;
+				bone._worldX = pa * x + pb * y + parent->_worldX;
+				bone._worldY = pc * x + pd * y + parent->_worldY;
+				bone._a = pa * la + pb * lc;
+				bone._b = pa * lb + pb * ld;
+				bone._c = pc * la + pd * lc;
+				bone._d = pc * lb + pd * ld;
+			}
+
+			_a[i] = bone._a;
+			_b[i] = bone._b;
+			_c[i] = bone._c;
+			_d[i] = bone._d;
+			_worldX[i] = bone._worldX;
+			_worldY[i] = bone._worldY;
+		}
+
+		boneIndices += n;
+		count -= n;
+	}
+}
@@ -63,6 +63,13 @@ ColorTimeline::ColorTimeline(int frameCount) : CurveTimeline(frameCount), _slotI
 
 void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 	MixBlend blend, MixDirection direction
+) {
+	int frameCursor = 0;
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction, frameCursor);
+}
+
+void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+	MixBlend blend, MixDirection direction, int &frameCursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -96,7 +103,7 @@ void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 		a = _frames[i + PREV_A];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		size_t frame = (size_t)Animation::binarySearch(_frames, time, ENTRIES);
+		size_t frame = (size_t)Animation::search(_frames, time, ENTRIES, frameCursor);
 		r = _frames[frame + PREV_R];
 		g = _frames[frame + PREV_G];
 		b = _frames[frame + PREV_B];
@@ -44,7 +44,7 @@ const float CurveTimeline::STEPPED = 1;
 const float CurveTimeline::BEZIER = 2;
 const int CurveTimeline::BEZIER_SIZE = 10 * 2 - 1;
 
-CurveTimeline::CurveTimeline(int frameCount) {
+CurveTimeline::CurveTimeline(int frameCount) : _curveLookupSize(0) {
 	assert(frameCount > 0);
 
 	_curves.setSize((frameCount - 1) * BEZIER_SIZE, 0);
@@ -85,6 +85,26 @@ void CurveTimeline::setCurve(size_t frameIndex, float cx1, float cy1, float cx2,
 		x += dfx;
 		y += dfy;
 	}
+
+	if (_curveLookupSize > 0) sampleCurve(frameIndex);
+}
+
+void CurveTimeline::getCurve(size_t frameIndex, float &cx1, float &cy1, float &cx2, float &cy2) {
+	// The first 3 points are dfx, 2 * dfx + ddfx and 3 * dfx + 3 * ddfx + dddfx, see setCurve().
+	const float *curves = _curves.buffer() + frameIndex * BEZIER_SIZE + 1;
+	double c[2][2];
+	for (int i = 0; i < 2; i++) {
+		double p1 = curves[i], p2 = curves[i + 2], p3 = curves[i + 4];
+		double dddf = p3 - 3 * p2 + 3 * p1, ddf = p2 - 2 * p1;
+		double c1MinusC2 = (dddf / 0.006f - 1) / 3; // dddf = ((c1 - c2) * 3 + 1) * 0.006
+		double c2Minus2C1 = (ddf - dddf) / 2 / 0.03f; // ddf = (-c1 * 2 + c2) * 0.03 * 2 + dddf
+		c[i][0] = -(c1MinusC2 + c2Minus2C1);
+		c[i][1] = c[i][0] - c1MinusC2;
+	}
+	cx1 = (float) c[0][0];
+	cy1 = (float) c[1][0];
+	cx2 = (float) c[0][1];
+	cy2 = (float) c[1][1];
 }
 
 float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
@@ -100,7 +120,20 @@ float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
 		return 0;
 	}
 
-	i++;
+	if (_curveLookupSize > 0) {
+		float *lookup = _curveLookup.buffer() + frameIndex * (_curveLookupSize + 1);
+		float position = percent * _curveLookupSize;
+		size_t index = (size_t) position;
+		if (index == _curveLookupSize) return lookup[index];
+		float y = lookup[index];
+		return y + (lookup[index + 1] - y) * (position - index);
+	}
+
+	return scanCurve(frameIndex, percent);
+}
+
+float CurveTimeline::scanCurve(size_t frameIndex, float percent) {
+	size_t i = frameIndex * BEZIER_SIZE + 1;
 	float x = 0;
 	for (size_t start = i, n = i + BEZIER_SIZE - 1; i < n; i += 2) {
 		x = _curves[i];
@@ -125,3 +158,25 @@ float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
 float CurveTimeline::getCurveType(size_t frameIndex) {
 	return _curves[frameIndex * BEZIER_SIZE];
 }
+
+void CurveTimeline::setCurveLookupSize(size_t size) {
+	if (size == _curveLookupSize) return;
+	_curveLookupSize = size;
+	_curveLookup.clear();
+	if (size == 0) return;
+
+	size_t frameCount = getFrameCount() - 1;
+	_curveLookup.setSize(frameCount * (size + 1), 0);
+	for (size_t frameIndex = 0; frameIndex < frameCount; frameIndex++)
+		if (getCurveType(frameIndex) == BEZIER) sampleCurve(frameIndex);
+}
+
+size_t CurveTimeline::getCurveLookupSize() {
+	return _curveLookupSize;
+}
+
+void CurveTimeline::sampleCurve(size_t frameIndex) {
+	float *lookup = _curveLookup.buffer() + frameIndex * (_curveLookupSize + 1);
+	for (size_t i = 0; i <= _curveLookupSize; i++)
+		lookup[i] = scanCurve(frameIndex, (float) i / _curveLookupSize);
+}
@@ -48,7 +48,98 @@ using namespace spine;
 
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
-DeformTimeline::DeformTimeline(int frameCount) : CurveTimeline(frameCount), _slotIndex(0), _attachment(NULL) {
+namespace {
+	struct FloatVertices {
+		const float *vertices;
+
+		inline float get(size_t i) const { return vertices[i]; }
+	};
+
+	struct QuantizedVertices {
+		const unsigned short *vertices;
+		float offset, scale;
+
+		inline float get(size_t i) const { return offset + vertices[i] * scale; }
+	};
+}
+
+/// Interpolates between the vertices of two frames and blends the result into the deform vertices. Templated on the vertex
+/// storage so decoding quantized vertices is inlined in the loops.
+template<typename V>
+static void applyVertices(Vector<float> &deform, VertexAttachment &attachment, size_t vertexCount, const V &prevVertices,
+	const V &nextVertices, float percent, float alpha, MixBlend blend
+) {
+	if (alpha == 1) {
+		if (blend == MixBlend_Add) {
+			if (attachment.getBones().size() == 0) {
+				// Unweighted vertex positions, no alpha.
+				Vector<float> &setupVertices = attachment.getVertices();
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices.get(i);
+					deform[i] += prev + (nextVertices.get(i) - prev) * percent - setupVertices[i];
+				}
+			} else {
+				// Weighted deform offsets, no alpha.
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices.get(i);
+					deform[i] += prev + (nextVertices.get(i) - prev) * percent;
+				}
+			}
+		} else {
+			// Vertex positions or deform offsets, no alpha.
+			for (size_t i = 0; i < vertexCount; i++) {
+				float prev = prevVertices.get(i);
+				deform[i] = prev + (nextVertices.get(i) - prev) * percent;
+			}
+		}
+	} else {
+		switch (blend) {
+		case MixBlend_Setup: {
+			if (attachment.getBones().size() == 0) {
+				// Unweighted vertex positions, with alpha.
+				Vector<float> &setupVertices = attachment.getVertices();
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices.get(i), setup = setupVertices[i];
+					deform[i] = setup + (prev + (nextVertices.get(i) - prev) * percent - setup) * alpha;
+				}
+			} else {
+				// Weighted deform offsets, with alpha.
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices.get(i);
+					deform[i] = (prev + (nextVertices.get(i) - prev) * percent) * alpha;
+				}
+			}
+			break;
+		}
+		case MixBlend_First:
+		case MixBlend_Replace:
+			// Vertex positions or deform offsets, with alpha.
+			for (size_t i = 0; i < vertexCount; i++) {
+				float prev = prevVertices.get(i);
+				deform[i] += (prev + (nextVertices.get(i) - prev) * percent - deform[i]) * alpha;
+			}
+			break;
+		case MixBlend_Add:
+			if (attachment.getBones().size() == 0) {
+				// Unweighted vertex positions, with alpha.
+				Vector<float> &setupVertices = attachment.getVertices();
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices.get(i);
+					deform[i] += (prev + (nextVertices.get(i) - prev) * percent - setupVertices[i]) * alpha;
+				}
+			} else {
+				// Weighted deform offsets, with alpha.
+				for (size_t i = 0; i < vertexCount; i++) {
+					float prev = prevVertices.get(i);
+					deform[i] += (prev + (nextVertices.get(i) - prev) * percent) * alpha;
+				}
+			}
+		}
+	}
+}
+
+DeformTimeline::DeformTimeline(int frameCount) : CurveTimeline(frameCount), _slotIndex(0), _quantizedOffset(0),
+	_quantizedScale(0), _attachment(NULL) {
 	_frames.ensureCapacity(frameCount);
 	_frameVertices.ensureCapacity(frameCount);
 
@@ -62,6 +153,13 @@ DeformTimeline::DeformTimeline(int frameCount) : CurveTimeline(frameCount), _slo
 
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 	MixBlend blend, MixDirection direction
+) {
+	int frameCursor = 0;
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction, frameCursor);
+}
+
+void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+	MixBlend blend, MixDirection direction, int &frameCursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -86,10 +184,9 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		blend = MixBlend_Setup;
 	}
 
-	Vector< Vector<float> > &frameVertices = _frameVertices;
-	size_t vertexCount = frameVertices[0].size();
-
 	Vector<float> &frames = _frames;
+	size_t vertexCount = _quantizedVertices.size() > 0 ? _quantizedVertices.size() / frames.size() : _frameVertices[0].size();
+
 	if (time < _frames[0]) {
 		switch (blend) {
 		case MixBlend_Setup:
@@ -121,144 +218,35 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	deformArray.setSize(vertexCount, 0);
-	Vector<float> &deform = deformArray;
 
+	size_t prevFrame, nextFrame;
+	float percent;
 	if (time >= frames[frames.size() - 1]) { // Time is after last frame.
-		Vector<float> &lastVertices = frameVertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment*>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
-			}
-		} else {
-			switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float setup = setupVertices[i];
-						deform[i] = setup + (lastVertices[i] - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] = lastVertices[i] * alpha;
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++)
-					deform[i] += (lastVertices[i] - deform[i]) * alpha;
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-				} else {
-					// Weighted deform offsets, alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] * alpha;
-				}
-			}
+		prevFrame = nextFrame = frames.size() - 1;
+		percent = 0;
+		if (alpha == 1 && blend != MixBlend_Add && _quantizedVertices.size() == 0) {
+			// Vertex positions or deform offsets, no alpha.
+			memcpy(deformArray.buffer(), _frameVertices[prevFrame].buffer(), vertexCount * sizeof(float));
+			return;
 		}
-		return;
+	} else {
+		// Interpolate between the previous frame and the current frame.
+		int frame = Animation::search(frames, time, frameCursor);
+		prevFrame = frame - 1;
+		nextFrame = frame;
+		float frameTime = frames[frame];
+		percent = getCurvePercent(frame - 1, 1 - (time - frameTime) / (frames[frame - 1] - frameTime));
 	}
 
-	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::binarySearch(frames, time);
-	Vector<float> &prevVertices = frameVertices[frame - 1];
-	Vector<float> &nextVertices = frameVertices[frame];
-	float frameTime = frames[frame];
-	float percent = getCurvePercent(frame - 1, 1 - (time - frameTime) / (frames[frame - 1] - frameTime));
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
-			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
-			}
-		}
+	if (_quantizedVertices.size() > 0) {
+		const unsigned short *vertices = _quantizedVertices.buffer();
+		QuantizedVertices prevVertices = {vertices + prevFrame * vertexCount, _quantizedOffset, _quantizedScale};
+		QuantizedVertices nextVertices = {vertices + nextFrame * vertexCount, _quantizedOffset, _quantizedScale};
+		applyVertices(deformArray, *attachment, vertexCount, prevVertices, nextVertices, percent, alpha, blend);
 	} else {
-		switch (blend) {
-		case MixBlend_Setup: {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, with alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i], setup = setupVertices[i];
-					deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-				}
-			} else {
-				// Weighted deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-				}
-			}
-			break;
-		}
-		case MixBlend_First:
-		case MixBlend_Replace:
-			// Vertex positions or deform offsets, with alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-			}
-			break;
-		case MixBlend_Add:
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, with alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-				}
-			} else {
-				// Weighted deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-				}
-			}
-		}
+		FloatVertices prevVertices = {_frameVertices[prevFrame].buffer()};
+		FloatVertices nextVertices = {_frameVertices[nextFrame].buffer()};
+		applyVertices(deformArray, *attachment, vertexCount, prevVertices, nextVertices, percent, alpha, blend);
 	}
 }
 
@@ -296,3 +284,51 @@ VertexAttachment *DeformTimeline::getAttachment() {
 void DeformTimeline::setAttachment(VertexAttachment *inValue) {
 	_attachment = inValue;
 }
+
+void DeformTimeline::quantizeVertices() {
+	if (_quantizedVertices.size() > 0) return;
+	size_t frameCount = _frameVertices.size(), vertexCount = _frameVertices[0].size();
+	if (vertexCount == 0) return;
+	for (size_t frame = 1; frame < frameCount; frame++)
+		if (_frameVertices[frame].size() != vertexCount) return;
+
+	float min = _frameVertices[0][0], max = min;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		Vector<float> &vertices = _frameVertices[frame];
+		for (size_t i = 0; i < vertexCount; i++) {
+			float value = vertices[i];
+			if (value < min) min = value;
+			if (value > max) max = value;
+		}
+	}
+	_quantizedOffset = min;
+	_quantizedScale = (max - min) / 65535;
+	float invScale = _quantizedScale > 0 ? 1 / _quantizedScale : 0;
+
+	_quantizedVertices.setSize(frameCount * vertexCount, 0);
+	unsigned short *quantized = _quantizedVertices.buffer();
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		Vector<float> &vertices = _frameVertices[frame];
+		for (size_t i = 0; i < vertexCount; i++) {
+			float value = (vertices[i] - min) * invScale + 0.5f;
+			*quantized++ = (unsigned short) (value > 65535 ? 65535 : value);
+		}
+	}
+	_frameVertices.clear();
+}
+
+bool DeformTimeline::isQuantized() {
+	return _quantizedVertices.size() > 0;
+}
+
+Vector<unsigned short> &DeformTimeline::getQuantizedVertices() {
+	return _quantizedVertices;
+}
+
+float DeformTimeline::getQuantizedOffset() {
+	return _quantizedOffset;
+}
+
+float DeformTimeline::getQuantizedScale() {
+	return _quantizedScale;
+}
@@ -60,6 +60,13 @@ EventTimeline::~EventTimeline() {
 
 void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 	MixBlend blend, MixDirection direction
+) {
+	int frameCursor = 0;
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction, frameCursor);
+}
+
+void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+	MixBlend blend, MixDirection direction, int &frameCursor
 ) {
 	if (pEvents == NULL) return;
 
@@ -82,7 +89,7 @@ void EventTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	if (lastTime < _frames[0]) {
 		frame = 0;
 	} else {
-		frame = Animation::binarySearch(_frames, lastTime);
+		frame = Animation::search(_frames, lastTime, frameCursor);
 		float frameTime = _frames[frame];
 		while (frame > 0) {
 			// Fire multiple events with the same frame.
@@ -33,9 +33,21 @@
 
 #include <spine/Extension.h>
 #include <spine/SpineString.h>
+#include <spine/ArenaAllocator.h>
 
 #include <assert.h>
 
+#if defined(_WIN32) && !defined(SPINE_NO_MMAP)
+#define SPINE_NO_MMAP
+#endif
+
+#ifndef SPINE_NO_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
@@ -53,6 +65,36 @@ SpineExtension *SpineExtension::getInstance() {
 	return _instance;
 }
 
+void *SpineExtension::allocate(size_t size, bool clear, const char *file, int line) {
+	ArenaAllocator *arena = ArenaAllocator::getCurrent();
+	if (arena) return arena->alloc(size, clear);
+	return clear ? getInstance()->_calloc(size, file, line) : getInstance()->_alloc(size, file, line);
+}
+
+void *SpineExtension::reallocate(void *ptr, size_t size, const char *file, int line) {
+	ArenaAllocator *arena = ArenaAllocator::getCurrent();
+	if (arena && (ptr == NULL || arena->owns(ptr))) return arena->realloc(ptr, size);
+	return getInstance()->_realloc(ptr, size, file, line);
+}
+
+void SpineExtension::deallocate(void *ptr, const char *file, int line) {
+	ArenaAllocator *arena = ArenaAllocator::getCurrent();
+	if (arena && arena->owns(ptr))
+		arena->free(ptr);
+	else
+		getInstance()->_free(ptr, file, line);
+}
+
+const char *SpineExtension::_mapFile(const String &path, int *length) {
+	return _readFile(path, length);
+}
+
+void SpineExtension::_unmapFile(const char *data, int length) {
+	SP_UNUSED(length);
+
+	SpineExtension::free(data, __FILE__, __LINE__);
+}
+
 SpineExtension::~SpineExtension() {
 }
 
@@ -125,3 +167,42 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
+
+MappedFileExtension::MappedFileExtension() : DefaultSpineExtension() {
+}
+
+MappedFileExtension::~MappedFileExtension() {
+}
+
+const char *MappedFileExtension::_mapFile(const String &path, int *length) {
+#ifdef SPINE_NO_MMAP
+	return SpineExtension::_mapFile(path, length);
+#else
+	*length = 0;
+	int file = open(path.buffer(), O_RDONLY);
+	if (file == -1) return 0;
+
+	struct stat info;
+	if (fstat(file, &info) == -1 || info.st_size <= 0) {
+		close(file);
+		return 0;
+	}
+
+	void *data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return 0;
+
+	// The loaders read the file once from start to end.
+	madvise(data, (size_t) info.st_size, MADV_SEQUENTIAL);
+	*length = (int) info.st_size;
+	return (const char *) data;
+#endif
+}
+
+void MappedFileExtension::_unmapFile(const char *data, int length) {
+#ifdef SPINE_NO_MMAP
+	SpineExtension::_unmapFile(data, length);
+#else
+	if (data) munmap((void *) data, (size_t) length);
+#endif
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/InfluenceBuckets.h>
+
+#include <assert.h>
+
+using namespace spine;
+
+InfluenceBuckets::InfluenceBuckets(Vector<size_t> &bones, Vector<float> &vertices) {
+	const int lastBucket = BucketCount - 1;
+	size_t counts[BucketCount] = {0};
+	size_t maxWidth = 0;
+	for (size_t v = 0, n = bones.size(); v < n; v += bones[v] + 1) {
+		size_t width = bones[v];
+		counts[width < BucketCount ? width - 1 : lastBucket]++;
+		if (width > maxWidth) maxWidth = width;
+	}
+
+	for (int i = 0; i < BucketCount; ++i) {
+		Bucket &bucket = _buckets[i];
+		size_t padded = (counts[i] + 3) & ~(size_t) 3;
+		bucket.width = i < lastBucket ? i + 1 : maxWidth;
+		bucket.vertexCount = 0;
+		bucket.bones.setSize(padded * bucket.width, 0);
+		bucket.vertices.setSize(padded * bucket.width * 3, 0);
+		bucket.influences.setSize(padded * bucket.width, 0);
+		bucket.remap.setSize(padded, -1);
+	}
+
+	int vertexIndex = 0, influence = 0;
+	for (size_t v = 0, n = bones.size(); v < n; vertexIndex++) {
+		size_t width = bones[v++];
+		assert(width > 0);
+		Bucket &bucket = _buckets[width < BucketCount ? width - 1 : lastBucket];
+		size_t index = bucket.vertexCount++, lane = index & 3;
+		bucket.remap[index] = vertexIndex;
+		/* The values of influence i of the vertex, 4 apart because they are interleaved with the other vertices of the group. */
+		size_t entry = (index - lane) * bucket.width + lane;
+		int firstInfluence = influence;
+		for (size_t i = 0; i < bucket.width; ++i, entry += 4) {
+			if (i < width) {
+				bucket.bones[entry] = (int) bones[v + i];
+				bucket.vertices[entry * 3 - lane * 2] = vertices[influence * 3];
+				bucket.vertices[entry * 3 - lane * 2 + 4] = vertices[influence * 3 + 1];
+				bucket.vertices[entry * 3 - lane * 2 + 8] = vertices[influence * 3 + 2];
+				bucket.influences[entry] = influence++;
+			} else {
+				// Padding reuses the first influence of the vertex with no weight.
+				bucket.bones[entry] = (int) bones[v];
+				bucket.influences[entry] = firstInfluence;
+			}
+		}
+		v += width;
+	}
+}
+
+size_t InfluenceBuckets::getWidth(int bucket) {
+	return _buckets[bucket].width;
+}
+
+size_t InfluenceBuckets::getVertexCount(int bucket) {
+	return _buckets[bucket].vertexCount;
+}
+
+Vector<int> &InfluenceBuckets::getBones(int bucket) {
+	return _buckets[bucket].bones;
+}
+
+Vector<float> &InfluenceBuckets::getVertices(int bucket) {
+	return _buckets[bucket].vertices;
+}
+
+Vector<int> &InfluenceBuckets::getInfluences(int bucket) {
+	return _buckets[bucket].influences;
+}
+
+Vector<int> &InfluenceBuckets::getRemap(int bucket) {
+	return _buckets[bucket].remap;
+}
@@ -57,9 +57,24 @@ const int Json::JSON_OBJECT = 6;
 
 const char *Json::_error = NULL;
 
+/* The first block holds about 2K items, each further block doubles the size up to MAX_BLOCK_SIZE. */
+static const size_t MIN_BLOCK_SIZE = 128 * 1024;
+static const size_t MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+
+/* Exact powers of ten, larger ones are not representable in a double. */
+static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+									1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+struct Json::Block {
+	Block *next;
+	char *top;
+	char *end;
+};
+
 Json *Json::getItem(Json *object, const char *string) {
+	unsigned int nameHash = hash(string);
 	Json *c = object->_child;
-	while (c && json_strcasecmp(c->_name, string)) {
+	while (c && (c->_nameHash != nameHash || json_strcasecmp(c->_name, string))) {
 		c = c->_next;
 	}
 	return c;
@@ -88,7 +103,8 @@ bool Json::getBoolean(spine::Json *value, const char *name, bool defaultValue) {
 	value = getItem(value, name);
 	if (value) {
 		if (value->_valueString) return strcmp(value->_valueString, "true") == 0;
-		if (value->_type == JSON_NULL) return false;
+		if (value->_type == JSON_TRUE) return true;
+		if (value->_type == JSON_FALSE || value->_type == JSON_NULL) return false;
 		if (value->_type == JSON_NUMBER) return value->_valueFloat != 0;
 		return defaultValue;
 	} else {
@@ -111,7 +127,10 @@ Json::Json(const char *value) :
 		_valueString(NULL),
 		_valueInt(0),
 		_valueFloat(0),
-		_name(NULL) {
+		_name(NULL),
+		_nameHash(0),
+		_blocks(NULL),
+		_blockSize(MIN_BLOCK_SIZE) {
 	if (value) {
 		value = parseValue(this, skip(value));
 
@@ -120,23 +139,43 @@ Json::Json(const char *value) :
 }
 
 Json::~Json() {
-    spine::Json* curr = nullptr;
-    spine::Json* next = _child;
-    do {
-        curr = next;
-        if (curr) {
-            next = curr->_next;
-        }
-        delete curr;
-    } while(next);
-
-    if (_valueString) {
-        SpineExtension::free(_valueString, __FILE__, __LINE__);
-    }
-
-    if (_name) {
-        SpineExtension::free(_name, __FILE__, __LINE__);
-    }
+	/* The items and strings have no destructors to run, they are freed with the blocks. */
+	while (_blocks) {
+		Block *next = _blocks->next;
+		SpineExtension::free(_blocks, __FILE__, __LINE__);
+		_blocks = next;
+	}
+}
+
+void *Json::allocate(size_t size) {
+	size = (size + 7) & ~(size_t) 7;
+	if (!_blocks || (size_t) (_blocks->end - _blocks->top) < size) {
+		size_t blockSize = _blockSize < size ? size : _blockSize;
+		Block *block = (Block *) SpineExtension::alloc<char>(sizeof(Block) + blockSize, __FILE__, __LINE__);
+		block->next = _blocks;
+		block->top = (char *) (block + 1);
+		block->end = block->top + blockSize;
+		_blocks = block;
+		if (_blockSize < MAX_BLOCK_SIZE) _blockSize <<= 1;
+	}
+	void *ptr = _blocks->top;
+	_blocks->top += size;
+	return ptr;
+}
+
+Json *Json::newItem() {
+	return new(allocate(sizeof(Json))) Json(NULL);
+}
+
+unsigned int Json::hash(const char *string) {
+	/* FNV-1a of the name with ASCII letters in lower case, names differing only in case have the same hash. */
+	unsigned int hash = 2166136261u;
+	for (; *string; string++) {
+		unsigned char c = (unsigned char) *string;
+		if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+		hash = (hash ^ c) * 16777619u;
+	}
+	return hash;
 }
 
 const char *Json::skip(const char *inValue) {
@@ -219,6 +258,7 @@ const char *Json::parseString(Json *item, const char *str) {
 	char *ptr2;
 	char *out;
 	int len = 0;
+	bool escaped = false;
 	unsigned uc, uc2;
 	if (*str != '\"') {
 		/* TODO: don't need this check when called from parseValue, but do need from parseObject */
@@ -228,13 +268,19 @@ const char *Json::parseString(Json *item, const char *str) {
 
 	while (*ptr != '\"' && *ptr && ++len) {
 		if (*ptr++ == '\\') {
+			escaped = true;
 			ptr++; /* Skip escaped quotes. */
 		}
 	}
 
-	out = SpineExtension::alloc<char>(len + 1, __FILE__, __LINE__); /* The length needed for the string, roughly. */
-	if (!out) {
-		return 0;
+	out = (char *) allocate(len + 1); /* The length needed for the string, roughly. */
+
+	if (!escaped) {
+		memcpy(out, str + 1, len);
+		out[len] = 0;
+		item->_valueString = out;
+		item->_type = JSON_STRING;
+		return *ptr == '\"' ? ptr + 1 : ptr;
 	}
 
 	ptr = str + 1;
@@ -332,67 +378,68 @@ const char *Json::parseString(Json *item, const char *str) {
 }
 
 const char *Json::parseNumber(Json *item, const char *num) {
-	double result = 0.0;
-	int negative = 0;
-	char *ptr = (char *) num;
+	/* The digits are accumulated as an integer and scaled once by an exact power of ten, which is correctly rounded when the
+	 * integer has at most 15 digits and the power is at most 22. */
+	unsigned long long mantissa = 0;
+	int digits = 0, exponent = 0;
+	bool negative = false;
+	const char *ptr = num;
 
 	if (*ptr == '-') {
-		negative = -1;
+		negative = true;
 		++ptr;
 	}
 
-	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
-		++ptr;
+	for (; *ptr >= '0' && *ptr <= '9'; ++ptr) {
+		if (digits < 19) {
+			mantissa = mantissa * 10 + (*ptr - '0');
+			if (mantissa) digits++;
+		} else
+			exponent++; /* Digits beyond the precision of the mantissa. */
 	}
 
 	if (*ptr == '.') {
-		double fraction = 0.0;
-		int n = 0;
 		++ptr;
-
-		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
-			++ptr;
-			++n;
+		for (; *ptr >= '0' && *ptr <= '9'; ++ptr) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*ptr - '0');
+				if (mantissa) digits++;
+				exponent--;
+			}
 		}
-		result += fraction / pow(10.0, n);
-	}
-
-	if (negative) {
-		result = -result;
 	}
 
 	if (*ptr == 'e' || *ptr == 'E') {
-		double exponent = 0;
-		int expNegative = 0;
-		int n = 0;
+		int value = 0;
+		bool expNegative = false;
 		++ptr;
 
 		if (*ptr == '-') {
-			expNegative = -1;
+			expNegative = true;
 			++ptr;
 		} else if (*ptr == '+') {
 			++ptr;
 		}
 
-		while (*ptr >= '0' && *ptr <= '9') {
-			exponent = (exponent * 10.0) + (*ptr - '0');
-			++ptr;
-			++n;
-		}
-
-		if (expNegative) {
-			result = result / pow(10, exponent);
-		} else {
-			result = result * pow(10, exponent);
-		}
+		for (; *ptr >= '0' && *ptr <= '9'; ++ptr)
+			if (value < 10000) value = value * 10 + (*ptr - '0');
+		exponent += expNegative ? -value : value;
 	}
 
 	if (ptr != num) {
 		/* Parse success, number found. */
-		item->_valueFloat = (float)result;
-		item->_valueInt = (int)result;
+		double result = (double) mantissa;
+		if (exponent != 0 && mantissa != 0) {
+			if (exponent < 0 && exponent >= -22)
+				result /= powersOf10[-exponent];
+			else if (exponent > 0 && exponent <= 22)
+				result *= powersOf10[exponent];
+			else
+				result *= pow(10.0, exponent);
+		}
+		if (negative) result = -result;
+		item->_valueFloat = (float) result;
+		item->_valueInt = (int) result;
 		item->_type = JSON_NUMBER;
 		return ptr;
 	} else {
@@ -418,7 +465,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new(__FILE__, __LINE__) Json(NULL);
+	item->_child = child = newItem();
 	if (!item->_child) {
 		return NULL; /* memory fail */
 	}
@@ -432,7 +479,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new(__FILE__, __LINE__) Json(NULL);
+		Json *new_item = newItem();
 		if (!new_item) {
 			return NULL; /* memory fail */
 		}
@@ -474,7 +521,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new(__FILE__, __LINE__) Json(NULL);
+	item->_child = child = newItem();
 	if (!item->_child) {
 		return NULL;
 	}
@@ -483,6 +530,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return NULL;
 	}
 	child->_name = child->_valueString;
+	child->_nameHash = hash(child->_name);
 	child->_valueString = 0;
 	if (*value != ':') {
 		_error = value;
@@ -497,7 +545,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new(__FILE__, __LINE__) Json(NULL);
+		Json *new_item = newItem();
 		if (!new_item) {
 			return NULL; /* memory fail */
 		}
@@ -511,6 +559,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 			return NULL;
 		}
 		child->_name = child->_valueString;
+		child->_nameHash = hash(child->_name);
 		child->_valueString = 0;
 		if (*value != ':') {
 			_error = value;
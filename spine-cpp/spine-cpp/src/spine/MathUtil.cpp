@@ -63,40 +63,59 @@ float MathUtil::fmod(float a, float b) {
 	return (float)::fmod(a, b);
 }
 
-/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-/// degrees), largest error of 0.00488 radians (0.2796 degrees).
-float MathUtil::atan2(float y, float x) {
-	return (float)::atan2(y, x);
+float MathUtil::sqrt(float v) {
+	return (float)::sqrt(v);
 }
 
-/// Returns the cosine in radians from a lookup table.
-float MathUtil::cos(float radians) {
-	return (float)::cos(radians);
+float MathUtil::acos(float v) {
+	return (float)::acos(v);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sin(float radians) {
 	return (float)::sin(radians);
 }
 
-float MathUtil::sqrt(float v) {
-	return (float)::sqrt(v);
+float MathUtil::cos(float radians) {
+	return (float)::cos(radians);
 }
 
-float MathUtil::acos(float v) {
-	return (float)::acos(v);
+void MathUtil::sinCos(float radians, float &sin, float &cos) {
+	sin = (float)::sin(radians);
+	cos = (float)::cos(radians);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sinDeg(float degrees) {
 	return (float)::sin(degrees * MathUtil::Deg_Rad);
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cosDeg(float degrees) {
 	return (float)::cos(degrees * MathUtil::Deg_Rad);
 }
 
+void MathUtil::sinCosDeg(float degrees, float &sin, float &cos) {
+	sin = (float)::sin(degrees * MathUtil::Deg_Rad);
+	cos = (float)::cos(degrees * MathUtil::Deg_Rad);
+}
+
+float MathUtil::atan2(float y, float x) {
+#ifdef SPINE_FAST_MATH
+	float ax = abs(x), ay = abs(y);
+	bool steep = ay > ax;
+	float a = steep ? ax / ay : ay / ax;
+	// Zeros, infinities and NaN.
+	if (!(a <= 1)) return (float)::atan2(y, x);
+	// atan(a) for a from 0 to 1, minimax polynomial.
+	float s = a * a;
+	float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f +
+		s * -0.01172120f)))));
+	if (steep) r = Pi / 2 - r;
+	if (x < 0) r = Pi - r;
+	return y < 0 ? -r : r;
+#else
+	return (float)::atan2(y, x);
+#endif
+}
+
 /* Need to pass 0 as an argument, so VC++ doesn't error with C2124 */
 static bool _isNan(float value, float zero) {
 	float _nan = (float) 0.0 / zero;
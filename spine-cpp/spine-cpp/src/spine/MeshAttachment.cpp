@@ -265,6 +265,7 @@ void MeshAttachment::setParentMesh(MeshAttachment *inValue) {
 		_edges.clearAndAddAll(inValue->_edges);
 		_width = inValue->_width;
 		_height = inValue->_height;
+		if (inValue->_influenceBuckets || _influenceBuckets) buildInfluenceBuckets();
 	}
 }
 
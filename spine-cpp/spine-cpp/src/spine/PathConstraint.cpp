@@ -180,8 +180,7 @@ void PathConstraint::update() {
 			r -= MathUtil::atan2(c, a);
 
 			if (tip) {
-				cos = MathUtil::cos(r);
-				sin = MathUtil::sin(r);
+				MathUtil::sinCos(r, sin, cos);
 				float length = bone._data.getLength();
 				boneX += (length * (cos * a - sin * c) - dx) * rotateMix;
 				boneY += (length * (sin * a + cos * c) - dy) * rotateMix;
@@ -194,8 +193,7 @@ void PathConstraint::update() {
 				r += MathUtil::Pi_2;
 
 			r *= rotateMix;
-			cos = MathUtil::cos(r);
-			sin = MathUtil::sin(r);
+			MathUtil::sinCos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -204,6 +202,7 @@ void PathConstraint::update() {
 
 		bone._appliedValid = false;
 	}
+	_target->getBone()._skeleton._boneMatricesValid = false;
 }
 
 int PathConstraint::getOrder() {
@@ -501,8 +500,10 @@ void PathConstraint::addBeforePosition(float p, Vector<float> &temp, int i, Vect
 	float dx = temp[i + 2] - x1;
 	float dy = temp[i + 3] - y1;
 	float r = MathUtil::atan2(dy, dx);
-	output[o] = x1 + p * MathUtil::cos(r);
-	output[o + 1] = y1 + p * MathUtil::sin(r);
+	float cos, sin;
+	MathUtil::sinCos(r, sin, cos);
+	output[o] = x1 + p * cos;
+	output[o + 1] = y1 + p * sin;
 	output[o + 2] = r;
 }
 
@@ -512,8 +513,10 @@ void PathConstraint::addAfterPosition(float p, Vector<float> &temp, int i, Vecto
 	float dx = x1 - temp[i];
 	float dy = y1 - temp[i + 1];
 	float r = MathUtil::atan2(dy, dx);
-	output[o] = x1 + p * MathUtil::cos(r);
-	output[o + 1] = y1 + p * MathUtil::sin(r);
+	float cos, sin;
+	MathUtil::sinCos(r, sin, cos);
+	output[o] = x1 + p * cos;
+	output[o + 1] = y1 + p * sin;
 	output[o + 2] = r;
 }
 
@@ -62,6 +62,13 @@ PathConstraintMixTimeline::PathConstraintMixTimeline(int frameCount) : CurveTime
 
 void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 	MixBlend blend, MixDirection direction
+) {
+	int frameCursor = 0;
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction, frameCursor);
+}
+
+void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+	MixBlend blend, MixDirection direction, int &frameCursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -93,7 +100,7 @@ void PathConstraintMixTimeline::apply(Skeleton &skeleton, float lastTime, float
 		translate = _frames[_frames.size() + PREV_TRANSLATE];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, frameCursor);
 		rotate = _frames[frame + PREV_ROTATE];
 		translate = _frames[frame + PREV_TRANSLATE];
 		float frameTime = _frames[frame];
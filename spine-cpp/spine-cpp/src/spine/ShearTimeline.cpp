@@ -50,6 +50,13 @@ ShearTimeline::ShearTimeline(int frameCount) : TranslateTimeline(frameCount) {
 
 void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
 	MixBlend blend, MixDirection direction
+) {
+	int frameCursor = 0;
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction, frameCursor);
+}
+
+void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+	MixBlend blend, MixDirection direction, int &frameCursor
 ) {
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
@@ -80,7 +87,7 @@ void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 		y = _frames[_frames.size() + PREV_Y];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
+		int frame = Animation::search(_frames, time, ENTRIES, frameCursor);
 		x = _frames[frame + PREV_X];
 		y = _frames[frame + PREV_Y];
 		float frameTime = _frames[frame];
@@ -35,6 +35,7 @@
 
 #include <spine/SkeletonData.h>
 #include <spine/Bone.h>
+#include <spine/BonePoseStore.h>
 #include <spine/Slot.h>
 #include <spine/IkConstraint.h>
 #include <spine/PathConstraint.h>
@@ -57,15 +58,47 @@
 
 using namespace spine;
 
-Skeleton::Skeleton(SkeletonData *skeletonData) :
+enum UpdateKind {
+	UpdateKind_Bone,
+	UpdateKind_IkConstraint,
+	UpdateKind_TransformConstraint,
+	UpdateKind_PathConstraint
+};
+
+/* The values a bone or update cache entry was last updated with, up to 7 per entry. */
+static const int UpdateStateSize = 7;
+
+/* Copies the values to the state, returning true if any differed. */
+static bool updateState(float *state, const float *values, int count) {
+	bool changed = false;
+	for (int i = 0; i < count; i++) {
+		if (state[i] != values[i]) {
+			state[i] = values[i];
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+Skeleton::Skeleton(SkeletonData *skeletonData, bool usePoseStore) :
 		_data(skeletonData),
+		_poseStore(usePoseStore ? new(__FILE__, __LINE__) BonePoseStore(*skeletonData) : NULL),
 		_skin(NULL),
+		_keyedSkinVersion(0),
+		_keyedDefaultSkinVersion(0),
 		_color(1, 1, 1, 1),
 		_time(0),
 		_scaleX(1),
 		_scaleY(1),
 		_x(0),
-		_y(0) {
+		_y(0),
+		_incrementalUpdate(false),
+		_updateStateValid(false),
+		_boneMatricesValid(false),
+		_updatedX(0),
+		_updatedY(0),
+		_updatedScaleX(1),
+		_updatedScaleY(1) {
 	_bones.ensureCapacity(_data->getBones().size());
 	for (size_t i = 0; i < _data->getBones().size(); ++i) {
 		BoneData *data = _data->getBones()[i];
@@ -130,6 +163,7 @@ Skeleton::~Skeleton() {
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	if (_poseStore) delete _poseStore;
 }
 
 void Skeleton::updateCache() {
@@ -195,6 +229,57 @@ void Skeleton::updateCache() {
 	for (i = 0; i < n; ++i) {
 		sortBone(_bones[i]);
 	}
+
+	_updateCacheKinds.clear();
+	for (i = 0, n = _updateCache.size(); i < n; ++i) {
+		const RTTI &rtti = _updateCache[i]->getRTTI();
+		if (rtti.isExactly(Bone::rtti))
+			_updateCacheKinds.add(UpdateKind_Bone);
+		else if (rtti.isExactly(IkConstraint::rtti))
+			_updateCacheKinds.add(UpdateKind_IkConstraint);
+		else if (rtti.isExactly(TransformConstraint::rtti))
+			_updateCacheKinds.add(UpdateKind_TransformConstraint);
+		else
+			_updateCacheKinds.add(UpdateKind_PathConstraint);
+	}
+	_updateStateValid = false;
+
+	_updateCacheBones.clear();
+	_updateCacheBoneRuns.clear();
+	if (_poseStore) {
+		n = _updateCache.size();
+		for (i = 0; i < n; ++i) {
+			Updatable *updatable = _updateCache[i];
+			int boneIndex = -1;
+			if (updatable->getRTTI().isExactly(Bone::rtti)) {
+				Bone *bone = static_cast<Bone *>(updatable);
+				if (!bone->_parent || bone->_data.getTransformMode() == TransformMode_Normal)
+					boneIndex = bone->_data.getIndex();
+			}
+			_updateCacheBones.add(boneIndex);
+		}
+
+		/* The number of consecutive bones starting at each entry that can be updated by the pose store in one batch. Shorter runs
+		 * cost more to batch than they save, their bones are updated one by one. */
+		_updateCacheBoneRuns.setSize(n, 0);
+		for (i = n; i-- > 0;) {
+			if (_updateCacheBones[i] >= 0) _updateCacheBoneRuns[i] = i + 1 < n ? _updateCacheBoneRuns[i + 1] + 1 : 1;
+		}
+		for (i = 0; i < n;) {
+			size_t run = (size_t) _updateCacheBoneRuns[i];
+			if (run == 0) {
+				i++;
+				continue;
+			}
+			if (run < BonePoseStore::MinBatchSize) {
+				for (size_t ii = i; ii < i + run; ++ii) {
+					_updateCacheBones[ii] = -1;
+					_updateCacheBoneRuns[ii] = 0;
+				}
+			}
+			i += run;
+		}
+	}
 }
 
 void Skeleton::printUpdateCache() {
@@ -213,6 +298,13 @@ void Skeleton::printUpdateCache() {
 }
 
 void Skeleton::updateWorldTransform() {
+	/* Path constraints compute world vertices during the update, from the bones rather than the previous matrices. */
+	_boneMatricesValid = false;
+	if (!_incrementalUpdate || !updateDirtyWorldTransform()) updateAllWorldTransforms();
+	gatherBoneMatrices();
+}
+
+void Skeleton::updateAllWorldTransforms() {
 	for (size_t i = 0, n = _updateCacheReset.size(); i < n; ++i) {
 		Bone *boneP = _updateCacheReset[i];
 		Bone &bone = *boneP;
@@ -226,11 +318,155 @@ void Skeleton::updateWorldTransform() {
 		bone._appliedValid = true;
 	}
 
+	if (_poseStore) {
+		/* Long runs of bones using the normal transform mode are computed in batches. */
+		float x = _x, y = _y, scaleX = getScaleX(), scaleY = getScaleY();
+		for (size_t i = 0, n = _updateCache.size(); i < n;) {
+			int run = _updateCacheBoneRuns[i];
+			if (run > 0) {
+				_poseStore->updateWorldTransforms(_bones, _updateCacheBones.buffer() + i, run, x, y, scaleX, scaleY);
+				i += run;
+			} else {
+				_updateCache[i]->update();
+				i++;
+			}
+		}
+		return;
+	}
+
 	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
 		_updateCache[i]->update();
 	}
 }
 
+bool Skeleton::updateDirtyWorldTransform() {
+	size_t n = _updateCache.size(), boneCount = _bones.size();
+	bool all = !_updateStateValid || _x != _updatedX || _y != _updatedY || _scaleX != _updatedScaleX ||
+			   _scaleY != _updatedScaleY;
+	/* The local transform of each bone followed by the values each update cache entry was last applied with. */
+	if (_updateState.size() != (boneCount + n) * UpdateStateSize) {
+		_updateState.setSize((boneCount + n) * UpdateStateSize, 0);
+		all = true;
+	}
+	_updateStateValid = true;
+	_updatedX = _x;
+	_updatedY = _y;
+	_updatedScaleX = _scaleX;
+	_updatedScaleY = _scaleY;
+
+	/* Bones changed by a 2 bone IK constraint have no entry of their own, so local changes are found for all bones first. */
+	_boneDirty.setSize(boneCount, false);
+	for (size_t i = 0; i < boneCount; ++i) {
+		Bone &bone = *_bones[i];
+		float values[] = {bone._x, bone._y, bone._rotation, bone._scaleX, bone._scaleY, bone._shearX, bone._shearY};
+		_boneDirty[i] = updateState(_updateState.buffer() + i * UpdateStateSize, values, 7) && bone._active;
+	}
+	_updateCacheDirty.setSize(n, false);
+	for (size_t i = 0; i < n; ++i) _updateCacheDirty[i] = false;
+
+	/* A constraint applied again needs its bones recomputed first, which precede it in the update cache, so entries are marked
+	 * until no constraint dirties another bone. Constraint values are only compared on the first pass. */
+	float *cacheState = _updateState.buffer() + boneCount * UpdateStateSize;
+	bool first = true, again;
+	do {
+		again = false;
+		for (size_t i = 0; i < n; ++i) {
+			if (_updateCacheDirty[i]) continue;
+			float *state = cacheState + i * UpdateStateSize;
+			bool dirty = false;
+			Vector<Bone *> *bones = NULL;
+			switch (_updateCacheKinds[i]) {
+				case UpdateKind_Bone: {
+					Bone &bone = *static_cast<Bone *>(_updateCache[i]);
+					if (bone._parent && _boneDirty[bone._parent->_data.getIndex()]) _boneDirty[bone._data.getIndex()] = true;
+					break;
+				}
+				case UpdateKind_IkConstraint: {
+					IkConstraint &constraint = *static_cast<IkConstraint *>(_updateCache[i]);
+					if (first) {
+						float values[] = {constraint._mix, constraint._softness, (float) constraint._bendDirection,
+										  constraint._compress ? 1.0f : 0.0f, constraint._stretch ? 1.0f : 0.0f};
+						dirty = updateState(state, values, 5);
+					}
+					dirty = dirty || _boneDirty[constraint._target->_data.getIndex()];
+					bones = &constraint._bones;
+					break;
+				}
+				case UpdateKind_TransformConstraint: {
+					TransformConstraint &constraint = *static_cast<TransformConstraint *>(_updateCache[i]);
+					if (first) {
+						float values[] = {constraint._rotateMix, constraint._translateMix, constraint._scaleMix,
+										  constraint._shearMix};
+						dirty = updateState(state, values, 4);
+					}
+					dirty = dirty || _boneDirty[constraint._target->_data.getIndex()];
+					bones = &constraint._bones;
+					break;
+				}
+				default:
+					/* Path constraints also depend on the path attachment and its deform, so they are always applied. */
+					dirty = true;
+					bones = &static_cast<PathConstraint *>(_updateCache[i])->_bones;
+			}
+			if (!bones) continue;
+			for (size_t ii = 0, nn = bones->size(); !dirty && ii < nn; ++ii)
+				dirty = _boneDirty[(*bones)[ii]->_data.getIndex()];
+			if (!dirty) continue;
+			_updateCacheDirty[i] = true;
+			for (size_t ii = 0, nn = bones->size(); ii < nn; ++ii) {
+				int index = (*bones)[ii]->_data.getIndex();
+				if (!_boneDirty[index]) {
+					_boneDirty[index] = true;
+					again = true;
+				}
+			}
+		}
+		first = false;
+	} while (again);
+
+	if (all) return false;
+	size_t dirtyCount = 0;
+	for (size_t i = 0; i < boneCount; ++i)
+		if (_boneDirty[i]) dirtyCount++;
+	if (dirtyCount * 2 > boneCount) return false;
+
+	for (size_t i = 0, nn = _updateCacheReset.size(); i < nn; ++i) {
+		Bone &bone = *_updateCacheReset[i];
+		if (!_boneDirty[bone._data.getIndex()]) continue;
+		bone._ax = bone._x;
+		bone._ay = bone._y;
+		bone._arotation = bone._rotation;
+		bone._ascaleX = bone._scaleX;
+		bone._ascaleY = bone._scaleY;
+		bone._ashearX = bone._shearX;
+		bone._ashearY = bone._shearY;
+		bone._appliedValid = true;
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		Updatable *updatable = _updateCache[i];
+		if (_updateCacheKinds[i] == UpdateKind_Bone) {
+			if (!_boneDirty[static_cast<Bone *>(updatable)->_data.getIndex()]) continue;
+			/* Bones the full update computes with the pose store must give the same result. */
+			if (_poseStore && _updateCacheBones[i] >= 0)
+				_poseStore->updateWorldTransforms(_bones, _updateCacheBones.buffer() + i, 1, _x, _y, getScaleX(), getScaleY());
+			else
+				updatable->update();
+		} else if (_updateCacheDirty[i])
+			updatable->update();
+	}
+	return true;
+}
+
+void Skeleton::setIncrementalUpdate(bool incrementalUpdate) {
+	_incrementalUpdate = incrementalUpdate;
+	_updateStateValid = false;
+}
+
+bool Skeleton::getIncrementalUpdate() {
+	return _incrementalUpdate;
+}
+
 void Skeleton::setToSetupPose() {
 	setBonesToSetupPose();
 	setSlotsToSetupPose();
@@ -287,19 +523,52 @@ void Skeleton::setSlotsToSetupPose() {
 }
 
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	int index = findBoneIndex(boneName);
+	return index == -1 ? NULL : _bones[index];
 }
 
 int Skeleton::findBoneIndex(const String &boneName) {
-	return ContainerUtil::findIndexWithDataName(_bones, boneName);
+	// The bones are in the order of the data's bones.
+	int index = _data->findBoneIndex(boneName);
+	if (index != -1 && (index >= (int) _bones.size() || &_bones[index]->_data != _data->_bones[index]))
+		return ContainerUtil::findIndexWithDataName(_bones, boneName);
+	return index;
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	int index = findSlotIndex(slotName);
+	return index == -1 ? NULL : _slots[index];
 }
 
 int Skeleton::findSlotIndex(const String &slotName) {
-	return ContainerUtil::findIndexWithDataName(_slots, slotName);
+	int index = _data->findSlotIndex(slotName);
+	if (index != -1 && (index >= (int) _slots.size() || &_slots[index]->_data != _data->_slots[index]))
+		return ContainerUtil::findIndexWithDataName(_slots, slotName);
+	return index;
+}
+
+Bone *Skeleton::findBone(const NameHandle &boneName) {
+	int index = findBoneIndex(boneName);
+	return index == -1 ? NULL : _bones[index];
+}
+
+int Skeleton::findBoneIndex(const NameHandle &boneName) {
+	int index = _data->findBoneIndex(boneName);
+	if (index != -1 && (index >= (int) _bones.size() || &_bones[index]->_data != _data->_bones[index]))
+		return ContainerUtil::findIndexWithDataName(_bones, _data->_bones[index]->getName());
+	return index;
+}
+
+Slot *Skeleton::findSlot(const NameHandle &slotName) {
+	int index = findSlotIndex(slotName);
+	return index == -1 ? NULL : _slots[index];
+}
+
+int Skeleton::findSlotIndex(const NameHandle &slotName) {
+	int index = _data->findSlotIndex(slotName);
+	if (index != -1 && (index >= (int) _slots.size() || &_slots[index]->_data != _data->_slots[index]))
+		return ContainerUtil::findIndexWithDataName(_slots, _data->_slots[index]->getName());
+	return index;
 }
 
 void Skeleton::setSkin(const String &skinName) {
@@ -349,23 +618,43 @@ Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName)
 	return _data->getDefaultSkin() != NULL ? _data->getDefaultSkin()->getAttachment(slotIndex, attachmentName) : NULL;
 }
 
+Attachment *Skeleton::getAttachment(int slotIndex, int attachmentKey, const String &attachmentName) {
+	if (attachmentKey < 0) return attachmentName.isEmpty() ? NULL : getAttachment(slotIndex, attachmentName);
+
+	Skin *defaultSkin = _data->_defaultSkin;
+	if (_keyedAttachments.size() != _data->_attachmentKeySlots.size() || (_skin ? _skin->_version : 0) != _keyedSkinVersion ||
+		(defaultSkin ? defaultSkin->_version : 0) != _keyedDefaultSkinVersion)
+		resolveAttachments();
+	// A key of another skeleton data.
+	if ((size_t) attachmentKey >= _keyedAttachments.size()) return getAttachment(slotIndex, attachmentName);
+	return _keyedAttachments[attachmentKey];
+}
+
+void Skeleton::resolveAttachments() {
+	Vector<int> &slots = _data->_attachmentKeySlots;
+	Vector<String> &names = _data->_attachmentKeyNames;
+	_keyedAttachments.setSize(slots.size(), NULL);
+	for (size_t i = 0, n = slots.size(); i < n; i++)
+		_keyedAttachments[i] = getAttachment(slots[i], names[i]);
+	_keyedSkinVersion = _skin ? _skin->_version : 0;
+	_keyedDefaultSkinVersion = _data->_defaultSkin ? _data->_defaultSkin->_version : 0;
+}
+
 void Skeleton::setAttachment(const String &slotName, const String &attachmentName) {
 	assert(slotName.length() > 0);
 
-	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
-		Slot *slot = _slots[i];
-		if (slot->_data.getName() == slotName) {
-			Attachment *attachment = NULL;
-			if (attachmentName.length() > 0) {
-				attachment = getAttachment(i, attachmentName);
+	int slotIndex = findSlotIndex(slotName);
+	if (slotIndex != -1) {
+		Attachment *attachment = NULL;
+		if (attachmentName.length() > 0) {
+			attachment = getAttachment(slotIndex, attachmentName);
 
-				assert(attachment != NULL);
-			}
+			assert(attachment != NULL);
+		}
 
-			slot->setAttachment(attachment);
+		_slots[slotIndex]->setAttachment(attachment);
 
-			return;
-		}
+		return;
 	}
 
 	printf("Slot not found: %s", slotName.buffer());
@@ -376,9 +665,11 @@ void Skeleton::setAttachment(const String &slotName, const String &attachmentNam
 IkConstraint *Skeleton::findIkConstraint(const String &constraintName) {
 	assert(constraintName.length() > 0);
 
+	IkConstraintData *data = _data->findIkConstraint(constraintName);
+	if (!data) return NULL;
 	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i) {
 		IkConstraint *ikConstraint = _ikConstraints[i];
-		if (ikConstraint->_data.getName() == constraintName) {
+		if (&ikConstraint->_data == data) {
 			return ikConstraint;
 		}
 	}
@@ -388,9 +679,11 @@ IkConstraint *Skeleton::findIkConstraint(const String &constraintName) {
 TransformConstraint *Skeleton::findTransformConstraint(const String &constraintName) {
 	assert(constraintName.length() > 0);
 
+	TransformConstraintData *data = _data->findTransformConstraint(constraintName);
+	if (!data) return NULL;
 	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i) {
 		TransformConstraint *transformConstraint = _transformConstraints[i];
-		if (transformConstraint->_data.getName() == constraintName) {
+		if (&transformConstraint->_data == data) {
 			return transformConstraint;
 		}
 	}
@@ -401,9 +694,11 @@ TransformConstraint *Skeleton::findTransformConstraint(const String &constraintN
 PathConstraint *Skeleton::findPathConstraint(const String &constraintName) {
 	assert(constraintName.length() > 0);
 
+	PathConstraintData *data = _data->findPathConstraint(constraintName);
+	if (!data) return NULL;
 	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i) {
 		PathConstraint *constraint = _pathConstraints[i];
-		if (constraint->_data.getName() == constraintName) {
+		if (&constraint->_data == data) {
 			return constraint;
 		}
 	}
@@ -475,6 +770,27 @@ Vector<Bone *> &Skeleton::getBones() {
 	return _bones;
 }
 
+void Skeleton::gatherBoneMatrices() {
+	_boneMatricesValid = true;
+
+	size_t boneCount = _bones.size();
+	_boneMatrices.setSize(boneCount << 3, 0);
+	float *matrices = _boneMatrices.buffer();
+	for (size_t i = 0; i < boneCount; ++i, matrices += 8) {
+		Bone &bone = *_bones[i];
+		matrices[0] = bone._a;
+		matrices[1] = bone._c;
+		matrices[2] = bone._b;
+		matrices[3] = bone._d;
+		matrices[4] = bone._worldX;
+		matrices[5] = bone._worldY;
+	}
+}
+
+BonePoseStore *Skeleton::getPoseStore() {
+	return _poseStore;
+}
+
 Vector<Updatable *> &Skeleton::getUpdateCacheList() {
 	return _updateCache;
 }
@@ -0,0 +1,442 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonBatchRenderer.h>
+
+#include <spine/Atlas.h>
+#include <spine/Bone.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/MathUtil.h>
+#include <spine/MeshAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+#include <spine/VertexEffect.h>
+
+#include <float.h>
+
+using namespace spine;
+
+/* The stride of the positions in RenderVertex, in floats. */
+static const size_t VertexStride = sizeof(RenderVertex) / sizeof(float);
+
+/* Adds the world bounds of a box in the bone's space to the min and max. */
+static void addBounds(Bone &bone, float minX, float minY, float maxX, float maxY, float *bounds) {
+	float a = bone.getA(), b = bone.getB(), c = bone.getC(), d = bone.getD();
+	float centerX = (minX + maxX) * 0.5f, centerY = (minY + maxY) * 0.5f;
+	float halfWidth = (maxX - minX) * 0.5f, halfHeight = (maxY - minY) * 0.5f;
+	float x = a * centerX + b * centerY + bone.getWorldX(), y = c * centerX + d * centerY + bone.getWorldY();
+	float extentX = MathUtil::abs(a) * halfWidth + MathUtil::abs(b) * halfHeight;
+	float extentY = MathUtil::abs(c) * halfWidth + MathUtil::abs(d) * halfHeight;
+	bounds[0] = MathUtil::min(bounds[0], x - extentX);
+	bounds[1] = MathUtil::min(bounds[1], y - extentY);
+	bounds[2] = MathUtil::max(bounds[2], x + extentX);
+	bounds[3] = MathUtil::max(bounds[3], y + extentY);
+}
+
+/* Returns the min x, min y, max x and max y of the x, y pairs. */
+static void getBounds(const float *vertices, size_t count, float *bounds) {
+	bounds[0] = bounds[1] = FLT_MAX;
+	bounds[2] = bounds[3] = -FLT_MAX;
+	for (size_t i = 0; i < count; i += 2) {
+		bounds[0] = MathUtil::min(bounds[0], vertices[i]);
+		bounds[1] = MathUtil::min(bounds[1], vertices[i + 1]);
+		bounds[2] = MathUtil::max(bounds[2], vertices[i]);
+		bounds[3] = MathUtil::max(bounds[3], vertices[i + 1]);
+	}
+}
+
+SkeletonBatchRenderer::SkeletonBatchRenderer() :
+		_premultipliedAlpha(false),
+		_vertexEffect(NULL),
+		_culling(false),
+		_cullMinX(0),
+		_cullMinY(0),
+		_cullMaxX(0),
+		_cullMaxY(0),
+		_culledCount(0),
+		_renderedCount(0),
+		_skeletonCulled(false) {
+	_quadIndices.add(0);
+	_quadIndices.add(1);
+	_quadIndices.add(2);
+	_quadIndices.add(2);
+	_quadIndices.add(3);
+	_quadIndices.add(0);
+}
+
+void SkeletonBatchRenderer::render(Skeleton &skeleton) {
+	_commands.clear();
+	_vertices.clear();
+	_indices.clear();
+	_culledCount = 0;
+	_renderedCount = 0;
+	_skeletonCulled = false;
+
+	Color &skeletonColor = skeleton.getColor();
+	if (skeletonColor.a == 0) return;
+
+	bool culling = _culling && !_vertexEffect;
+	if (culling && !cull(skeleton)) {
+		_skeletonCulled = true;
+		return;
+	}
+
+	if (_vertexEffect) _vertexEffect->begin(skeleton);
+
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) {
+			_clipper.clipEnd(slot);
+			continue;
+		}
+
+		RegionAttachment *region = NULL;
+		MeshAttachment *mesh = NULL;
+		Color *attachmentColor;
+		void *texture;
+		float *uvs;
+		unsigned short *indices;
+		size_t vertexCount, indexCount;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			region = static_cast<RegionAttachment *>(attachment);
+			attachmentColor = &region->getColor();
+			texture = static_cast<AtlasRegion *>(region->getRendererObject())->page->getRendererObject();
+			uvs = region->getUVs().buffer();
+			indices = _quadIndices.buffer();
+			vertexCount = 4;
+			indexCount = 6;
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			mesh = static_cast<MeshAttachment *>(attachment);
+			attachmentColor = &mesh->getColor();
+			texture = static_cast<AtlasRegion *>(mesh->getRendererObject())->page->getRendererObject();
+			uvs = mesh->getUVs().buffer();
+			indices = mesh->getTriangles().buffer();
+			vertexCount = mesh->getWorldVerticesLength() >> 1;
+			indexCount = mesh->getTriangles().size();
+		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+			_clipper.clipStart(slot, static_cast<ClippingAttachment *>(attachment));
+			continue;
+		} else {
+			_clipper.clipEnd(slot);
+			continue;
+		}
+
+		if (culling && _slotCulled[i]) {
+			_culledCount++;
+			_clipper.clipEnd(slot);
+			continue;
+		}
+
+		Color &slotColor = slot.getColor();
+		Color light(skeletonColor.r * slotColor.r * attachmentColor->r, skeletonColor.g * slotColor.g * attachmentColor->g,
+			skeletonColor.b * slotColor.b * attachmentColor->b, skeletonColor.a * slotColor.a * attachmentColor->a);
+		if (light.a == 0) {
+			_clipper.clipEnd(slot);
+			continue;
+		}
+		_renderedCount++;
+		if (_premultipliedAlpha) {
+			light.r *= light.a;
+			light.g *= light.a;
+			light.b *= light.a;
+		}
+		Color dark(0, 0, 0, _premultipliedAlpha ? 1.0f : 0.0f);
+		if (slot.hasDarkColor()) {
+			dark.r = slot.getDarkColor().r;
+			dark.g = slot.getDarkColor().g;
+			dark.b = slot.getDarkColor().b;
+		}
+		BlendMode blendMode = slot.getData().getBlendMode();
+
+		if (!_clipper.isClipping()) {
+			/* The world vertices are computed directly into the interleaved vertices. */
+			RenderVertex *vertices = addVertices(texture, blendMode, vertexCount, indices, indexCount);
+			if (region)
+				region->computeWorldVertices(slot.getBone(), &vertices->x, 0, VertexStride);
+			else
+				mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), &vertices->x, 0, VertexStride);
+			setVertexAttributes(vertices, vertexCount, uvs, light, dark);
+		} else {
+			_worldVertices.setSize(vertexCount << 1, 0);
+			if (region)
+				region->computeWorldVertices(slot.getBone(), _worldVertices.buffer(), 0, 2);
+			else
+				mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), _worldVertices.buffer(), 0, 2);
+			_clipper.clipTriangles(_worldVertices.buffer(), indices, indexCount, uvs, 2);
+
+			Vector<unsigned short> &clippedTriangles = _clipper.getClippedTriangles();
+			if (clippedTriangles.size() == 0) {
+				_clipper.clipEnd(slot);
+				continue;
+			}
+			Vector<float> &clippedVertices = _clipper.getClippedVertices();
+			size_t clippedCount = clippedVertices.size() >> 1;
+			RenderVertex *vertices = addVertices(texture, blendMode, clippedCount, clippedTriangles.buffer(),
+				clippedTriangles.size());
+			for (size_t ii = 0; ii < clippedCount; ++ii) {
+				vertices[ii].x = clippedVertices[ii << 1];
+				vertices[ii].y = clippedVertices[(ii << 1) + 1];
+			}
+			setVertexAttributes(vertices, clippedCount, _clipper.getClippedUVs().buffer(), light, dark);
+		}
+		_clipper.clipEnd(slot);
+	}
+	_clipper.clipEnd();
+
+	if (_vertexEffect) _vertexEffect->end();
+}
+
+Vector<RenderCommand> &SkeletonBatchRenderer::getCommands() {
+	return _commands;
+}
+
+Vector<RenderVertex> &SkeletonBatchRenderer::getVertices() {
+	return _vertices;
+}
+
+Vector<unsigned short> &SkeletonBatchRenderer::getIndices() {
+	return _indices;
+}
+
+void SkeletonBatchRenderer::setPremultipliedAlpha(bool premultipliedAlpha) {
+	_premultipliedAlpha = premultipliedAlpha;
+}
+
+bool SkeletonBatchRenderer::getPremultipliedAlpha() {
+	return _premultipliedAlpha;
+}
+
+void SkeletonBatchRenderer::setVertexEffect(VertexEffect *vertexEffect) {
+	_vertexEffect = vertexEffect;
+}
+
+VertexEffect *SkeletonBatchRenderer::getVertexEffect() {
+	return _vertexEffect;
+}
+
+void SkeletonBatchRenderer::setCullRectangle(float x, float y, float width, float height) {
+	_culling = true;
+	_cullMinX = x;
+	_cullMinY = y;
+	_cullMaxX = x + width;
+	_cullMaxY = y + height;
+}
+
+void SkeletonBatchRenderer::clearCullRectangle() {
+	_culling = false;
+}
+
+bool SkeletonBatchRenderer::isCulling() {
+	return _culling;
+}
+
+void SkeletonBatchRenderer::clearBoundsCache() {
+	_boundsIndex.clear();
+	_boundsCache.clear();
+}
+
+size_t SkeletonBatchRenderer::getCulledCount() {
+	return _culledCount;
+}
+
+size_t SkeletonBatchRenderer::getRenderedCount() {
+	return _renderedCount;
+}
+
+bool SkeletonBatchRenderer::isSkeletonCulled() {
+	return _skeletonCulled;
+}
+
+bool SkeletonBatchRenderer::cull(Skeleton &skeleton) {
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	size_t n = drawOrder.size(), culledCount = 0;
+	bool visible = false;
+	_slotCulled.setSize(n, false);
+	for (size_t i = 0; i < n; ++i) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		_slotCulled[i] = false;
+		if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) continue;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			if (static_cast<RegionAttachment *>(attachment)->getColor().a == 0) continue;
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			if (static_cast<MeshAttachment *>(attachment)->getColor().a == 0) continue;
+		} else
+			continue;
+		if (isVisible(skeleton, slot, attachment))
+			visible = true;
+		else {
+			_slotCulled[i] = true;
+			culledCount++;
+		}
+	}
+	if (!visible) _culledCount = culledCount;
+	return visible;
+}
+
+bool SkeletonBatchRenderer::isVisible(Skeleton &skeleton, Slot &slot, Attachment *attachment) {
+	float bounds[] = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX}, local[4];
+	if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+		getBounds(static_cast<RegionAttachment *>(attachment)->getOffset().buffer(), 8, local);
+		addBounds(slot.getBone(), local[0], local[1], local[2], local[3], bounds);
+	} else {
+		MeshAttachment &mesh = *static_cast<MeshAttachment *>(attachment);
+		Vector<float> &deform = slot.getDeform();
+		if (mesh.getBones().size() == 0 && deform.size() > 0) {
+			/* The deform replaces the vertices of unweighted meshes. */
+			getBounds(deform.buffer(), deform.size(), local);
+			addBounds(slot.getBone(), local[0], local[1], local[2], local[3], bounds);
+		} else {
+			/* The deform of weighted meshes offsets each influence in its bone's space. */
+			float deformX = 0, deformY = 0;
+			for (size_t i = 0, n = deform.size(); i < n; i += 2) {
+				deformX = MathUtil::max(deformX, MathUtil::abs(deform[i]));
+				deformY = MathUtil::max(deformY, MathUtil::abs(deform[i + 1]));
+			}
+			size_t offset = getMeshBounds(mesh);
+			Vector<Bone *> &bones = skeleton.getBones();
+			for (size_t i = 0, n = (size_t) _boundsCache[offset]; i < n; ++i) {
+				float *box = _boundsCache.buffer() + offset + 1 + i * 5;
+				Bone &bone = box[0] < 0 ? slot.getBone() : *bones[(size_t) box[0]];
+				addBounds(bone, box[1] - deformX, box[2] - deformY, box[3] + deformX, box[4] + deformY, bounds);
+			}
+		}
+	}
+	return bounds[0] <= _cullMaxX && bounds[2] >= _cullMinX && bounds[1] <= _cullMaxY && bounds[3] >= _cullMinY;
+}
+
+size_t SkeletonBatchRenderer::getMeshBounds(MeshAttachment &mesh) {
+	if (_boundsIndex.containsKey(mesh.getId())) return _boundsIndex[mesh.getId()];
+
+	size_t offset = _boundsCache.size();
+	Vector<size_t> &bones = mesh.getBones();
+	Vector<float> &vertices = mesh.getVertices();
+	if (bones.size() == 0) {
+		float local[4];
+		getBounds(vertices.buffer(), vertices.size(), local);
+		_boundsCache.add(1);
+		_boundsCache.add(-1);
+		for (int i = 0; i < 4; i++) _boundsCache.add(local[i]);
+	} else {
+		/* One box per bone, containing the offsets of its influences. Each vertex is a weighted average of its influences, so
+		 * it lies within the world bounds of the boxes. */
+		_boundsCache.add(0);
+		for (size_t v = 0, b = 0, n = bones.size(); v < n;) {
+			size_t count = bones[v++];
+			count += v;
+			for (; v < count; ++v, b += 3) {
+				float boneIndex = (float) bones[v], x = vertices[b], y = vertices[b + 1];
+				size_t boxCount = (size_t) _boundsCache[offset], box = offset + 1;
+				while (box < offset + 1 + boxCount * 5 && _boundsCache[box] != boneIndex)
+					box += 5;
+				if (box == offset + 1 + boxCount * 5) {
+					_boundsCache.add(boneIndex);
+					_boundsCache.add(x);
+					_boundsCache.add(y);
+					_boundsCache.add(x);
+					_boundsCache.add(y);
+					_boundsCache[offset] = (float) (boxCount + 1);
+				}
+				_boundsCache[box + 1] = MathUtil::min(_boundsCache[box + 1], x);
+				_boundsCache[box + 2] = MathUtil::min(_boundsCache[box + 2], y);
+				_boundsCache[box + 3] = MathUtil::max(_boundsCache[box + 3], x);
+				_boundsCache[box + 4] = MathUtil::max(_boundsCache[box + 4], y);
+			}
+		}
+	}
+	_boundsIndex.put(mesh.getId(), offset);
+	return offset;
+}
+
+RenderVertex *SkeletonBatchRenderer::addVertices(void *texture, BlendMode blendMode, size_t vertexCount,
+	unsigned short *indices, size_t indexCount) {
+	RenderCommand *command = _commands.size() > 0 ? &_commands[_commands.size() - 1] : NULL;
+	if (!command || command->texture != texture || command->blendMode != blendMode ||
+		command->vertexCount + vertexCount > 65536) {
+		RenderCommand newCommand;
+		newCommand.texture = texture;
+		newCommand.blendMode = blendMode;
+		newCommand.vertexStart = _vertices.size();
+		newCommand.vertexCount = 0;
+		newCommand.indexStart = _indices.size();
+		newCommand.indexCount = 0;
+		_commands.add(newCommand);
+		command = &_commands[_commands.size() - 1];
+	}
+
+	size_t vertexStart = _vertices.size(), indexStart = _indices.size();
+	static const RenderVertex emptyVertex = RenderVertex();
+	_vertices.setSize(vertexStart + vertexCount, emptyVertex);
+	_indices.setSize(indexStart + indexCount, 0);
+	unsigned short base = (unsigned short) command->vertexCount;
+	unsigned short *commandIndices = _indices.buffer() + indexStart;
+	for (size_t i = 0; i < indexCount; ++i)
+		commandIndices[i] = indices[i] + base;
+	command->vertexCount += vertexCount;
+	command->indexCount += indexCount;
+	return _vertices.buffer() + vertexStart;
+}
+
+void SkeletonBatchRenderer::setVertexAttributes(RenderVertex *vertices, size_t vertexCount, float *uvs, Color &light,
+	Color &dark) {
+	if (!_vertexEffect) {
+		unsigned int color = packColor(light), darkColor = packColor(dark);
+		for (size_t i = 0; i < vertexCount; ++i) {
+			RenderVertex &vertex = vertices[i];
+			vertex.u = uvs[i << 1];
+			vertex.v = uvs[(i << 1) + 1];
+			vertex.color = color;
+			vertex.darkColor = darkColor;
+		}
+		return;
+	}
+
+	for (size_t i = 0; i < vertexCount; ++i) {
+		RenderVertex &vertex = vertices[i];
+		Color vertexLight = light, vertexDark = dark;
+		vertex.u = uvs[i << 1];
+		vertex.v = uvs[(i << 1) + 1];
+		_vertexEffect->transform(vertex.x, vertex.y, vertex.u, vertex.v, vertexLight, vertexDark);
+		vertex.color = packColor(vertexLight);
+		vertex.darkColor = packColor(vertexDark);
+	}
+}
+
+unsigned int SkeletonBatchRenderer::packColor(Color &color) {
+	return (unsigned int) (color.r * 255) | ((unsigned int) (color.g * 255) << 8) | ((unsigned int) (color.b * 255) << 16) |
+		   ((unsigned int) (color.a * 255) << 24);
+}
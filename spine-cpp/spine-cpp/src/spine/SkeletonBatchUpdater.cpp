@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonBatchUpdater.h>
+
+#include <spine/Skeleton.h>
+#include <spine/AnimationState.h>
+
+#ifndef SPINE_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+namespace spine {
+#ifndef SPINE_NO_THREADS
+/// Worker threads which wait for a pass, then update entries until none are left. Each thread owns a contiguous range of
+/// entries. Once its own range is exhausted, a thread steals entries from the ranges of the other threads, so pairs that are
+/// more expensive to update do not leave the other threads idle.
+class SkeletonBatchWorkers : public SpineObject {
+public:
+	static const int MaxThreads = 64;
+
+	SkeletonBatchWorkers(SkeletonBatchUpdater &updater, int threadCount) :
+			_updater(updater),
+			_threadCount(threadCount),
+			_generation(0),
+			_pending(0),
+			_quit(false) {
+		/* The calling thread is worker 0. */
+		for (int i = 1; i < _threadCount; ++i)
+			_threads[i] = std::thread(&SkeletonBatchWorkers::run, this, i);
+	}
+
+	~SkeletonBatchWorkers() {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_quit = true;
+		}
+		_start.notify_all();
+		for (int i = 1; i < _threadCount; ++i)
+			_threads[i].join();
+	}
+
+	void update(size_t count) {
+		for (int i = 0; i < _threadCount; ++i) {
+			_ranges[i].next.store(count * i / _threadCount, std::memory_order_relaxed);
+			_ranges[i].end = count * (i + 1) / _threadCount;
+		}
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_pending = _threadCount - 1;
+			_generation++;
+		}
+		_start.notify_all();
+
+		process(0);
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (_pending > 0)
+			_done.wait(lock);
+	}
+
+	int getThreadCount() {
+		return _threadCount;
+	}
+
+private:
+	struct Range {
+		std::atomic<size_t> next;
+		size_t end;
+	};
+
+	SkeletonBatchUpdater &_updater;
+	int _threadCount;
+	std::thread _threads[MaxThreads];
+	Range _ranges[MaxThreads];
+	std::mutex _mutex;
+	std::condition_variable _start;
+	std::condition_variable _done;
+	size_t _generation;
+	int _pending;
+	bool _quit;
+
+	void run(int worker) {
+		size_t generation = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				while (!_quit && _generation == generation)
+					_start.wait(lock);
+				if (_quit) return;
+				generation = _generation;
+			}
+
+			process(worker);
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_pending == 0) _done.notify_one();
+		}
+	}
+
+	void process(int worker) {
+		/* Own range first, then steal from the others. */
+		for (int i = 0; i < _threadCount; ++i) {
+			Range &range = _ranges[(worker + i) % _threadCount];
+			size_t index;
+			while ((index = range.next.fetch_add(1, std::memory_order_relaxed)) < range.end)
+				_updater.updateEntry(index);
+		}
+	}
+};
+#else
+class SkeletonBatchWorkers : public SpineObject {
+};
+#endif
+}
+
+using namespace spine;
+
+SkeletonBatchUpdater::SkeletonBatchUpdater(int threadCount) : _workers(NULL), _delta(0) {
+#ifndef SPINE_NO_THREADS
+	if (threadCount <= 0) threadCount = (int) std::thread::hardware_concurrency();
+	if (threadCount > SkeletonBatchWorkers::MaxThreads) threadCount = SkeletonBatchWorkers::MaxThreads;
+	if (threadCount > 1) _workers = new(__FILE__, __LINE__) SkeletonBatchWorkers(*this, threadCount);
+#else
+	SP_UNUSED(threadCount);
+#endif
+}
+
+SkeletonBatchUpdater::~SkeletonBatchUpdater() {
+	if (_workers) delete _workers;
+}
+
+void SkeletonBatchUpdater::add(Skeleton &skeleton, AnimationState &state) {
+	for (size_t i = 0, n = _entries.size(); i < n; ++i)
+		assert(_entries[i].skeleton != &skeleton && _entries[i].state != &state);
+	_entries.add(Entry(&skeleton, &state));
+}
+
+bool SkeletonBatchUpdater::remove(Skeleton &skeleton) {
+	for (size_t i = 0, n = _entries.size(); i < n; ++i) {
+		if (_entries[i].skeleton == &skeleton) {
+			_entries.removeAt(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+void SkeletonBatchUpdater::clear() {
+	_entries.clear();
+}
+
+size_t SkeletonBatchUpdater::size() {
+	return _entries.size();
+}
+
+void SkeletonBatchUpdater::update(float delta) {
+	_delta = delta;
+	size_t count = _entries.size();
+#ifndef SPINE_NO_THREADS
+	if (_workers && count > 1) {
+		_workers->update(count);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < count; ++i)
+		updateEntry(i);
+}
+
+int SkeletonBatchUpdater::getThreadCount() {
+#ifndef SPINE_NO_THREADS
+	if (_workers) return _workers->getThreadCount();
+#endif
+	return 1;
+}
+
+void SkeletonBatchUpdater::updateEntry(size_t index) {
+	Entry &entry = _entries[index];
+	entry.state->update(_delta);
+	entry.state->apply(*entry.skeleton);
+	entry.skeleton->updateWorldTransform();
+}
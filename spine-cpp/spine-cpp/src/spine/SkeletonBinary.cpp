@@ -36,6 +36,7 @@
 #include <spine/SkeletonBinary.h>
 
 #include <spine/SkeletonData.h>
+#include <spine/ArenaAllocator.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/LinkedMesh.h>
@@ -75,6 +76,13 @@
 #include <spine/DrawOrderTimeline.h>
 #include <spine/EventTimeline.h>
 #include <spine/Event.h>
+#include <spine/HashMap.h>
+
+#ifndef SPINE_NO_THREADS
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
 
 using namespace spine;
 
@@ -96,12 +104,12 @@ const int SkeletonBinary::CURVE_STEPPED = 1;
 const int SkeletonBinary::CURVE_BEZIER = 2;
 
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
-		new(__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)), _error(), _scale(1), _ownsLoader(true) {
+		new(__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)), _error(), _scale(1), _curveLookupSize(0), _useArena(false), _useInfluenceBuckets(false), _packFrames(false), _quantizeDeform(false), _animationThreads(1), _ownsLoader(true) {
 
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader) : _attachmentLoader(attachmentLoader), _error(),
-	_scale(1), _ownsLoader(false)
+	_scale(1), _curveLookupSize(0), _useArena(false), _useInfluenceBuckets(false), _packFrames(false), _quantizeDeform(false), _animationThreads(1), _ownsLoader(false)
 {
 	assert(_attachmentLoader != NULL);
 }
@@ -124,6 +132,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	_linkedMeshes.clear();
 
 	skeletonData = new(__FILE__, __LINE__) SkeletonData();
+	ArenaScope arenaScope(_useArena ? &skeletonData->_arena : ArenaAllocator::getCurrent());
 
 	char *skeletonData_hash = readString(input);
 	skeletonData->_hash.own(skeletonData_hash);
@@ -299,16 +308,18 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		Skin *skin = linkedMesh->_skin.length() == 0 ? skeletonData->getDefaultSkin() : skeletonData->findSkin(
 			linkedMesh->_skin);
 		if (skin == NULL) {
+			setError("Skin not found: ", linkedMesh->_skin.buffer());
+			ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 			delete input;
 			delete skeletonData;
-			setError("Skin not found: ", linkedMesh->_skin.buffer());
 			return NULL;
 		}
 		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
 		if (parent == NULL) {
+			setError("Parent mesh not found: ", linkedMesh->_parent.buffer());
+			ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 			delete input;
 			delete skeletonData;
-			setError("Parent mesh not found: ", linkedMesh->_parent.buffer());
 			return NULL;
 		}
 		linkedMesh->_mesh->_deformAttachment = linkedMesh->_inheritDeform ? static_cast<VertexAttachment*>(parent) : linkedMesh->_mesh;
@@ -339,35 +350,43 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
-	for (int i = 0; i < animationsCount; ++i) {
-		String name(readString(input), true);
-		Animation *animation = readAnimation(name, input, skeletonData);
-		if (!animation) {
-			delete input;
-			delete skeletonData;
-			return NULL;
-		}
-		skeletonData->_animations[i] = animation;
+	if (!readAnimations(input, skeletonData)) {
+		delete input;
+		delete skeletonData;
+		return NULL;
 	}
 
 	delete input;
+	skeletonData->indexNames();
+	skeletonData->indexAttachments();
 	return skeletonData;
 }
 
 SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
 	int length;
 	SkeletonData *skeletonData;
-	const char *binary = SpineExtension::readFile(path.buffer(), &length);
+	// The file is parsed directly from the mapped memory, the parsed data does not reference it.
+	const char *binary = SpineExtension::mapFile(path.buffer(), &length);
 	if (length == 0 || !binary) {
+		if (binary) SpineExtension::unmapFile(binary, length);
 		setError("Unable to read skeleton file: ", path.buffer());
 		return NULL;
 	}
-	skeletonData = readSkeletonData((unsigned char *) binary, length);
-	SpineExtension::free(binary, __FILE__, __LINE__);
+	skeletonData = readSkeletonData((const unsigned char *) binary, length);
+	SpineExtension::unmapFile(binary, length);
 	return skeletonData;
 }
 
+#ifndef SPINE_NO_THREADS
+// Animations decoded concurrently may fail concurrently.
+static std::mutex errorMutex;
+#endif
+
 void SkeletonBinary::setError(const char *value1, const char *value2) {
+#ifndef SPINE_NO_THREADS
+	std::lock_guard<std::mutex> lock(errorMutex);
+#endif
+	ArenaScope heapScope(NULL);
 	char message[256];
 	int length;
 	strcpy(message, value1);
@@ -562,9 +581,10 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			mesh->_height = readFloat(input) * _scale;
 		}
 
-		LinkedMesh *linkedMesh = new(__FILE__, __LINE__) LinkedMesh(mesh, String(skinName), slotIndex,
-																	String(parent), inheritDeform);
-		_linkedMeshes.add(linkedMesh);
+		{
+			ArenaScope heapScope(NULL); // The linked meshes outlive the skeleton data when loading fails.
+			_linkedMeshes.add(new(__FILE__, __LINE__) LinkedMesh(mesh, skinName, slotIndex, parent, inheritDeform));
+		}
 		return mesh;
 	}
 	case AttachmentType_Path: {
@@ -640,21 +660,29 @@ void SkeletonBinary::readVertices(DataInput *input, VertexAttachment *attachment
 			vertices.add(readFloat(input));
 		}
 	}
+	if (_useInfluenceBuckets) attachment->buildInfluenceBuckets();
 }
 
 void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector<float> &array) {
 	array.setSize(n, 0);
 
-	int i;
-	if (scale == 1) {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input);
-		}
-	} else {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input) * scale;
-		}
+	// Decode the big endian floats straight into the array.
+	const unsigned char *cursor = input->cursor;
+	float *values = array.buffer();
+	union {
+		unsigned int intValue;
+		float floatValue;
+	} intToFloat;
+	for (int i = 0; i < n; ++i, cursor += 4) {
+		intToFloat.intValue = ((unsigned int) cursor[0] << 24) | ((unsigned int) cursor[1] << 16) |
+							  ((unsigned int) cursor[2] << 8) | cursor[3];
+		values[i] = intToFloat.floatValue;
+	}
+	if (scale != 1) {
+		for (int i = 0; i < n; ++i)
+			values[i] *= scale;
 	}
+	input->cursor = cursor;
 }
 
 void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &array) {
@@ -668,6 +696,64 @@ void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &ar
 	}
 }
 
+bool SkeletonBinary::readAnimations(DataInput *input, SkeletonData *skeletonData) {
+	Vector<Animation *> &animations = skeletonData->_animations;
+#ifndef SPINE_NO_THREADS
+	const int maxThreads = 64;
+	int threadCount = _animationThreads > 0 ? _animationThreads : (int) std::thread::hardware_concurrency();
+	if (threadCount > (int) animations.size()) threadCount = (int) animations.size();
+	if (threadCount > maxThreads) threadCount = maxThreads;
+	if (threadCount > 1) {
+		// The animations are stored back to back without their sizes, find where each starts so they can be decoded independently.
+		const unsigned char *start = input->cursor;
+		Vector<const unsigned char *> starts;
+		starts.setSize(animations.size(), NULL);
+		bool skipped = true;
+		for (size_t i = 0; i < animations.size() && skipped; ++i) {
+			starts[i] = input->cursor;
+			skipped = skipAnimation(input, skeletonData);
+		}
+
+		if (skipped) {
+			// The arena of the skeleton data is not thread safe.
+			ArenaScope heapScope(NULL);
+			std::atomic<size_t> next(0);
+			std::atomic<bool> failed(false);
+			const unsigned char *end = input->end;
+			auto decode = [&]() {
+				DataInput animationInput;
+				animationInput.end = end;
+				for (size_t i = next++; i < animations.size() && !failed; i = next++) {
+					animationInput.cursor = starts[i];
+					String name(readString(&animationInput), true);
+					animations[i] = readAnimation(name, &animationInput, skeletonData);
+					if (!animations[i]) failed = true;
+				}
+			};
+
+			std::thread threads[maxThreads];
+			for (int i = 1; i < threadCount; ++i)
+				threads[i] = std::thread(decode);
+			decode();
+			for (int i = 1; i < threadCount; ++i)
+				threads[i].join();
+			return !failed;
+		}
+
+		// Decode the animations in order to report the error of the animation which could not be skipped.
+		input->cursor = start;
+	}
+#endif
+
+	for (size_t i = 0; i < animations.size(); ++i) {
+		String name(readString(input), true);
+		Animation *animation = readAnimation(name, input, skeletonData);
+		if (!animation) return false;
+		animations[i] = animation;
+	}
+	return true;
+}
+
 Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData) {
 	Vector<Timeline *> timelines;
 	float scale = _scale;
@@ -946,6 +1032,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 					timeline->setFrame(frameIndex, time, deform);
 					if (frameIndex < frameCount - 1) readCurve(input, frameIndex, timeline);
 				}
+				if (_quantizeDeform) timeline->quantizeVertices();
 
 				timelines.add(timeline);
 				duration = MathUtil::max(duration, timeline->_frames[frameCount - 1]);
@@ -1023,7 +1110,225 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 		duration = MathUtil::max(duration, timeline->_frames[eventCount - 1]);
 	}
 
-	return new(__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	Animation *animation = new(__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	if (_packFrames) packFrames(animation);
+	return animation;
+}
+
+bool SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData) {
+	// Mirrors readAnimation(), returns false if the animation is invalid.
+	int nameLength = readVarint(input, true);
+	if (nameLength > 0) input->cursor += nameLength - 1;
+
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			int frameSize;
+			if (timelineType == SLOT_ATTACHMENT)
+				frameSize = 0;
+			else if (timelineType == SLOT_COLOR)
+				frameSize = 8;
+			else if (timelineType == SLOT_TWO_COLOR)
+				frameSize = 12;
+			else
+				return false;
+			for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+				if (timelineType == SLOT_ATTACHMENT) {
+					input->cursor += 4;
+					readVarint(input, true);
+					continue;
+				}
+				input->cursor += frameSize;
+				if (frameIndex < frameCount - 1) skipCurve(input);
+			}
+			if (input->cursor > input->end) return false;
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			int frameSize;
+			if (timelineType == BONE_ROTATE)
+				frameSize = 8;
+			else if (timelineType == BONE_TRANSLATE || timelineType == BONE_SCALE || timelineType == BONE_SHEAR)
+				frameSize = 12;
+			else
+				return false;
+			for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+				input->cursor += frameSize;
+				if (frameIndex < frameCount - 1) skipCurve(input);
+			}
+			if (input->cursor > input->end) return false;
+		}
+	}
+
+	// IK timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+			input->cursor += 15;
+			if (frameIndex < frameCount - 1) skipCurve(input);
+		}
+		if (input->cursor > input->end) return false;
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+			input->cursor += 20;
+			if (frameIndex < frameCount - 1) skipCurve(input);
+		}
+		if (input->cursor > input->end) return false;
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int timelineType = readSByte(input);
+			int frameCount = readVarint(input, true);
+			int frameSize;
+			if (timelineType == PATH_POSITION || timelineType == PATH_SPACING)
+				frameSize = 8;
+			else if (timelineType == PATH_MIX)
+				frameSize = 12;
+			else
+				continue;
+			for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+				input->cursor += frameSize;
+				if (frameIndex < frameCount - 1) skipCurve(input);
+			}
+			if (input->cursor > input->end) return false;
+		}
+	}
+
+	// Deform timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				readVarint(input, true);
+				int frameCount = readVarint(input, true);
+				for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+					input->cursor += 4;
+					int end = readVarint(input, true);
+					if (end != 0) {
+						readVarint(input, true);
+						input->cursor += end * 4;
+					}
+					if (frameIndex < frameCount - 1) skipCurve(input);
+				}
+				if (input->cursor > input->end) return false;
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		input->cursor += 4;
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+		if (input->cursor > input->end) return false;
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		input->cursor += 4;
+		int eventIndex = readVarint(input, true);
+		if (eventIndex < 0 || eventIndex >= (int) skeletonData->_events.size()) return false;
+		readVarint(input, false);
+		input->cursor += 4;
+		if (readBoolean(input)) {
+			int length = readVarint(input, true);
+			if (length > 0) input->cursor += length - 1;
+		}
+		if (!skeletonData->_events[eventIndex]->_audioPath.isEmpty()) input->cursor += 8;
+		if (input->cursor > input->end) return false;
+	}
+
+	return input->cursor <= input->end;
+}
+
+void SkeletonBinary::skipCurve(DataInput *input) {
+	if (readByte(input) == CURVE_BEZIER) input->cursor += 16;
+}
+
+void SkeletonBinary::getFrameVectors(Timeline *timeline, Vector<Vector<float> *> &vectors) {
+	const RTTI &rtti = timeline->getRTTI();
+	if (rtti.instanceOf(RotateTimeline::rtti))
+		vectors.add(&static_cast<RotateTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(TranslateTimeline::rtti))
+		vectors.add(&static_cast<TranslateTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(ColorTimeline::rtti))
+		vectors.add(&static_cast<ColorTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(TwoColorTimeline::rtti))
+		vectors.add(&static_cast<TwoColorTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(IkConstraintTimeline::rtti))
+		vectors.add(&static_cast<IkConstraintTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(TransformConstraintTimeline::rtti))
+		vectors.add(&static_cast<TransformConstraintTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(PathConstraintPositionTimeline::rtti))
+		vectors.add(&static_cast<PathConstraintPositionTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(PathConstraintMixTimeline::rtti))
+		vectors.add(&static_cast<PathConstraintMixTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(AttachmentTimeline::rtti))
+		vectors.add(&static_cast<AttachmentTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(DrawOrderTimeline::rtti))
+		vectors.add(&static_cast<DrawOrderTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(EventTimeline::rtti))
+		vectors.add(&static_cast<EventTimeline *>(timeline)->_frames);
+	else if (rtti.instanceOf(DeformTimeline::rtti))
+		vectors.add(&static_cast<DeformTimeline *>(timeline)->_frames);
+
+	if (rtti.instanceOf(CurveTimeline::rtti)) {
+		CurveTimeline *curveTimeline = static_cast<CurveTimeline *>(timeline);
+		vectors.add(&curveTimeline->_curves);
+		vectors.add(&curveTimeline->_curveLookup);
+	}
+
+	if (rtti.instanceOf(DeformTimeline::rtti)) {
+		Vector<Vector<float> > &frameVertices = static_cast<DeformTimeline *>(timeline)->_frameVertices;
+		for (size_t i = 0, n = frameVertices.size(); i < n; ++i)
+			vectors.add(&frameVertices[i]);
+	}
+}
+
+void SkeletonBinary::packFrames(Animation *animation) {
+	Vector<Vector<float> *> vectors;
+	Vector<Timeline *> &timelines = animation->_timelines;
+	for (size_t i = 0, n = timelines.size(); i < n; ++i)
+		getFrameVectors(timelines[i], vectors);
+
+	size_t size = 0;
+	for (size_t i = 0, n = vectors.size(); i < n; ++i)
+		size += vectors[i]->size();
+	if (size == 0) return;
+
+	// Each timeline's frames are followed by its curves, so apply() reads one region of memory per timeline.
+	Vector<float> &packed = animation->_packedFrames;
+	packed.ensureCapacity(size);
+	packed.setSize(size, 0);
+	float *buffer = packed.buffer();
+	for (size_t i = 0, n = vectors.size(); i < n; ++i) {
+		Vector<float> &vector = *vectors[i];
+		size_t count = vector.size();
+		if (count > 0) memcpy(buffer, vector.buffer(), count * sizeof(float));
+		vector.setView(buffer, count);
+		buffer += count;
+	}
 }
 
 void SkeletonBinary::readCurve(DataInput *input, int frameIndex, CurveTimeline *timeline) {
@@ -1037,8 +1342,854 @@ void SkeletonBinary::readCurve(DataInput *input, int frameIndex, CurveTimeline *
 		float cy1 = readFloat(input);
 		float cx2 = readFloat(input);
 		float cy2 = readFloat(input);
+		timeline->setCurveLookupSize(_curveLookupSize);
 		timeline->setCurve(frameIndex, cx1, cy1, cx2, cy2);
 		break;
 	}
 	}
 }
+
+struct SkeletonBinary::DataOutput : public SpineObject {
+	Vector<unsigned char> *bytes;
+	Vector<String> strings;
+	HashMap<String, int> stringIndices;
+};
+
+bool SkeletonBinary::writeSkeletonData(SkeletonData *skeletonData, Vector<unsigned char> &output) {
+	_error = "";
+	float scale = _scale;
+
+	// The strings are collected while writing the body and written before it.
+	Vector<unsigned char> body;
+	DataOutput *bodyOutput = new(__FILE__, __LINE__) DataOutput();
+	bodyOutput->bytes = &body;
+	DataOutput *headerOutput = new(__FILE__, __LINE__) DataOutput();
+	headerOutput->bytes = &output;
+	output.clear();
+
+	writeString(headerOutput, skeletonData->_hash);
+	writeString(headerOutput, skeletonData->_version);
+	writeFloat(headerOutput, skeletonData->_x);
+	writeFloat(headerOutput, skeletonData->_y);
+	writeFloat(headerOutput, skeletonData->_width);
+	writeFloat(headerOutput, skeletonData->_height);
+	writeBoolean(headerOutput, true); // Nonessential.
+	writeFloat(headerOutput, skeletonData->_fps);
+	writeString(headerOutput, skeletonData->_imagesPath);
+	writeString(headerOutput, skeletonData->_audioPath);
+
+	/* Bones. */
+	DataOutput *out = bodyOutput;
+	Vector<BoneData *> &bones = skeletonData->_bones;
+	writeVarint(out, (int) bones.size(), true);
+	for (size_t i = 0; i < bones.size(); ++i) {
+		BoneData *data = bones[i];
+		writeString(out, data->_name);
+		if (i > 0) writeVarint(out, data->_parent->_index, true);
+		writeFloat(out, data->_rotation);
+		writeFloat(out, data->_x / scale);
+		writeFloat(out, data->_y / scale);
+		writeFloat(out, data->_scaleX);
+		writeFloat(out, data->_scaleY);
+		writeFloat(out, data->_shearX);
+		writeFloat(out, data->_shearY);
+		writeFloat(out, data->_length / scale);
+		writeVarint(out, data->_transformMode, true);
+		writeBoolean(out, data->_skinRequired);
+		writeInt(out, (int) 0x9b9b9bff); // Bone color, not stored in the bone data.
+	}
+
+	/* Slots. */
+	Vector<SlotData *> &slots = skeletonData->_slots;
+	writeVarint(out, (int) slots.size(), true);
+	for (size_t i = 0; i < slots.size(); ++i) {
+		SlotData *data = slots[i];
+		writeString(out, data->_name);
+		writeVarint(out, data->_boneData._index, true);
+		writeColor(out, data->_color);
+		if (data->_hasDarkColor) {
+			Color dark(data->_darkColor.r, data->_darkColor.g, data->_darkColor.b, 0);
+			writeColor(out, dark);
+		} else
+			writeInt(out, -1);
+		writeStringRef(out, data->_attachmentName);
+		writeVarint(out, data->_blendMode, true);
+	}
+
+	/* IK constraints. */
+	writeVarint(out, (int) skeletonData->_ikConstraints.size(), true);
+	for (size_t i = 0; i < skeletonData->_ikConstraints.size(); ++i) {
+		IkConstraintData *data = skeletonData->_ikConstraints[i];
+		writeString(out, data->getName());
+		writeVarint(out, (int) data->getOrder(), true);
+		writeBoolean(out, data->isSkinRequired());
+		writeVarint(out, (int) data->_bones.size(), true);
+		for (size_t ii = 0; ii < data->_bones.size(); ++ii)
+			writeVarint(out, data->_bones[ii]->_index, true);
+		writeVarint(out, data->_target->_index, true);
+		writeFloat(out, data->_mix);
+		writeFloat(out, data->_softness / scale);
+		writeByte(out, (unsigned char) (signed char) data->_bendDirection);
+		writeBoolean(out, data->_compress);
+		writeBoolean(out, data->_stretch);
+		writeBoolean(out, data->_uniform);
+	}
+
+	/* Transform constraints. */
+	writeVarint(out, (int) skeletonData->_transformConstraints.size(), true);
+	for (size_t i = 0; i < skeletonData->_transformConstraints.size(); ++i) {
+		TransformConstraintData *data = skeletonData->_transformConstraints[i];
+		writeString(out, data->getName());
+		writeVarint(out, (int) data->getOrder(), true);
+		writeBoolean(out, data->isSkinRequired());
+		writeVarint(out, (int) data->_bones.size(), true);
+		for (size_t ii = 0; ii < data->_bones.size(); ++ii)
+			writeVarint(out, data->_bones[ii]->_index, true);
+		if (data->_bones.size() > 0) writeVarint(out, data->_target->_index, true);
+		writeBoolean(out, data->_local);
+		writeBoolean(out, data->_relative);
+		writeFloat(out, data->_offsetRotation);
+		writeFloat(out, data->_offsetX / scale);
+		writeFloat(out, data->_offsetY / scale);
+		writeFloat(out, data->_offsetScaleX);
+		writeFloat(out, data->_offsetScaleY);
+		writeFloat(out, data->_offsetShearY);
+		writeFloat(out, data->_rotateMix);
+		writeFloat(out, data->_translateMix);
+		writeFloat(out, data->_scaleMix);
+		writeFloat(out, data->_shearMix);
+	}
+
+	/* Path constraints. */
+	writeVarint(out, (int) skeletonData->_pathConstraints.size(), true);
+	for (size_t i = 0; i < skeletonData->_pathConstraints.size(); ++i) {
+		PathConstraintData *data = skeletonData->_pathConstraints[i];
+		writeString(out, data->getName());
+		writeVarint(out, (int) data->getOrder(), true);
+		writeBoolean(out, data->isSkinRequired());
+		writeVarint(out, (int) data->_bones.size(), true);
+		for (size_t ii = 0; ii < data->_bones.size(); ++ii)
+			writeVarint(out, data->_bones[ii]->_index, true);
+		writeVarint(out, data->_target->_index, true);
+		writeVarint(out, data->_positionMode, true);
+		writeVarint(out, data->_spacingMode, true);
+		writeVarint(out, data->_rotateMode, true);
+		writeFloat(out, data->_offsetRotation);
+		writeFloat(out, data->_positionMode == PositionMode_Fixed ? data->_position / scale : data->_position);
+		bool spacingScaled = data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed;
+		writeFloat(out, spacingScaled ? data->_spacing / scale : data->_spacing);
+		writeFloat(out, data->_rotateMix);
+		writeFloat(out, data->_translateMix);
+	}
+
+	/* Skins, the default skin first. */
+	Vector<Skin *> skins;
+	if (skeletonData->_defaultSkin) skins.add(skeletonData->_defaultSkin);
+	for (size_t i = 0; i < skeletonData->_skins.size(); ++i)
+		if (skeletonData->_skins[i] != skeletonData->_defaultSkin) skins.add(skeletonData->_skins[i]);
+	bool written = skeletonData->_defaultSkin ? writeSkin(out, skeletonData->_defaultSkin, skeletonData, skins) : true;
+	if (!skeletonData->_defaultSkin) writeVarint(out, 0, true);
+	size_t firstSkin = skeletonData->_defaultSkin ? 1 : 0;
+	writeVarint(out, (int) (skins.size() - firstSkin), true);
+	for (size_t i = firstSkin; i < skins.size() && written; ++i)
+		written = writeSkin(out, skins[i], skeletonData, skins);
+
+	/* Events. */
+	if (written) {
+		writeVarint(out, (int) skeletonData->_events.size(), true);
+		for (size_t i = 0; i < skeletonData->_events.size(); ++i) {
+			EventData *data = skeletonData->_events[i];
+			writeStringRef(out, data->_name);
+			writeVarint(out, data->_intValue, false);
+			writeFloat(out, data->_floatValue);
+			writeString(out, data->_stringValue);
+			writeString(out, data->_audioPath);
+			if (!data->_audioPath.isEmpty()) {
+				writeFloat(out, data->_volume);
+				writeFloat(out, data->_balance);
+			}
+		}
+	}
+
+	/* Animations. */
+	if (written) {
+		writeVarint(out, (int) skeletonData->_animations.size(), true);
+		for (size_t i = 0; i < skeletonData->_animations.size() && written; ++i)
+			written = writeAnimation(out, skeletonData->_animations[i], skeletonData, skins);
+	}
+
+	if (written) {
+		writeVarint(headerOutput, (int) bodyOutput->strings.size(), true);
+		for (size_t i = 0; i < bodyOutput->strings.size(); ++i)
+			writeString(headerOutput, bodyOutput->strings[i]);
+		output.addAll(body);
+	} else
+		output.clear();
+	delete headerOutput;
+	delete bodyOutput;
+	return written;
+}
+
+bool SkeletonBinary::writeSkeletonDataFile(SkeletonData *skeletonData, const String &path) {
+	Vector<unsigned char> output;
+	if (!writeSkeletonData(skeletonData, output)) return false;
+	FILE *file = fopen(path.buffer(), "wb");
+	if (!file) {
+		setError("Unable to write skeleton file: ", path.buffer());
+		return false;
+	}
+	bool written = fwrite(output.buffer(), 1, output.size(), file) == output.size();
+	if (fclose(file) != 0) written = false;
+	if (!written) setError("Unable to write skeleton file: ", path.buffer());
+	return written;
+}
+
+void SkeletonBinary::writeString(DataOutput *output, const String &value) {
+	if (value.isEmpty()) {
+		// Empty strings are read as NULL.
+		writeVarint(output, 0, true);
+		return;
+	}
+	writeVarint(output, (int) value.length() + 1, true);
+	for (size_t i = 0; i < value.length(); ++i)
+		writeByte(output, (unsigned char) value.buffer()[i]);
+}
+
+void SkeletonBinary::writeStringRef(DataOutput *output, const String &value) {
+	if (value.isEmpty()) {
+		writeVarint(output, 0, true);
+		return;
+	}
+	if (!output->stringIndices.containsKey(value)) {
+		output->strings.add(value);
+		output->stringIndices.put(value, (int) output->strings.size());
+	}
+	writeVarint(output, output->stringIndices[value], true);
+}
+
+void SkeletonBinary::writeFloat(DataOutput *output, float value) {
+	union {
+		int intValue;
+		float floatValue;
+	} floatToInt;
+	floatToInt.floatValue = value;
+	writeInt(output, floatToInt.intValue);
+}
+
+void SkeletonBinary::writeByte(DataOutput *output, unsigned char value) {
+	output->bytes->add(value);
+}
+
+void SkeletonBinary::writeBoolean(DataOutput *output, bool value) {
+	writeByte(output, value ? 1 : 0);
+}
+
+void SkeletonBinary::writeInt(DataOutput *output, int value) {
+	writeByte(output, (unsigned char) ((unsigned int) value >> 24));
+	writeByte(output, (unsigned char) ((unsigned int) value >> 16));
+	writeByte(output, (unsigned char) ((unsigned int) value >> 8));
+	writeByte(output, (unsigned char) value);
+}
+
+static unsigned char toByte(float value) {
+	return (unsigned char) (MathUtil::clamp(value, 0, 1) * 255 + 0.5f);
+}
+
+void SkeletonBinary::writeColor(DataOutput *output, Color &color) {
+	writeByte(output, toByte(color.r));
+	writeByte(output, toByte(color.g));
+	writeByte(output, toByte(color.b));
+	writeByte(output, toByte(color.a));
+}
+
+void SkeletonBinary::writeVarint(DataOutput *output, int value, bool optimizePositive) {
+	unsigned int bits = optimizePositive ? (unsigned int) value : ((unsigned int) value << 1) ^ (unsigned int) (value >> 31);
+	while (bits > 0x7F) {
+		writeByte(output, (unsigned char) ((bits & 0x7F) | 0x80));
+		bits >>= 7;
+	}
+	writeByte(output, (unsigned char) bits);
+}
+
+bool SkeletonBinary::writeSkin(DataOutput *output, Skin *skin, SkeletonData *skeletonData, Vector<Skin *> &skins) {
+	if (skin != skeletonData->_defaultSkin) {
+		writeStringRef(output, skin->getName());
+		writeVarint(output, (int) skin->getBones().size(), true);
+		for (size_t i = 0; i < skin->getBones().size(); ++i)
+			writeVarint(output, skin->getBones()[i]->_index, true);
+
+		// The constraints of a skin are stored by type.
+		Vector<ConstraintData *> &constraints = skin->getConstraints();
+		Vector<int> ikIndices, transformIndices, pathIndices;
+		for (size_t i = 0; i < constraints.size(); ++i) {
+			int index = skeletonData->_ikConstraints.indexOf(static_cast<IkConstraintData *>(constraints[i]));
+			if (index >= 0) {
+				ikIndices.add(index);
+				continue;
+			}
+			index = skeletonData->_transformConstraints.indexOf(static_cast<TransformConstraintData *>(constraints[i]));
+			if (index >= 0) {
+				transformIndices.add(index);
+				continue;
+			}
+			index = skeletonData->_pathConstraints.indexOf(static_cast<PathConstraintData *>(constraints[i]));
+			if (index >= 0) pathIndices.add(index);
+		}
+		Vector<int> *indices[] = {&ikIndices, &transformIndices, &pathIndices};
+		for (int i = 0; i < 3; ++i) {
+			writeVarint(output, (int) indices[i]->size(), true);
+			for (size_t ii = 0; ii < indices[i]->size(); ++ii)
+				writeVarint(output, (*indices[i])[ii], true);
+		}
+	}
+
+	Vector<String> names;
+	int slotCount = 0;
+	for (size_t i = 0; i < skeletonData->_slots.size(); ++i) {
+		names.clear();
+		skin->findNamesForSlot(i, names);
+		if (names.size() > 0) slotCount++;
+	}
+	writeVarint(output, slotCount, true);
+	for (size_t i = 0; i < skeletonData->_slots.size(); ++i) {
+		names.clear();
+		skin->findNamesForSlot(i, names);
+		if (names.size() == 0) continue;
+		writeVarint(output, (int) i, true);
+		writeVarint(output, (int) names.size(), true);
+		for (size_t ii = 0; ii < names.size(); ++ii) {
+			writeStringRef(output, names[ii]);
+			if (!writeAttachment(output, skin->getAttachment(i, names[ii]), names[ii], skeletonData, skins)) return false;
+		}
+	}
+	return true;
+}
+
+bool SkeletonBinary::writeAttachment(DataOutput *output, Attachment *attachment, const String &attachmentName,
+	SkeletonData *skeletonData, Vector<Skin *> &skins
+) {
+	float scale = _scale;
+	const String &name = attachment->getName();
+	writeStringRef(output, name == attachmentName ? String() : name);
+
+	const RTTI &rtti = attachment->getRTTI();
+	if (rtti.isExactly(RegionAttachment::rtti)) {
+		RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+		writeByte(output, AttachmentType_Region);
+		writeStringRef(output, region->_path == name ? String() : region->_path);
+		writeFloat(output, region->_rotation);
+		writeFloat(output, region->_x / scale);
+		writeFloat(output, region->_y / scale);
+		writeFloat(output, region->_scaleX);
+		writeFloat(output, region->_scaleY);
+		writeFloat(output, region->_width / scale);
+		writeFloat(output, region->_height / scale);
+		writeColor(output, region->_color);
+	} else if (rtti.isExactly(BoundingBoxAttachment::rtti)) {
+		VertexAttachment *box = static_cast<VertexAttachment *>(attachment);
+		writeByte(output, AttachmentType_Boundingbox);
+		writeVarint(output, (int) (box->_worldVerticesLength >> 1), true);
+		writeVertices(output, box);
+		writeInt(output, -1); // Color, not stored in the attachment.
+	} else if (rtti.isExactly(MeshAttachment::rtti)) {
+		MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+		MeshAttachment *parent = mesh->_parentMesh;
+		if (!parent) {
+			writeByte(output, AttachmentType_Mesh);
+			writeStringRef(output, mesh->_path == name ? String() : mesh->_path);
+			writeColor(output, mesh->_color);
+			writeVarint(output, (int) (mesh->_worldVerticesLength >> 1), true);
+			writeFloatArray(output, mesh->_regionUVs, 1);
+			writeShortArray(output, mesh->_triangles);
+			writeVertices(output, mesh);
+			writeVarint(output, mesh->_hullLength >> 1, true);
+			writeShortArray(output, mesh->_edges);
+			writeFloat(output, mesh->_width / scale);
+			writeFloat(output, mesh->_height / scale);
+		} else {
+			// Find the skin and name of the parent mesh.
+			Skin *parentSkin = NULL;
+			String parentName;
+			Vector<String> names;
+			for (size_t i = 0; i < skins.size() && !parentSkin; ++i) {
+				for (size_t slotIndex = 0; slotIndex < skeletonData->_slots.size() && !parentSkin; ++slotIndex) {
+					names.clear();
+					skins[i]->findNamesForSlot(slotIndex, names);
+					for (size_t ii = 0; ii < names.size(); ++ii) {
+						if (skins[i]->getAttachment(slotIndex, names[ii]) == parent) {
+							parentSkin = skins[i];
+							parentName = names[ii];
+							break;
+						}
+					}
+				}
+			}
+			if (!parentSkin) {
+				setError("Parent mesh not found: ", name.buffer());
+				return false;
+			}
+			writeByte(output, AttachmentType_Linkedmesh);
+			writeStringRef(output, mesh->_path == name ? String() : mesh->_path);
+			writeColor(output, mesh->_color);
+			writeStringRef(output, parentSkin == skeletonData->_defaultSkin ? String() : parentSkin->getName());
+			writeStringRef(output, parentName);
+			writeBoolean(output, mesh->_deformAttachment == parent);
+			writeFloat(output, mesh->_width / scale);
+			writeFloat(output, mesh->_height / scale);
+		}
+	} else if (rtti.isExactly(PathAttachment::rtti)) {
+		PathAttachment *path = static_cast<PathAttachment *>(attachment);
+		writeByte(output, AttachmentType_Path);
+		writeBoolean(output, path->_closed);
+		writeBoolean(output, path->_constantSpeed);
+		writeVarint(output, (int) (path->_worldVerticesLength >> 1), true);
+		writeVertices(output, path);
+		for (size_t i = 0; i < path->_lengths.size(); ++i)
+			writeFloat(output, path->_lengths[i] / scale);
+		writeInt(output, -1); // Color, not stored in the attachment.
+	} else if (rtti.isExactly(PointAttachment::rtti)) {
+		PointAttachment *point = static_cast<PointAttachment *>(attachment);
+		writeByte(output, AttachmentType_Point);
+		writeFloat(output, point->_rotation);
+		writeFloat(output, point->_x / scale);
+		writeFloat(output, point->_y / scale);
+		writeInt(output, -1); // Color, not stored in the attachment.
+	} else if (rtti.isExactly(ClippingAttachment::rtti)) {
+		ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
+		writeByte(output, AttachmentType_Clipping);
+		writeVarint(output, clip->_endSlot ? clip->_endSlot->_index : 0, true);
+		writeVarint(output, (int) (clip->_worldVerticesLength >> 1), true);
+		writeVertices(output, clip);
+		writeInt(output, -1); // Color, not stored in the attachment.
+	} else {
+		setError("Unsupported attachment type: ", name.buffer());
+		return false;
+	}
+	return true;
+}
+
+void SkeletonBinary::writeVertices(DataOutput *output, VertexAttachment *attachment) {
+	float scale = _scale;
+	Vector<float> &vertices = attachment->_vertices;
+	Vector<size_t> &bones = attachment->_bones;
+	writeBoolean(output, bones.size() > 0);
+	if (bones.size() == 0) {
+		writeFloatArray(output, vertices, scale);
+		return;
+	}
+	for (size_t v = 0, b = 0; b < bones.size();) {
+		int boneCount = (int) bones[b++];
+		writeVarint(output, boneCount, true);
+		for (int i = 0; i < boneCount; ++i, ++b, v += 3) {
+			writeVarint(output, (int) bones[b], true);
+			writeFloat(output, vertices[v] / scale);
+			writeFloat(output, vertices[v + 1] / scale);
+			writeFloat(output, vertices[v + 2]);
+		}
+	}
+}
+
+void SkeletonBinary::writeFloatArray(DataOutput *output, Vector<float> &array, float scale) {
+	for (size_t i = 0; i < array.size(); ++i)
+		writeFloat(output, array[i] / scale);
+}
+
+void SkeletonBinary::writeShortArray(DataOutput *output, Vector<unsigned short> &array) {
+	writeVarint(output, (int) array.size(), true);
+	for (size_t i = 0; i < array.size(); ++i) {
+		writeByte(output, (unsigned char) (array[i] >> 8));
+		writeByte(output, (unsigned char) array[i]);
+	}
+}
+
+bool SkeletonBinary::writeAnimation(DataOutput *output, Animation *animation, SkeletonData *skeletonData, Vector<Skin *> &skins) {
+	float scale = _scale;
+	Vector<Timeline *> &timelines = animation->_timelines;
+
+	// Group the timelines the way they are stored.
+	Vector< Vector<Timeline *> > slotTimelines, boneTimelines, pathTimelines;
+	slotTimelines.setSize(skeletonData->_slots.size(), Vector<Timeline *>());
+	boneTimelines.setSize(skeletonData->_bones.size(), Vector<Timeline *>());
+	pathTimelines.setSize(skeletonData->_pathConstraints.size(), Vector<Timeline *>());
+	Vector<IkConstraintTimeline *> ikTimelines;
+	Vector<TransformConstraintTimeline *> transformTimelines;
+	Vector<DeformTimeline *> deformTimelines;
+	DrawOrderTimeline *drawOrderTimeline = NULL;
+	EventTimeline *eventTimeline = NULL;
+	for (size_t i = 0; i < timelines.size(); ++i) {
+		Timeline *timeline = timelines[i];
+		const RTTI &rtti = timeline->getRTTI();
+		if (rtti.isExactly(AttachmentTimeline::rtti))
+			slotTimelines[static_cast<AttachmentTimeline *>(timeline)->_slotIndex].add(timeline);
+		else if (rtti.isExactly(ColorTimeline::rtti))
+			slotTimelines[static_cast<ColorTimeline *>(timeline)->_slotIndex].add(timeline);
+		else if (rtti.isExactly(TwoColorTimeline::rtti))
+			slotTimelines[static_cast<TwoColorTimeline *>(timeline)->_slotIndex].add(timeline);
+		else if (rtti.isExactly(RotateTimeline::rtti))
+			boneTimelines[static_cast<RotateTimeline *>(timeline)->_boneIndex].add(timeline);
+		else if (rtti.isExactly(TranslateTimeline::rtti) || rtti.isExactly(ScaleTimeline::rtti) || rtti.isExactly(ShearTimeline::rtti))
+			boneTimelines[static_cast<TranslateTimeline *>(timeline)->_boneIndex].add(timeline);
+		else if (rtti.isExactly(IkConstraintTimeline::rtti))
+			ikTimelines.add(static_cast<IkConstraintTimeline *>(timeline));
+		else if (rtti.isExactly(TransformConstraintTimeline::rtti))
+			transformTimelines.add(static_cast<TransformConstraintTimeline *>(timeline));
+		else if (rtti.isExactly(PathConstraintPositionTimeline::rtti) || rtti.isExactly(PathConstraintSpacingTimeline::rtti))
+			pathTimelines[static_cast<PathConstraintPositionTimeline *>(timeline)->_pathConstraintIndex].add(timeline);
+		else if (rtti.isExactly(PathConstraintMixTimeline::rtti))
+			pathTimelines[static_cast<PathConstraintMixTimeline *>(timeline)->_pathConstraintIndex].add(timeline);
+		else if (rtti.isExactly(DeformTimeline::rtti))
+			deformTimelines.add(static_cast<DeformTimeline *>(timeline));
+		else if (rtti.isExactly(DrawOrderTimeline::rtti) && !drawOrderTimeline)
+			drawOrderTimeline = static_cast<DrawOrderTimeline *>(timeline);
+		else if (rtti.isExactly(EventTimeline::rtti) && !eventTimeline)
+			eventTimeline = static_cast<EventTimeline *>(timeline);
+		else {
+			setError("Unsupported timeline type in animation: ", animation->_name.buffer());
+			return false;
+		}
+	}
+
+	writeString(output, animation->_name);
+
+	// Slot timelines.
+	int count = 0;
+	for (size_t i = 0; i < slotTimelines.size(); ++i)
+		if (slotTimelines[i].size() > 0) count++;
+	writeVarint(output, count, true);
+	for (size_t i = 0; i < slotTimelines.size(); ++i) {
+		if (slotTimelines[i].size() == 0) continue;
+		writeVarint(output, (int) i, true);
+		writeVarint(output, (int) slotTimelines[i].size(), true);
+		for (size_t ii = 0; ii < slotTimelines[i].size(); ++ii) {
+			Timeline *timeline = slotTimelines[i][ii];
+			if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
+				AttachmentTimeline *attachmentTimeline = static_cast<AttachmentTimeline *>(timeline);
+				size_t frameCount = attachmentTimeline->_frames.size();
+				writeByte(output, SLOT_ATTACHMENT);
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+					writeFloat(output, attachmentTimeline->_frames[frameIndex]);
+					writeStringRef(output, attachmentTimeline->_attachmentNames[frameIndex]);
+				}
+			} else if (timeline->getRTTI().isExactly(ColorTimeline::rtti)) {
+				ColorTimeline *colorTimeline = static_cast<ColorTimeline *>(timeline);
+				Vector<float> &frames = colorTimeline->_frames;
+				size_t frameCount = frames.size() / ColorTimeline::ENTRIES;
+				writeByte(output, SLOT_COLOR);
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += ColorTimeline::ENTRIES) {
+					writeFloat(output, frames[f]);
+					Color color(frames[f + 1], frames[f + 2], frames[f + 3], frames[f + 4]);
+					writeColor(output, color);
+					if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, colorTimeline);
+				}
+			} else {
+				TwoColorTimeline *colorTimeline = static_cast<TwoColorTimeline *>(timeline);
+				Vector<float> &frames = colorTimeline->_frames;
+				size_t frameCount = frames.size() / TwoColorTimeline::ENTRIES;
+				writeByte(output, SLOT_TWO_COLOR);
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += TwoColorTimeline::ENTRIES) {
+					writeFloat(output, frames[f]);
+					Color color(frames[f + 1], frames[f + 2], frames[f + 3], frames[f + 4]);
+					writeColor(output, color);
+					writeByte(output, 0); // 0x00rrggbb
+					writeByte(output, toByte(frames[f + 5]));
+					writeByte(output, toByte(frames[f + 6]));
+					writeByte(output, toByte(frames[f + 7]));
+					if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, colorTimeline);
+				}
+			}
+		}
+	}
+
+	// Bone timelines.
+	count = 0;
+	for (size_t i = 0; i < boneTimelines.size(); ++i)
+		if (boneTimelines[i].size() > 0) count++;
+	writeVarint(output, count, true);
+	for (size_t i = 0; i < boneTimelines.size(); ++i) {
+		if (boneTimelines[i].size() == 0) continue;
+		writeVarint(output, (int) i, true);
+		writeVarint(output, (int) boneTimelines[i].size(), true);
+		for (size_t ii = 0; ii < boneTimelines[i].size(); ++ii) {
+			Timeline *timeline = boneTimelines[i][ii];
+			const RTTI &rtti = timeline->getRTTI();
+			if (rtti.isExactly(RotateTimeline::rtti)) {
+				RotateTimeline *rotateTimeline = static_cast<RotateTimeline *>(timeline);
+				Vector<float> &frames = rotateTimeline->_frames;
+				size_t frameCount = frames.size() / RotateTimeline::ENTRIES;
+				writeByte(output, BONE_ROTATE);
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += RotateTimeline::ENTRIES) {
+					writeFloat(output, frames[f]);
+					writeFloat(output, frames[f + 1]);
+					if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, rotateTimeline);
+				}
+			} else {
+				TranslateTimeline *translateTimeline = static_cast<TranslateTimeline *>(timeline);
+				Vector<float> &frames = translateTimeline->_frames;
+				size_t frameCount = frames.size() / TranslateTimeline::ENTRIES;
+				float timelineScale = 1;
+				if (rtti.isExactly(ScaleTimeline::rtti))
+					writeByte(output, BONE_SCALE);
+				else if (rtti.isExactly(ShearTimeline::rtti))
+					writeByte(output, BONE_SHEAR);
+				else {
+					writeByte(output, BONE_TRANSLATE);
+					timelineScale = scale;
+				}
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += TranslateTimeline::ENTRIES) {
+					writeFloat(output, frames[f]);
+					writeFloat(output, frames[f + 1] / timelineScale);
+					writeFloat(output, frames[f + 2] / timelineScale);
+					if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, translateTimeline);
+				}
+			}
+		}
+	}
+
+	// IK timelines.
+	writeVarint(output, (int) ikTimelines.size(), true);
+	for (size_t i = 0; i < ikTimelines.size(); ++i) {
+		IkConstraintTimeline *timeline = ikTimelines[i];
+		Vector<float> &frames = timeline->_frames;
+		size_t frameCount = frames.size() / IkConstraintTimeline::ENTRIES;
+		writeVarint(output, timeline->_ikConstraintIndex, true);
+		writeVarint(output, (int) frameCount, true);
+		for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += IkConstraintTimeline::ENTRIES) {
+			writeFloat(output, frames[f]);
+			writeFloat(output, frames[f + 1]);
+			writeFloat(output, frames[f + 2] / scale);
+			writeByte(output, (unsigned char) (signed char) frames[f + 3]);
+			writeBoolean(output, frames[f + 4] != 0);
+			writeBoolean(output, frames[f + 5] != 0);
+			if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, timeline);
+		}
+	}
+
+	// Transform constraint timelines.
+	writeVarint(output, (int) transformTimelines.size(), true);
+	for (size_t i = 0; i < transformTimelines.size(); ++i) {
+		TransformConstraintTimeline *timeline = transformTimelines[i];
+		Vector<float> &frames = timeline->_frames;
+		size_t frameCount = frames.size() / TransformConstraintTimeline::ENTRIES;
+		writeVarint(output, timeline->_transformConstraintIndex, true);
+		writeVarint(output, (int) frameCount, true);
+		for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += TransformConstraintTimeline::ENTRIES) {
+			for (int ii = 0; ii < TransformConstraintTimeline::ENTRIES; ++ii)
+				writeFloat(output, frames[f + ii]);
+			if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, timeline);
+		}
+	}
+
+	// Path constraint timelines.
+	count = 0;
+	for (size_t i = 0; i < pathTimelines.size(); ++i)
+		if (pathTimelines[i].size() > 0) count++;
+	writeVarint(output, count, true);
+	for (size_t i = 0; i < pathTimelines.size(); ++i) {
+		if (pathTimelines[i].size() == 0) continue;
+		PathConstraintData *data = skeletonData->_pathConstraints[i];
+		writeVarint(output, (int) i, true);
+		writeVarint(output, (int) pathTimelines[i].size(), true);
+		for (size_t ii = 0; ii < pathTimelines[i].size(); ++ii) {
+			Timeline *timeline = pathTimelines[i][ii];
+			const RTTI &rtti = timeline->getRTTI();
+			if (rtti.isExactly(PathConstraintMixTimeline::rtti)) {
+				PathConstraintMixTimeline *mixTimeline = static_cast<PathConstraintMixTimeline *>(timeline);
+				Vector<float> &frames = mixTimeline->_frames;
+				size_t frameCount = frames.size() / PathConstraintMixTimeline::ENTRIES;
+				writeByte(output, PATH_MIX);
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += PathConstraintMixTimeline::ENTRIES) {
+					writeFloat(output, frames[f]);
+					writeFloat(output, frames[f + 1]);
+					writeFloat(output, frames[f + 2]);
+					if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, mixTimeline);
+				}
+			} else {
+				PathConstraintPositionTimeline *positionTimeline = static_cast<PathConstraintPositionTimeline *>(timeline);
+				Vector<float> &frames = positionTimeline->_frames;
+				size_t frameCount = frames.size() / PathConstraintPositionTimeline::ENTRIES;
+				float timelineScale = 1;
+				if (rtti.isExactly(PathConstraintSpacingTimeline::rtti)) {
+					writeByte(output, PATH_SPACING);
+					if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed) timelineScale = scale;
+				} else {
+					writeByte(output, PATH_POSITION);
+					if (data->_positionMode == PositionMode_Fixed) timelineScale = scale;
+				}
+				writeVarint(output, (int) frameCount, true);
+				for (size_t frameIndex = 0, f = 0; frameIndex < frameCount; ++frameIndex, f += PathConstraintPositionTimeline::ENTRIES) {
+					writeFloat(output, frames[f]);
+					writeFloat(output, frames[f + 1] / timelineScale);
+					if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, positionTimeline);
+				}
+			}
+		}
+	}
+
+	// Deform timelines, grouped by skin and slot.
+	Vector<int> deformSkins;
+	Vector<String> deformNames;
+	deformSkins.setSize(deformTimelines.size(), -1);
+	deformNames.setSize(deformTimelines.size(), String());
+	Vector<String> names;
+	for (size_t i = 0; i < deformTimelines.size(); ++i) {
+		DeformTimeline *timeline = deformTimelines[i];
+		for (size_t ii = 0; ii < skins.size() && deformSkins[i] < 0; ++ii) {
+			names.clear();
+			skins[ii]->findNamesForSlot(timeline->_slotIndex, names);
+			for (size_t iii = 0; iii < names.size(); ++iii) {
+				if (skins[ii]->getAttachment(timeline->_slotIndex, names[iii]) == timeline->_attachment) {
+					deformSkins[i] = (int) ii;
+					deformNames[i] = names[iii];
+					break;
+				}
+			}
+		}
+		if (deformSkins[i] < 0) {
+			setError("Deformed attachment not found in a skin: ", timeline->_attachment->getName().buffer());
+			return false;
+		}
+	}
+	count = 0;
+	for (size_t i = 0; i < skins.size(); ++i)
+		if (deformSkins.contains((int) i)) count++;
+	writeVarint(output, count, true);
+	for (size_t skinIndex = 0; skinIndex < skins.size(); ++skinIndex) {
+		if (!deformSkins.contains((int) skinIndex)) continue;
+		writeVarint(output, (int) skinIndex, true);
+		count = 0;
+		for (size_t slotIndex = 0; slotIndex < skeletonData->_slots.size(); ++slotIndex) {
+			for (size_t i = 0; i < deformTimelines.size(); ++i) {
+				if (deformSkins[i] == (int) skinIndex && deformTimelines[i]->_slotIndex == (int) slotIndex) {
+					count++;
+					break;
+				}
+			}
+		}
+		writeVarint(output, count, true);
+		for (size_t slotIndex = 0; slotIndex < skeletonData->_slots.size(); ++slotIndex) {
+			count = 0;
+			for (size_t i = 0; i < deformTimelines.size(); ++i)
+				if (deformSkins[i] == (int) skinIndex && deformTimelines[i]->_slotIndex == (int) slotIndex) count++;
+			if (count == 0) continue;
+			writeVarint(output, (int) slotIndex, true);
+			writeVarint(output, count, true);
+			for (size_t i = 0; i < deformTimelines.size(); ++i) {
+				if (deformSkins[i] == (int) skinIndex && deformTimelines[i]->_slotIndex == (int) slotIndex)
+					writeDeformTimeline(output, deformTimelines[i], deformNames[i]);
+			}
+		}
+	}
+
+	// Draw order timeline.
+	if (drawOrderTimeline) {
+		Vector<float> &frames = drawOrderTimeline->_frames;
+		size_t slotCount = skeletonData->_slots.size();
+		Vector<int> positions;
+		positions.setSize(slotCount, 0);
+		writeVarint(output, (int) frames.size(), true);
+		for (size_t frameIndex = 0; frameIndex < frames.size(); ++frameIndex) {
+			writeFloat(output, frames[frameIndex]);
+			Vector<int> &drawOrder = drawOrderTimeline->_drawOrders[frameIndex];
+			// Each slot which moved is stored with its offset, the others keep their order.
+			for (size_t i = 0; i < slotCount; ++i)
+				positions[i] = (int) i;
+			for (size_t i = 0; i < drawOrder.size(); ++i)
+				positions[drawOrder[i]] = (int) i;
+			count = 0;
+			for (size_t i = 0; i < slotCount; ++i)
+				if (positions[i] != (int) i) count++;
+			writeVarint(output, count, true);
+			for (size_t i = 0; i < slotCount; ++i) {
+				if (positions[i] == (int) i) continue;
+				writeVarint(output, (int) i, true);
+				writeVarint(output, positions[i] - (int) i, true);
+			}
+		}
+	} else
+		writeVarint(output, 0, true);
+
+	// Event timeline.
+	if (eventTimeline) {
+		Vector<Event *> &events = eventTimeline->_events;
+		writeVarint(output, (int) events.size(), true);
+		for (size_t i = 0; i < events.size(); ++i) {
+			Event *event = events[i];
+			const EventData &eventData = event->getData();
+			writeFloat(output, eventTimeline->_frames[i]);
+			writeVarint(output, skeletonData->_events.indexOf(const_cast<EventData *>(&eventData)), true);
+			writeVarint(output, event->_intValue, false);
+			writeFloat(output, event->_floatValue);
+			bool ownString = event->_stringValue != eventData._stringValue;
+			writeBoolean(output, ownString);
+			if (ownString) writeString(output, event->_stringValue);
+			if (!eventData._audioPath.isEmpty()) {
+				writeFloat(output, event->_volume);
+				writeFloat(output, event->_balance);
+			}
+		}
+	} else
+		writeVarint(output, 0, true);
+	return true;
+}
+
+void SkeletonBinary::writeDeformTimeline(DataOutput *output, DeformTimeline *timeline, const String &attachmentName) {
+	float scale = _scale;
+	VertexAttachment *attachment = timeline->_attachment;
+	bool weighted = attachment->_bones.size() > 0;
+	Vector<float> &vertices = attachment->_vertices;
+	size_t deformLength = weighted ? vertices.size() / 3 * 2 : vertices.size();
+	size_t frameCount = timeline->_frames.size();
+	Vector<float> deform;
+	deform.setSize(deformLength, 0);
+
+	writeStringRef(output, attachmentName);
+	writeVarint(output, (int) frameCount, true);
+	for (size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+		writeFloat(output, timeline->_frames[frameIndex]);
+
+		// The frames store the offsets from the setup vertices, for unweighted attachments.
+		if (timeline->isQuantized()) {
+			const unsigned short *values = timeline->_quantizedVertices.buffer() + frameIndex * deformLength;
+			for (size_t v = 0; v < deformLength; ++v)
+				deform[v] = timeline->_quantizedOffset + values[v] * timeline->_quantizedScale;
+		} else
+			deform.clearAndAddAll(timeline->_frameVertices[frameIndex]);
+		if (!weighted) {
+			for (size_t v = 0; v < deformLength; ++v)
+				deform[v] -= vertices[v];
+		}
+		size_t start = 0, end = deformLength;
+		while (start < end && deform[start] == 0) start++;
+		while (end > start && deform[end - 1] == 0) end--;
+		writeVarint(output, (int) (end - start), true);
+		if (end > start) {
+			writeVarint(output, (int) start, true);
+			for (size_t v = start; v < end; ++v)
+				writeFloat(output, deform[v] / scale);
+		}
+
+		if (frameIndex < frameCount - 1) writeCurve(output, frameIndex, timeline);
+	}
+}
+
+void SkeletonBinary::writeCurve(DataOutput *output, size_t frameIndex, CurveTimeline *timeline) {
+	float type = timeline->getCurveType(frameIndex);
+	if (type == CurveTimeline::STEPPED) {
+		writeByte(output, CURVE_STEPPED);
+	} else if (type == CurveTimeline::BEZIER) {
+		float cx1, cy1, cx2, cy2;
+		timeline->getCurve(frameIndex, cx1, cy1, cx2, cy2);
+		writeByte(output, CURVE_BEZIER);
+		writeFloat(output, cx1);
+		writeFloat(output, cy1);
+		writeFloat(output, cx2);
+		writeFloat(output, cy2);
+	} else
+		writeByte(output, CURVE_LINEAR);
+}
@@ -38,6 +38,7 @@
 #include <spine/Skin.h>
 #include <spine/EventData.h>
 #include <spine/Animation.h>
+#include <spine/AttachmentTimeline.h>
 #include <spine/IkConstraintData.h>
 #include <spine/TransformConstraintData.h>
 #include <spine/PathConstraintData.h>
@@ -47,6 +48,7 @@
 using namespace spine;
 
 SkeletonData::SkeletonData() :
+		_arena(),
 		_name(),
 		_defaultSkin(NULL),
 		_x(0),
@@ -57,9 +59,14 @@ SkeletonData::SkeletonData() :
 		_hash(),
 		_fps(0),
 		_imagesPath() {
+	for (int i = 0; i < NAMED_VECTORS; i++)
+		_namedCounts[i] = 0;
 }
 
 SkeletonData::~SkeletonData() {
+	// Frees the memory of the members into the arena, including the members destroyed after this body.
+	if (_arena.getBlockCount()) _arena.enterUntilDestroyed();
+
 	ContainerUtil::cleanUpVectorOfPointers(_bones);
 	ContainerUtil::cleanUpVectorOfPointers(_slots);
 	ContainerUtil::cleanUpVectorOfPointers(_skins);
@@ -76,48 +83,112 @@ SkeletonData::~SkeletonData() {
 	}
 }
 
+NameHandle SkeletonData::findName(const String &name) {
+	return _nameIds.containsKey(name) ? NameHandle(_nameIds[name]) : NameHandle();
+}
+
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	int index = findIndex(_bones, boneName, &NamedItems::bone);
+	return index == -1 ? NULL : _bones[index];
 }
 
 int SkeletonData::findBoneIndex(const String &boneName) {
-	return ContainerUtil::findIndexWithName(_bones, boneName);
+	return findIndex(_bones, boneName, &NamedItems::bone);
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	int index = findIndex(_slots, slotName, &NamedItems::slot);
+	return index == -1 ? NULL : _slots[index];
 }
 
 int SkeletonData::findSlotIndex(const String &slotName) {
-	return ContainerUtil::findIndexWithName(_slots, slotName);
+	return findIndex(_slots, slotName, &NamedItems::slot);
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	int index = findIndex(_skins, skinName, &NamedItems::skin);
+	return index == -1 ? NULL : _skins[index];
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	int index = findIndex(_events, eventDataName, &NamedItems::event);
+	return index == -1 ? NULL : _events[index];
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	int index = findIndex(_animations, animationName, &NamedItems::animation);
+	return index == -1 ? NULL : _animations[index];
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	int index = findIndex(_ikConstraints, constraintName, &NamedItems::ikConstraint);
+	return index == -1 ? NULL : _ikConstraints[index];
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	int index = findIndex(_transformConstraints, constraintName, &NamedItems::transformConstraint);
+	return index == -1 ? NULL : _transformConstraints[index];
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	int index = findIndex(_pathConstraints, constraintName, &NamedItems::pathConstraint);
+	return index == -1 ? NULL : _pathConstraints[index];
 }
 
 int SkeletonData::findPathConstraintIndex(const String &pathConstraintName) {
-	return ContainerUtil::findIndexWithName(_pathConstraints, pathConstraintName);
+	return findIndex(_pathConstraints, pathConstraintName, &NamedItems::pathConstraint);
+}
+
+BoneData *SkeletonData::findBone(const NameHandle &boneName) {
+	int index = findIndex(_bones, boneName, &NamedItems::bone);
+	return index == -1 ? NULL : _bones[index];
+}
+
+int SkeletonData::findBoneIndex(const NameHandle &boneName) {
+	return findIndex(_bones, boneName, &NamedItems::bone);
+}
+
+SlotData *SkeletonData::findSlot(const NameHandle &slotName) {
+	int index = findIndex(_slots, slotName, &NamedItems::slot);
+	return index == -1 ? NULL : _slots[index];
+}
+
+int SkeletonData::findSlotIndex(const NameHandle &slotName) {
+	return findIndex(_slots, slotName, &NamedItems::slot);
+}
+
+Skin *SkeletonData::findSkin(const NameHandle &skinName) {
+	int index = findIndex(_skins, skinName, &NamedItems::skin);
+	return index == -1 ? NULL : _skins[index];
+}
+
+spine::EventData *SkeletonData::findEvent(const NameHandle &eventDataName) {
+	int index = findIndex(_events, eventDataName, &NamedItems::event);
+	return index == -1 ? NULL : _events[index];
+}
+
+Animation *SkeletonData::findAnimation(const NameHandle &animationName) {
+	int index = findIndex(_animations, animationName, &NamedItems::animation);
+	return index == -1 ? NULL : _animations[index];
+}
+
+IkConstraintData *SkeletonData::findIkConstraint(const NameHandle &constraintName) {
+	int index = findIndex(_ikConstraints, constraintName, &NamedItems::ikConstraint);
+	return index == -1 ? NULL : _ikConstraints[index];
+}
+
+TransformConstraintData *SkeletonData::findTransformConstraint(const NameHandle &constraintName) {
+	int index = findIndex(_transformConstraints, constraintName, &NamedItems::transformConstraint);
+	return index == -1 ? NULL : _transformConstraints[index];
+}
+
+PathConstraintData *SkeletonData::findPathConstraint(const NameHandle &constraintName) {
+	int index = findIndex(_pathConstraints, constraintName, &NamedItems::pathConstraint);
+	return index == -1 ? NULL : _pathConstraints[index];
+}
+
+int SkeletonData::findPathConstraintIndex(const NameHandle &pathConstraintName) {
+	return findIndex(_pathConstraints, pathConstraintName, &NamedItems::pathConstraint);
 }
 
 const String &SkeletonData::getName() {
@@ -240,3 +311,108 @@ float SkeletonData::getFps() {
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
+
+ArenaAllocator &SkeletonData::getArena() {
+	return _arena;
+}
+
+bool SkeletonData::namesIndexed() {
+	return _namedCounts[0] == _bones.size() && _namedCounts[1] == _slots.size() && _namedCounts[2] == _skins.size() &&
+		   _namedCounts[3] == _events.size() && _namedCounts[4] == _animations.size() &&
+		   _namedCounts[5] == _ikConstraints.size() && _namedCounts[6] == _transformConstraints.size() &&
+		   _namedCounts[7] == _pathConstraints.size();
+}
+
+void SkeletonData::indexNames() {
+	ArenaScope arenaScope(_arena.getBlockCount() ? &_arena : ArenaAllocator::getCurrent());
+
+	// Names stay interned so handles remain valid.
+	for (size_t i = 0; i < _namedItems.size(); i++)
+		_namedItems[i] = NamedItems();
+
+	indexNames(_bones, _namedCounts[0], &NamedItems::bone);
+	indexNames(_slots, _namedCounts[1], &NamedItems::slot);
+	indexNames(_skins, _namedCounts[2], &NamedItems::skin);
+	indexNames(_events, _namedCounts[3], &NamedItems::event);
+	indexNames(_animations, _namedCounts[4], &NamedItems::animation);
+	indexNames(_ikConstraints, _namedCounts[5], &NamedItems::ikConstraint);
+	indexNames(_transformConstraints, _namedCounts[6], &NamedItems::transformConstraint);
+	indexNames(_pathConstraints, _namedCounts[7], &NamedItems::pathConstraint);
+}
+
+template<typename T>
+void SkeletonData::indexNames(Vector<T *> &items, size_t &count, int NamedItems::*index) {
+	for (count = 0; count < items.size(); count++) {
+		const String &name = items[count]->getName();
+		int id;
+		if (_nameIds.containsKey(name))
+			id = _nameIds[name];
+		else {
+			id = (int) _names.size();
+			_nameIds.put(name, id);
+			_names.add(name);
+			_namedItems.add(NamedItems());
+		}
+		// Like a linear search, the first item with a name wins.
+		if (_namedItems[id].*index == -1) _namedItems[id].*index = (int) count;
+	}
+}
+
+template<typename T>
+int SkeletonData::findIndex(Vector<T *> &items, const String &name, int NamedItems::*index) {
+	assert(name.length() > 0);
+
+	if (namesIndexed()) return _nameIds.containsKey(name) ? _namedItems[_nameIds[name]].*index : -1;
+
+	// The loaders size the vectors up front and find items while filling them, so stop at the first missing item.
+	for (size_t i = 0, n = items.size(); i < n && items[i]; i++)
+		if (items[i]->getName() == name) return (int) i;
+	return -1;
+}
+
+template<typename T>
+int SkeletonData::findIndex(Vector<T *> &items, const NameHandle &name, int NamedItems::*index) {
+	if (!name.isValid()) return -1;
+
+	if (namesIndexed()) return _namedItems[name._id].*index;
+	return findIndex(items, _names[name._id], index);
+}
+
+void SkeletonData::indexAttachments() {
+	ArenaScope arenaScope(_arena.getBlockCount() ? &_arena : ArenaAllocator::getCurrent());
+	_attachmentKeySlots.clear();
+	_attachmentKeyNames.clear();
+	Vector< Vector<int> > slotKeys; // The keys of each slot.
+	slotKeys.setSize(_slots.size(), Vector<int>());
+
+	for (size_t i = 0, n = _slots.size(); i < n; i++)
+		_slots[i]->_attachmentKey = addAttachmentKey(slotKeys, i, _slots[i]->_attachmentName);
+
+	for (size_t i = 0, n = _animations.size(); i < n; i++) {
+		Vector<Timeline *> &timelines = _animations[i]->getTimelines();
+		for (size_t ii = 0, nn = timelines.size(); ii < nn; ii++) {
+			if (!timelines[ii]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+			AttachmentTimeline *timeline = static_cast<AttachmentTimeline *>(timelines[ii]);
+			Vector<String> &names = timeline->_attachmentNames;
+			timeline->_attachmentKeys.setSize(names.size(), -1);
+			for (size_t frame = 0, frameCount = names.size(); frame < frameCount; frame++)
+				timeline->_attachmentKeys[frame] = addAttachmentKey(slotKeys, timeline->_slotIndex, names[frame]);
+		}
+	}
+}
+
+size_t SkeletonData::getAttachmentKeyCount() {
+	return _attachmentKeySlots.size();
+}
+
+int SkeletonData::addAttachmentKey(Vector< Vector<int> > &slotKeys, size_t slotIndex, const String &attachmentName) {
+	if (attachmentName.isEmpty() || slotIndex >= slotKeys.size()) return -1;
+	Vector<int> &keys = slotKeys[slotIndex];
+	for (size_t i = 0, n = keys.size(); i < n; i++)
+		if (_attachmentKeyNames[keys[i]] == attachmentName) return keys[i];
+	int key = (int) _attachmentKeySlots.size();
+	_attachmentKeySlots.add((int) slotIndex);
+	_attachmentKeyNames.add(attachmentName);
+	keys.add(key);
+	return key;
+}
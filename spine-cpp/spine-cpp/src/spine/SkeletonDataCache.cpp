@@ -0,0 +1,354 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonDataCache.h>
+
+#include <spine/SkeletonData.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonJson.h>
+
+#include <assert.h>
+#include <string.h>
+
+#ifndef SPINE_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace spine {
+#ifndef SPINE_NO_THREADS
+/// The lock of the cache and the threads loading prefetched files.
+class SkeletonDataCacheSync : public SpineObject {
+public:
+	struct Prefetch : public SpineObject {
+		std::thread thread;
+		bool finished;
+	};
+
+	std::mutex mutex;
+	std::condition_variable loaded;
+	Vector<Prefetch *> prefetches;
+
+	static void run(SkeletonDataCache *cache, SkeletonDataCache::Entry *entry, Prefetch *prefetch) {
+		String error;
+		SkeletonData *skeletonData = cache->load(entry, error);
+		std::lock_guard<std::mutex> lock(cache->_sync->mutex);
+		cache->finishLoad(entry, skeletonData, error);
+		prefetch->finished = true;
+	}
+
+	/// Joins the threads which finished loading, or all threads if all is true. Must be called without the lock held.
+	void join(bool all) {
+		Vector<Prefetch *> finished;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (size_t i = 0; i < prefetches.size();) {
+				if (all || prefetches[i]->finished) {
+					finished.add(prefetches[i]);
+					prefetches.removeAt(i);
+				} else
+					i++;
+			}
+		}
+		for (size_t i = 0; i < finished.size(); i++) {
+			finished[i]->thread.join();
+			delete finished[i];
+		}
+	}
+};
+
+/// Holds the lock of the cache.
+class SkeletonDataCacheLock {
+public:
+	explicit SkeletonDataCacheLock(SkeletonDataCacheSync *sync) : _sync(sync), _lock(sync->mutex) {
+	}
+
+	void lock() {
+		_lock.lock();
+	}
+
+	void unlock() {
+		_lock.unlock();
+	}
+
+	void wait() {
+		_sync->loaded.wait(_lock);
+	}
+
+private:
+	SkeletonDataCacheSync *_sync;
+	std::unique_lock<std::mutex> _lock;
+};
+#else
+class SkeletonDataCacheSync : public SpineObject {
+};
+
+class SkeletonDataCacheLock {
+public:
+	explicit SkeletonDataCacheLock(SkeletonDataCacheSync *sync) {
+		SP_UNUSED(sync);
+	}
+
+	void lock() {
+	}
+
+	void unlock() {
+	}
+
+	void wait() {
+	}
+};
+#endif
+}
+
+using namespace spine;
+
+SkeletonDataCache::SkeletonDataCache(size_t memoryBudget) : _sync(new(__FILE__, __LINE__) SkeletonDataCacheSync()),
+	_memoryBudget(memoryBudget), _memoryUsage(0), _loadCount(0), _useCounter(0) {
+}
+
+SkeletonDataCache::~SkeletonDataCache() {
+	{
+		// Failed prefetches remove their entries, so the search starts over after each wait.
+		SkeletonDataCacheLock lock(_sync);
+		for (size_t i = 0; i < _entries.size();) {
+			if (_entries[i]->loading) {
+				lock.wait();
+				i = 0;
+			} else
+				i++;
+		}
+	}
+#ifndef SPINE_NO_THREADS
+	_sync->join(true);
+#endif
+	while (_entries.size() > 0)
+		removeEntry(_entries.size() - 1);
+	delete _sync;
+}
+
+SkeletonData *SkeletonDataCache::acquire(const String &path, Atlas *atlas, float scale, AttachmentLoader *attachmentLoader) {
+	SkeletonDataCacheLock lock(_sync);
+	Entry *entry = findEntry(path, atlas, scale);
+	if (!entry) {
+		entry = addEntry(path, atlas, scale, attachmentLoader, false);
+		lock.unlock();
+		String error;
+		SkeletonData *skeletonData = load(entry, error);
+		lock.lock();
+		finishLoad(entry, skeletonData, error);
+	} else {
+		// Referenced while waiting, so a failed load is not removed before it is seen.
+		entry->references++;
+		while (entry->loading)
+			lock.wait();
+	}
+	entry->lastUse = ++_useCounter;
+
+	if (!entry->skeletonData) {
+		_error = entry->error;
+		if (--entry->references == 0) removeEntry(_entries.indexOf(entry));
+		return NULL;
+	}
+	return entry->skeletonData;
+}
+
+void SkeletonDataCache::prefetch(const String &path, Atlas *atlas, float scale, AttachmentLoader *attachmentLoader) {
+#ifndef SPINE_NO_THREADS
+	_sync->join(false);
+	std::lock_guard<std::mutex> lock(_sync->mutex);
+	if (findEntry(path, atlas, scale)) return;
+	Entry *entry = addEntry(path, atlas, scale, attachmentLoader, true);
+	SkeletonDataCacheSync::Prefetch *prefetch = new(__FILE__, __LINE__) SkeletonDataCacheSync::Prefetch();
+	prefetch->finished = false;
+	prefetch->thread = std::thread(&SkeletonDataCacheSync::run, this, entry, prefetch);
+	_sync->prefetches.add(prefetch);
+#else
+	if (findEntry(path, atlas, scale)) return;
+	Entry *entry = addEntry(path, atlas, scale, attachmentLoader, true);
+	String error;
+	SkeletonData *skeletonData = load(entry, error);
+	finishLoad(entry, skeletonData, error);
+#endif
+}
+
+void SkeletonDataCache::release(SkeletonData *skeletonData) {
+	SkeletonDataCacheLock lock(_sync);
+	for (size_t i = 0; i < _entries.size(); i++) {
+		Entry *entry = _entries[i];
+		if (entry->skeletonData == skeletonData && entry->references > 0) {
+			entry->references--;
+			entry->lastUse = ++_useCounter;
+			if (_memoryBudget > 0 && _memoryUsage > _memoryBudget) evictLocked(_memoryBudget);
+			return;
+		}
+	}
+	assert(false && "Skeleton data was not acquired from this cache.");
+}
+
+size_t SkeletonDataCache::evict(size_t targetMemory) {
+	SkeletonDataCacheLock lock(_sync);
+	return evictLocked(targetMemory);
+}
+
+void SkeletonDataCache::setMemoryBudget(size_t memoryBudget) {
+	SkeletonDataCacheLock lock(_sync);
+	_memoryBudget = memoryBudget;
+	if (_memoryBudget > 0 && _memoryUsage > _memoryBudget) evictLocked(_memoryBudget);
+}
+
+size_t SkeletonDataCache::getMemoryBudget() {
+	SkeletonDataCacheLock lock(_sync);
+	return _memoryBudget;
+}
+
+size_t SkeletonDataCache::getMemoryUsage() {
+	SkeletonDataCacheLock lock(_sync);
+	return _memoryUsage;
+}
+
+size_t SkeletonDataCache::size() {
+	SkeletonDataCacheLock lock(_sync);
+	return _entries.size();
+}
+
+int SkeletonDataCache::getReferenceCount(SkeletonData *skeletonData) {
+	SkeletonDataCacheLock lock(_sync);
+	for (size_t i = 0; i < _entries.size(); i++)
+		if (_entries[i]->skeletonData == skeletonData) return _entries[i]->references;
+	return 0;
+}
+
+size_t SkeletonDataCache::getLoadCount() {
+	SkeletonDataCacheLock lock(_sync);
+	return _loadCount;
+}
+
+String SkeletonDataCache::getError() {
+	SkeletonDataCacheLock lock(_sync);
+	return _error;
+}
+
+SkeletonDataCache::Entry *SkeletonDataCache::findEntry(const String &path, Atlas *atlas, float scale) {
+	for (size_t i = 0; i < _entries.size(); i++) {
+		Entry *entry = _entries[i];
+		if (entry->atlas == atlas && entry->scale == scale && entry->path == path) return entry;
+	}
+	return NULL;
+}
+
+SkeletonDataCache::Entry *SkeletonDataCache::addEntry(const String &path, Atlas *atlas, float scale,
+	AttachmentLoader *attachmentLoader, bool prefetching
+) {
+	Entry *entry = new(__FILE__, __LINE__) Entry();
+	entry->path = path;
+	entry->atlas = atlas;
+	entry->scale = scale;
+	entry->attachmentLoader = attachmentLoader;
+	entry->skeletonData = NULL;
+	entry->memory = 0;
+	entry->lastUse = ++_useCounter;
+	entry->references = prefetching ? 0 : 1;
+	entry->loading = true;
+	_entries.add(entry);
+	return entry;
+}
+
+SkeletonData *SkeletonDataCache::load(Entry *entry, String &error) {
+	// The skeleton data is read into its own arena, which gives its memory and frees it at once when evicted.
+	const String &path = entry->path;
+	SkeletonData *skeletonData;
+	if (path.length() >= 5 && strcmp(path.buffer() + path.length() - 5, ".json") == 0) {
+		SkeletonJson *json = entry->attachmentLoader ? new(__FILE__, __LINE__) SkeletonJson(entry->attachmentLoader) :
+							 new(__FILE__, __LINE__) SkeletonJson(entry->atlas);
+		json->setScale(entry->scale);
+		json->setUseArena(true);
+		skeletonData = json->readSkeletonDataFile(path);
+		if (!skeletonData) error = json->getError();
+		delete json;
+	} else {
+		SkeletonBinary *binary = entry->attachmentLoader ? new(__FILE__, __LINE__) SkeletonBinary(entry->attachmentLoader) :
+								 new(__FILE__, __LINE__) SkeletonBinary(entry->atlas);
+		binary->setScale(entry->scale);
+		binary->setUseArena(true);
+		skeletonData = binary->readSkeletonDataFile(path);
+		if (!skeletonData) error = binary->getError();
+		delete binary;
+	}
+	return skeletonData;
+}
+
+void SkeletonDataCache::finishLoad(Entry *entry, SkeletonData *skeletonData, const String &error) {
+	entry->loading = false;
+	entry->attachmentLoader = NULL; // Only valid during the load.
+	entry->skeletonData = skeletonData;
+	if (skeletonData) {
+		entry->memory = skeletonData->getArena().getCapacity();
+		_memoryUsage += entry->memory;
+		_loadCount++;
+		if (_memoryBudget > 0 && _memoryUsage > _memoryBudget) evictLocked(_memoryBudget);
+	} else {
+		entry->error = error;
+		_error = error;
+	}
+#ifndef SPINE_NO_THREADS
+	_sync->loaded.notify_all();
+#endif
+	// A failed prefetch nobody waits for is not kept, so the next acquire loads the file again.
+	if (!skeletonData && entry->references == 0) removeEntry(_entries.indexOf(entry));
+}
+
+size_t SkeletonDataCache::evictLocked(size_t targetMemory) {
+	size_t freed = 0;
+	while (_memoryUsage > targetMemory) {
+		int oldest = -1;
+		for (size_t i = 0; i < _entries.size(); i++) {
+			Entry *entry = _entries[i];
+			if (entry->references > 0 || entry->loading || !entry->skeletonData) continue;
+			if (oldest == -1 || entry->lastUse < _entries[oldest]->lastUse) oldest = (int) i;
+		}
+		if (oldest == -1) break;
+		freed += _entries[oldest]->memory;
+		removeEntry(oldest);
+	}
+	return freed;
+}
+
+void SkeletonDataCache::removeEntry(size_t index) {
+	Entry *entry = _entries[index];
+	_memoryUsage -= entry->memory;
+	delete entry->skeletonData;
+	delete entry;
+	_entries.removeAt(index);
+}
@@ -37,6 +37,7 @@
 #include <spine/VertexAttachment.h>
 #include <spine/Json.h>
 #include <spine/SkeletonData.h>
+#include <spine/ArenaAllocator.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/LinkedMesh.h>
@@ -81,11 +82,11 @@
 using namespace spine;
 
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new(__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-	_scale(1), _ownsLoader(true)
+	_scale(1), _curveLookupSize(0), _useArena(false), _useInfluenceBuckets(false), _quantizeDeform(false), _ownsLoader(true)
 {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader) : _attachmentLoader(attachmentLoader), _scale(1),
-	_ownsLoader(false)
+	_curveLookupSize(0), _useArena(false), _useInfluenceBuckets(false), _quantizeDeform(false), _ownsLoader(false)
 {
 	assert(_attachmentLoader != NULL);
 }
@@ -128,6 +129,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 	}
 
 	skeletonData = new(__FILE__, __LINE__) SkeletonData();
+	ArenaScope arenaScope(_useArena ? &skeletonData->_arena : ArenaAllocator::getCurrent());
 
 	skeleton = Json::getItem(root, "skeleton");
 	if (skeleton) {
@@ -587,10 +589,10 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 								_attachmentLoader->configureAttachment(mesh);
 							} else {
 								bool inheritDeform = Json::getInt(attachmentMap, "deform", 1) ? true : false;
-								LinkedMesh *linkedMesh = new(__FILE__, __LINE__) LinkedMesh(mesh,
+								ArenaScope heapScope(NULL); // The linked meshes outlive the skeleton data when loading fails.
+								_linkedMeshes.add(new(__FILE__, __LINE__) LinkedMesh(mesh,
 									String(Json::getString(attachmentMap, "skin", 0)), slot->getIndex(), String(entry->_valueString),
-									inheritDeform);
-								_linkedMeshes.add(linkedMesh);
+									inheritDeform));
 							}
 							break;
 						}
@@ -662,14 +664,16 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		LinkedMesh *linkedMesh = _linkedMeshes[i];
 		Skin *skin = linkedMesh->_skin.length() == 0 ? skeletonData->getDefaultSkin() : skeletonData->findSkin(linkedMesh->_skin);
 		if (skin == NULL) {
-			delete skeletonData;
 			setError(root, "Skin not found: ", linkedMesh->_skin.buffer());
+			ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+			delete skeletonData;
 			return NULL;
 		}
 		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
 		if (parent == NULL) {
-			delete skeletonData;
 			setError(root, "Parent mesh not found: ", linkedMesh->_parent.buffer());
+			ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+			delete skeletonData;
 			return NULL;
 		}
 		linkedMesh->_mesh->_deformAttachment = linkedMesh->_inheritDeform ? static_cast<VertexAttachment*>(parent) : linkedMesh->_mesh;
@@ -723,6 +727,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 	delete root;
 
+	skeletonData->indexNames();
+	skeletonData->indexAttachments();
 	return skeletonData;
 }
 
@@ -754,6 +760,7 @@ void SkeletonJson::readCurve(Json *frame, CurveTimeline *timeline, size_t frameI
 		float c2 = Json::getFloat(frame, "c2", 0);
 		float c3 = Json::getFloat(frame, "c3", 1);
 		float c4 = Json::getFloat(frame, "c4", 1);
+		timeline->setCurveLookupSize(_curveLookupSize);
 		timeline->setCurve(frameIndex, c1, c2, c3, c4);
 	}
 }
@@ -1092,6 +1099,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), deformed);
 					readCurve(valueMap, timeline, frameIndex);
 				}
+				if (_quantizeDeform) timeline->quantizeVertices();
 
 				timelines.add(timeline);
 				timelinesCount++;
@@ -1220,9 +1228,11 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 
 	attachment->getVertices().clearAndAddAll(bonesAndWeights._vertices);
 	attachment->getBones().clearAndAddAll(bonesAndWeights._bones);
+	if (_useInfluenceBuckets) attachment->buildInfluenceBuckets();
 }
 
 void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
+	ArenaScope heapScope(NULL);
 	_error = String(value1).append(value2);
 	delete root;
 }
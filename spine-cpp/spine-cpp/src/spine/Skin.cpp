@@ -42,8 +42,18 @@
 
 #include <assert.h>
 
+#ifndef SPINE_NO_THREADS
+#include <atomic>
+#endif
+
 using namespace spine;
 
+#ifndef SPINE_NO_THREADS
+static std::atomic<unsigned int> skinVersions(0);
+#else
+static unsigned int skinVersions = 0;
+#endif
+
 Skin::AttachmentMap::AttachmentMap() {
 }
 
@@ -92,7 +102,7 @@ Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
 	return Skin::AttachmentMap::Entries(_buckets);
 }
 
-Skin::Skin(const String &name) : _name(name), _attachments() {
+Skin::Skin(const String &name) : _name(name), _attachments(), _version(++skinVersions) {
 	assert(_name.length() > 0);
 }
 
@@ -107,6 +117,7 @@ Skin::~Skin() {
 void Skin::setAttachment(size_t slotIndex, const String &name, Attachment *attachment) {
 	assert(attachment);
 	_attachments.put(slotIndex, name, attachment);
+	_version = ++skinVersions;
 }
 
 Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
@@ -115,6 +126,7 @@ Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
 
 void Skin::removeAttachment(size_t slotIndex, const String& name) {
 	_attachments.remove(slotIndex, name);
+	_version = ++skinVersions;
 }
 
 void Skin::findNamesForSlot(size_t slotIndex, Vector<String> &names) {
@@ -196,3 +208,7 @@ Vector<ConstraintData*>& Skin::getConstraints() {
 Vector<BoneData*>& Skin::getBones() {
 	return _bones;
 }
+
+unsigned int Skin::getVersion() {
+	return _version;
+}
@@ -45,4 +45,12 @@ Timeline::Timeline() {
 Timeline::~Timeline() {
 }
 
+void Timeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+	MixDirection direction, int &frameCursor
+) {
+	SP_UNUSED(frameCursor);
+
+	apply(skeleton, lastTime, time, pEvents, alpha, blend, direction);
+}
+
 }
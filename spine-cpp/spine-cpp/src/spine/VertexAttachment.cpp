@@ -37,15 +37,298 @@
 
 #include <spine/Bone.h>
 #include <spine/Skeleton.h>
+#include <spine/InfluenceBuckets.h>
+
+#ifndef SPINE_NO_THREADS
+#include <atomic>
+#endif
+
+#if !defined(SPINE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPINE_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SPINE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
 
 using namespace spine;
 
+/* Skinning with the bone matrices gathered by Skeleton::updateWorldTransform(). The x and y of a vertex are computed together in
+ * the lanes of one register for each bone influence. */
+#if defined(SPINE_SIMD_SSE2)
+typedef __m128 SkinSum;
+
+static inline SkinSum skinZero() {
+	return _mm_setzero_ps();
+}
+
+/* vertex is the x, y and weight of the influence, deform its x and y offset or NULL. */
+template<bool hasDeform>
+static inline SkinSum skinAdd(SkinSum sum, const float *matrix, const float *vertex, const float *deform) {
+	__m128 xy = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) vertex);
+	if (hasDeform) xy = _mm_add_ps(xy, _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) deform));
+	/* [a * x, c * x, b * y, d * y], then the halves are added. */
+	__m128 p = _mm_mul_ps(_mm_loadu_ps(matrix), _mm_unpacklo_ps(xy, xy));
+	p = _mm_add_ps(_mm_add_ps(p, _mm_movehl_ps(p, p)), _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) (matrix + 4)));
+	return _mm_add_ps(sum, _mm_mul_ps(p, _mm_set1_ps(vertex[2])));
+}
+
+static inline void skinStore(SkinSum sum, float *worldVertex) {
+	_mm_storel_pi((__m64 *) worldVertex, sum);
+}
+
+/* Each group of 4 vertices of the influence buckets is skinned at once, one vertex per lane. */
+#define SPINE_SKIN_LANES
+typedef __m128 SkinLanes;
+
+static inline SkinLanes lanesLoad(const float *values) {
+	return _mm_loadu_ps(values);
+}
+
+static inline SkinLanes lanesSet(float v0, float v1, float v2, float v3) {
+	return _mm_setr_ps(v0, v1, v2, v3);
+}
+
+/* Returns sum + (x * a + y * b + t) * weight. */
+static inline SkinLanes lanesSkin(SkinLanes sum, SkinLanes x, SkinLanes y, SkinLanes a, SkinLanes b, SkinLanes t,
+								  SkinLanes weight) {
+	return _mm_add_ps(sum, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, a), _mm_mul_ps(y, b)), t), weight));
+}
+
+static inline SkinLanes lanesAdd(SkinLanes x, SkinLanes y) {
+	return _mm_add_ps(x, y);
+}
+
+/* Transposes the matrices of the bones of the 4 lanes. */
+static inline void lanesMatrices(const float *m0, const float *m1, const float *m2, const float *m3, SkinLanes &a, SkinLanes &b,
+								 SkinLanes &c, SkinLanes &d, SkinLanes &x, SkinLanes &y) {
+	__m128 r0 = _mm_loadu_ps(m0), r1 = _mm_loadu_ps(m1), r2 = _mm_loadu_ps(m2), r3 = _mm_loadu_ps(m3);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	a = r0;
+	c = r1;
+	b = r2;
+	d = r3;
+	__m128 xy01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) (m0 + 4)), (const __m64 *) (m1 + 4));
+	__m128 xy23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) (m2 + 4)), (const __m64 *) (m3 + 4));
+	x = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(2, 0, 2, 0));
+	y = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void lanesStore(SkinLanes x, SkinLanes y, float *w0, float *w1, float *w2, float *w3) {
+	__m128 low = _mm_unpacklo_ps(x, y), high = _mm_unpackhi_ps(x, y);
+	_mm_storel_pi((__m64 *) w0, low);
+	_mm_storeh_pi((__m64 *) w1, low);
+	_mm_storel_pi((__m64 *) w2, high);
+	_mm_storeh_pi((__m64 *) w3, high);
+}
+#elif defined(SPINE_SIMD_NEON)
+typedef float32x2_t SkinSum;
+
+static inline SkinSum skinZero() {
+	return vdup_n_f32(0);
+}
+
+template<bool hasDeform>
+static inline SkinSum skinAdd(SkinSum sum, const float *matrix, const float *vertex, const float *deform) {
+	float vx = vertex[0], vy = vertex[1];
+	if (hasDeform) {
+		vx += deform[0];
+		vy += deform[1];
+	}
+	float32x2_t p = vmla_n_f32(vmla_n_f32(vld1_f32(matrix + 4), vld1_f32(matrix), vx), vld1_f32(matrix + 2), vy);
+	return vmla_n_f32(sum, p, vertex[2]);
+}
+
+static inline void skinStore(SkinSum sum, float *worldVertex) {
+	vst1_f32(worldVertex, sum);
+}
+
+#define SPINE_SKIN_LANES
+typedef float32x4_t SkinLanes;
+
+static inline SkinLanes lanesLoad(const float *values) {
+	return vld1q_f32(values);
+}
+
+static inline SkinLanes lanesSet(float v0, float v1, float v2, float v3) {
+	float32x4_t lanes = vdupq_n_f32(v0);
+	lanes = vsetq_lane_f32(v1, lanes, 1);
+	lanes = vsetq_lane_f32(v2, lanes, 2);
+	return vsetq_lane_f32(v3, lanes, 3);
+}
+
+static inline SkinLanes lanesSkin(SkinLanes sum, SkinLanes x, SkinLanes y, SkinLanes a, SkinLanes b, SkinLanes t,
+								  SkinLanes weight) {
+	return vmlaq_f32(sum, vmlaq_f32(vmlaq_f32(t, x, a), y, b), weight);
+}
+
+static inline SkinLanes lanesAdd(SkinLanes x, SkinLanes y) {
+	return vaddq_f32(x, y);
+}
+
+static inline void lanesMatrices(const float *m0, const float *m1, const float *m2, const float *m3, SkinLanes &a, SkinLanes &b,
+								 SkinLanes &c, SkinLanes &d, SkinLanes &x, SkinLanes &y) {
+	/* [a0, a1, b0, b1] and [c0, c1, d0, d1], then the same for the bones of lanes 2 and 3. */
+	float32x4x2_t r01 = vtrnq_f32(vld1q_f32(m0), vld1q_f32(m1)), r23 = vtrnq_f32(vld1q_f32(m2), vld1q_f32(m3));
+	a = vcombine_f32(vget_low_f32(r01.val[0]), vget_low_f32(r23.val[0]));
+	b = vcombine_f32(vget_high_f32(r01.val[0]), vget_high_f32(r23.val[0]));
+	c = vcombine_f32(vget_low_f32(r01.val[1]), vget_low_f32(r23.val[1]));
+	d = vcombine_f32(vget_high_f32(r01.val[1]), vget_high_f32(r23.val[1]));
+	float32x4x2_t xy = vuzpq_f32(vcombine_f32(vld1_f32(m0 + 4), vld1_f32(m1 + 4)), vcombine_f32(vld1_f32(m2 + 4), vld1_f32(m3 + 4)));
+	x = xy.val[0];
+	y = xy.val[1];
+}
+
+static inline void lanesStore(SkinLanes x, SkinLanes y, float *w0, float *w1, float *w2, float *w3) {
+	float32x4x2_t xy = vzipq_f32(x, y);
+	vst1_f32(w0, vget_low_f32(xy.val[0]));
+	vst1_f32(w1, vget_high_f32(xy.val[0]));
+	vst1_f32(w2, vget_low_f32(xy.val[1]));
+	vst1_f32(w3, vget_high_f32(xy.val[1]));
+}
+#else
+struct SkinSum {
+	float x, y;
+};
+
+static inline SkinSum skinZero() {
+	SkinSum sum = {0, 0};
+	return sum;
+}
+
+template<bool hasDeform>
+static inline SkinSum skinAdd(SkinSum sum, const float *matrix, const float *vertex, const float *deform) {
+	float vx = vertex[0], vy = vertex[1];
+	if (hasDeform) {
+		vx += deform[0];
+		vy += deform[1];
+	}
+	sum.x += (vx * matrix[0] + vy * matrix[2] + matrix[4]) * vertex[2];
+	sum.y += (vx * matrix[1] + vy * matrix[3] + matrix[5]) * vertex[2];
+	return sum;
+}
+
+static inline void skinStore(SkinSum sum, float *worldVertex) {
+	worldVertex[0] = sum.x;
+	worldVertex[1] = sum.y;
+}
+#endif
+
+/* Skins the vertices of the variable length bone stream, starting at stream index v, vertex value b and deform value f. */
+template<bool hasDeform>
+static void skinVertices(const size_t *bones, const float *vertices, const float *deform, const float *matrices, size_t v,
+						 size_t b, size_t f, float *worldVertices, size_t w, size_t end, size_t stride) {
+	for (; w < end; w += stride) {
+		size_t n = bones[v++];
+		n += v;
+		SkinSum sum = skinZero();
+		for (; v < n; v++, b += 3, f += 2)
+			sum = skinAdd<hasDeform>(sum, matrices + (bones[v] << 3), vertices + b, hasDeform ? deform + f : NULL);
+		skinStore(sum, worldVertices + w);
+	}
+}
+
+/* Skins the vertex of a bucket group whose bones, vertices and influences start at the given pointers. */
+template<bool hasDeform>
+static inline void skinBucketVertex(size_t width, const int *bones, const float *vertices, const int *influences, const float *deform,
+									const float *matrices, float *worldVertex) {
+	float wx = 0, wy = 0;
+	for (size_t ii = 0; ii < width; ii++, bones += 4, vertices += 12, influences += 4) {
+		const float *matrix = matrices + (*bones << 3);
+		float vx = vertices[0], vy = vertices[4], weight = vertices[8];
+		if (hasDeform) {
+			vx += deform[*influences << 1];
+			vy += deform[(*influences << 1) + 1];
+		}
+		wx += (vx * matrix[0] + vy * matrix[2] + matrix[4]) * weight;
+		wy += (vx * matrix[1] + vy * matrix[3] + matrix[5]) * weight;
+	}
+	worldVertex[0] = wx;
+	worldVertex[1] = wy;
+}
+
+#ifdef SPINE_SKIN_LANES
+/* Skins a group of 4 vertices of a bucket. Padding has bone 0, influence 0 and no weight, so partial groups are skinned the same
+ * way. */
+template<size_t fixedWidth, bool hasDeform>
+static inline void skinGroup(size_t width, const int *bones, const float *vertices, const int *influences, const float *deform,
+							 const float *matrices, SkinLanes &wx, SkinLanes &wy) {
+	wx = lanesSet(0, 0, 0, 0);
+	wy = wx;
+	for (size_t ii = 0; ii < (fixedWidth ? fixedWidth : width); ii++, bones += 4, vertices += 12, influences += 4) {
+		SkinLanes a, b, c, d, x, y;
+		lanesMatrices(matrices + (bones[0] << 3), matrices + (bones[1] << 3), matrices + (bones[2] << 3), matrices + (bones[3] << 3),
+					  a, b, c, d, x, y);
+		SkinLanes vx = lanesLoad(vertices), vy = lanesLoad(vertices + 4), weight = lanesLoad(vertices + 8);
+		if (hasDeform) {
+			const float *d0 = deform + (influences[0] << 1), *d1 = deform + (influences[1] << 1);
+			const float *d2 = deform + (influences[2] << 1), *d3 = deform + (influences[3] << 1);
+			vx = lanesAdd(vx, lanesSet(d0[0], d1[0], d2[0], d3[0]));
+			vy = lanesAdd(vy, lanesSet(d0[1], d1[1], d2[1], d3[1]));
+		}
+		wx = lanesSkin(wx, vx, vy, a, b, x, weight);
+		wy = lanesSkin(wy, vx, vy, c, d, y, weight);
+	}
+}
+#endif
+
+/* Skins the vertices of one bucket which are in [first, first + count), fixedWidth is the bucket width or 0 if only known at
+ * runtime. whole is true if the range has all vertices of the attachment. */
+template<size_t fixedWidth, bool hasDeform>
+static void skinBucket(InfluenceBuckets &buckets, int bucket, const float *deform, const float *matrices, size_t first,
+					   size_t count, bool whole, float *worldVertices, size_t stride) {
+	const size_t width = fixedWidth ? fixedWidth : buckets.getWidth(bucket);
+	const int *bones = buckets.getBones(bucket).buffer();
+	const float *vertices = buckets.getVertices(bucket).buffer();
+	const int *influences = buckets.getInfluences(bucket).buffer();
+	const int *remap = buckets.getRemap(bucket).buffer();
+	const size_t vertexCount = buckets.getVertexCount(bucket);
+	for (size_t i = 0, n = buckets.getRemap(bucket).size(); i < n;
+		 i += 4, bones += width * 4, vertices += width * 12, influences += width * 4) {
+#ifdef SPINE_SKIN_LANES
+		SkinLanes wx, wy;
+		skinGroup<fixedWidth, hasDeform>(width, bones, vertices, influences, deform, matrices, wx, wy);
+		if (whole && i + 4 <= vertexCount) {
+			lanesStore(wx, wy, worldVertices + remap[i] * stride, worldVertices + remap[i + 1] * stride,
+					   worldVertices + remap[i + 2] * stride, worldVertices + remap[i + 3] * stride);
+			continue;
+		}
+		float group[8];
+		lanesStore(wx, wy, group, group + 2, group + 4, group + 6);
+#endif
+		for (size_t k = 0; k < 4; k++) {
+			/* Padding has a remap of -1, so it is outside the range. */
+			size_t index = (size_t) remap[i + k] - first;
+			if (index >= count) continue;
+#ifdef SPINE_SKIN_LANES
+			worldVertices[index * stride] = group[k << 1];
+			worldVertices[index * stride + 1] = group[(k << 1) + 1];
+#else
+			skinBucketVertex<hasDeform>(width, bones + k, vertices + k, influences + k, deform, matrices, worldVertices + index * stride);
+#endif
+		}
+	}
+}
+
+template<bool hasDeform>
+static void skinBuckets(InfluenceBuckets &buckets, const float *deform, const float *matrices, size_t first, size_t count,
+						bool whole, float *worldVertices, size_t stride) {
+	skinBucket<1, hasDeform>(buckets, 0, deform, matrices, first, count, whole, worldVertices, stride);
+	skinBucket<2, hasDeform>(buckets, 1, deform, matrices, first, count, whole, worldVertices, stride);
+	skinBucket<3, hasDeform>(buckets, 2, deform, matrices, first, count, whole, worldVertices, stride);
+	skinBucket<4, hasDeform>(buckets, 3, deform, matrices, first, count, whole, worldVertices, stride);
+	skinBucket<0, hasDeform>(buckets, 4, deform, matrices, first, count, whole, worldVertices, stride);
+}
+
 RTTI_IMPL(VertexAttachment, Attachment)
 
-VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0), _deformAttachment(this), _id(getNextID()) {
+VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0), _deformAttachment(this), _influenceBuckets(NULL), _id(getNextID()) {
 }
 
 VertexAttachment::~VertexAttachment() {
+	if (_influenceBuckets) delete _influenceBuckets;
 }
 
 void VertexAttachment::computeWorldVertices(Slot &slot, Vector<float> &worldVertices) {
@@ -82,6 +365,21 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		return;
 	}
 
+	Vector<Bone *> &skeletonBones = skeleton.getBones();
+	// The bone matrices are only read, they are gathered by Skeleton::updateWorldTransform(). Bones changed since then are read
+	// directly.
+	const float *matrices = skeleton._boneMatricesValid ? skeleton._boneMatrices.buffer() : NULL;
+	if (matrices && _influenceBuckets) {
+		size_t vertexCount = (count - offset) / stride;
+		bool whole = start == 0 && vertexCount >= _worldVerticesLength >> 1;
+		if (deformArray->size() == 0)
+			skinBuckets<false>(*_influenceBuckets, NULL, matrices, start >> 1, vertexCount, whole, worldVertices + offset, stride);
+		else
+			skinBuckets<true>(*_influenceBuckets, deformArray->buffer(), matrices, start >> 1, vertexCount, whole,
+							  worldVertices + offset, stride);
+		return;
+	}
+
 	int v = 0, skip = 0;
 	for (size_t i = 0; i < start; i += 2) {
 		int n = bones[v];
@@ -89,7 +387,15 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		skip += n;
 	}
 
-	Vector<Bone *> &skeletonBones = skeleton.getBones();
+	if (matrices) {
+		if (deformArray->size() == 0)
+			skinVertices<false>(bones.buffer(), vertices->buffer(), NULL, matrices, v, skip * 3, 0, worldVertices, offset, count, stride);
+		else
+			skinVertices<true>(bones.buffer(), vertices->buffer(), deformArray->buffer(), matrices, v, skip * 3, skip << 1,
+							   worldVertices, offset, count, stride);
+		return;
+	}
+
 	if (deformArray->size() == 0) {
 		for (size_t w = offset, b = skip * 3; w < count; w += stride) {
 			float wx = 0, wy = 0;
@@ -147,6 +453,15 @@ void VertexAttachment::setWorldVerticesLength(size_t inValue) {
 	_worldVerticesLength = inValue;
 }
 
+void VertexAttachment::buildInfluenceBuckets() {
+	if (_influenceBuckets) delete _influenceBuckets;
+	_influenceBuckets = _bones.size() > 0 ? new(__FILE__, __LINE__) InfluenceBuckets(_bones, _vertices) : NULL;
+}
+
+InfluenceBuckets* VertexAttachment::getInfluenceBuckets() {
+	return _influenceBuckets;
+}
+
 VertexAttachment* VertexAttachment::getDeformAttachment() {
 	return _deformAttachment;
 }
@@ -156,7 +471,12 @@ void VertexAttachment::setDeformAttachment(VertexAttachment* attachment) {
 }
 
 int VertexAttachment::getNextID() {
+	// Attachments may be created by several threads loading skeleton data.
+#ifndef SPINE_NO_THREADS
+	static std::atomic<int> nextID(0);
+#else
 	static int nextID = 0;
+#endif
 
 	return (nextID++ & 65535) << 11;
 }
@@ -166,4 +486,9 @@ void VertexAttachment::copyTo(VertexAttachment* other) {
 	other->_vertices.clearAndAddAll(this->_vertices);
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_deformAttachment = this->_deformAttachment;
+	if (other->_influenceBuckets) {
+		delete other->_influenceBuckets;
+		other->_influenceBuckets = NULL;
+	}
+	if (this->_influenceBuckets) other->buildInfluenceBuckets();
 }
@@ -61,11 +61,7 @@ public:
 	bool getUsePremultipliedAlpha() { return usePremultipliedAlpha; };
 private:
 	mutable bool ownsAnimationStateData;
-	mutable Vector<float> worldVertices;
-	mutable Vector<float> tempUvs;
-	mutable Vector<Color> tempColors;
-	mutable Vector<unsigned short> quadIndices;
-	mutable SkeletonClipping clipper;
+	mutable SkeletonBatchRenderer renderer;
 	mutable bool usePremultipliedAlpha;
 };
 